@@ -1,10 +1,13 @@
 ﻿using System;
 using System.Diagnostics;
+using System.IO;
 
 namespace GoogleTestAdapter.Common
 {
     public static class ProcessUtils
     {
+        private const int KillProcessTreeTimeoutInMs = 10000;
+
         public static void KillProcess(int processId, ILogger logger)
         {
             try
@@ -26,5 +29,37 @@ namespace GoogleTestAdapter.Common
                 // process was not running - nothing to do
             }
         }
+
+        /// <summary>
+        /// Kills the given process and all of its child processes (which might otherwise keep the process' output
+        /// streams open). Falls back to killing the process only if that fails.
+        /// </summary>
+        public static void KillProcessTree(int processId, ILogger logger)
+        {
+            try
+            {
+                var startInfo = new ProcessStartInfo(Path.Combine(Environment.SystemDirectory, "taskkill.exe"), $"/PID {processId} /T /F")
+                {
+                    UseShellExecute = false,
+                    CreateNoWindow = true,
+                    RedirectStandardOutput = true,
+                    RedirectStandardError = true
+                };
+                using (Process taskkill = Process.Start(startInfo))
+                {
+                    if (taskkill != null && taskkill.WaitForExit(KillProcessTreeTimeoutInMs) && taskkill.ExitCode == 0)
+                    {
+                        logger.DebugInfo($"Killed process tree of process with id {processId}");
+                        return;
+                    }
+                }
+            }
+            catch (Exception e)
+            {
+                logger.DebugWarning($"Could not kill process tree of process with id {processId}: {e.Message}");
+            }
+
+            KillProcess(processId, logger);
+        }
     }
 }
@@ -0,0 +1,110 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading;
+using System.Threading.Tasks;
+using FluentAssertions;
+using GoogleTestAdapter.Helpers;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.Tests.Common;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using Moq;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.Framework
+{
+    [TestClass]
+    public class AsyncTestFrameworkReporterTests : TestsBase
+    {
+        private Mock<ITestFrameworkReporter> _mockInnerReporter;
+
+        [TestInitialize]
+        public override void SetUp()
+        {
+            base.SetUp();
+            _mockInnerReporter = new Mock<ITestFrameworkReporter>();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Complete_SeveralReports_AllReportsAreForwardedInOrder()
+        {
+            var reportedTests = new List<string>();
+            _mockInnerReporter.Setup(r => r.ReportTestResults(It.IsAny<IEnumerable<TestResult>>()))
+                .Callback<IEnumerable<TestResult>>(trs => reportedTests.AddRange(trs.Select(tr => tr.TestCase.FullyQualifiedName)));
+            var reporter = new AsyncTestFrameworkReporter(_mockInnerReporter.Object, TestEnvironment.Logger);
+
+            for (int i = 0; i < 100; i++)
+            {
+                reporter.ReportTestsStarted(TestDataCreator.ToTestCase($"Suite.Test{i}").Yield());
+                reporter.ReportTestResults(CreateResult($"Suite.Test{i}").Yield());
+            }
+            reporter.Complete();
+
+            reportedTests.Should().Equal(Enumerable.Range(0, 100).Select(i => $"Suite.Test{i}"));
+            _mockInnerReporter.Verify(r => r.ReportTestsStarted(It.IsAny<IEnumerable<TestCase>>()), Times.Exactly(100));
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void ReportTestResults_InnerReporterIsSlow_CallerDoesNotWait()
+        {
+            var blocker = new ManualResetEventSlim();
+            _mockInnerReporter.Setup(r => r.ReportTestResults(It.IsAny<IEnumerable<TestResult>>()))
+                .Callback(() => blocker.Wait());
+            var reporter = new AsyncTestFrameworkReporter(_mockInnerReporter.Object, TestEnvironment.Logger, 10);
+
+            Task reporting = Task.Run(() => reporter.ReportTestResults(CreateResult("Suite.Test").Yield()));
+
+            reporting.Wait(5000).Should().BeTrue();
+            blocker.Set();
+            reporter.Complete();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void ReportTestResults_ChannelIsFull_CallerWaits()
+        {
+            var blocker = new ManualResetEventSlim();
+            _mockInnerReporter.Setup(r => r.ReportTestResults(It.IsAny<IEnumerable<TestResult>>()))
+                .Callback(() => blocker.Wait());
+            var reporter = new AsyncTestFrameworkReporter(_mockInnerReporter.Object, TestEnvironment.Logger, 2);
+
+            Task reporting = Task.Run(() =>
+            {
+                for (int i = 0; i < 5; i++)
+                    reporter.ReportTestResults(CreateResult($"Suite.Test{i}").Yield());
+            });
+
+            reporting.Wait(200).Should().BeFalse();
+            blocker.Set();
+            reporting.Wait(5000).Should().BeTrue();
+            reporter.Complete();
+            _mockInnerReporter.Verify(r => r.ReportTestResults(It.IsAny<IEnumerable<TestResult>>()), Times.Exactly(5));
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void ReportTestResults_InnerReporterHasBeenCanceled_ThrowsTestRunCanceledException()
+        {
+            _mockInnerReporter.Setup(r => r.ReportTestResults(It.IsAny<IEnumerable<TestResult>>()))
+                .Throws(new TestRunCanceledException("canceled", new Exception()));
+            var reporter = new AsyncTestFrameworkReporter(_mockInnerReporter.Object, TestEnvironment.Logger);
+            reporter.ReportTestResults(CreateResult("Suite.Test1").Yield());
+            var done = new ManualResetEventSlim();
+            reporter.Post(() => done.Set());
+            done.Wait(5000).Should().BeTrue();
+
+            reporter.Invoking(r => r.ReportTestResults(CreateResult("Suite.Test2").Yield()))
+                .Should().Throw<TestRunCanceledException>();
+            reporter.Complete();
+        }
+
+        private TestResult CreateResult(string name)
+        {
+            return new TestResult(TestDataCreator.ToTestCase(name)) { Outcome = TestOutcome.Passed };
+        }
+
+    }
+
+}
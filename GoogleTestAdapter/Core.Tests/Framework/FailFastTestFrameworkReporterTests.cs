@@ -0,0 +1,75 @@
+﻿using System.Collections.Generic;
+using System.Linq;
+using FluentAssertions;
+using GoogleTestAdapter.Helpers;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.Tests.Common;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using Moq;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.Framework
+{
+    [TestClass]
+    public class FailFastTestFrameworkReporterTests : TestsBase
+    {
+        private Mock<ITestFrameworkReporter> _mockInnerReporter;
+        private List<TestResult> _failures;
+        private FailFastTestFrameworkReporter _reporter;
+
+        [TestInitialize]
+        public override void SetUp()
+        {
+            base.SetUp();
+            _mockInnerReporter = new Mock<ITestFrameworkReporter>();
+            _failures = new List<TestResult>();
+            _reporter = new FailFastTestFrameworkReporter(_mockInnerReporter.Object, tr => _failures.Add(tr));
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void ReportTestResults_PassedTests_NoCancelation()
+        {
+            _reporter.ReportTestResults(new[] { CreateResult("Suite.Test1", TestOutcome.Passed), CreateResult("Suite.Test2", TestOutcome.Skipped) });
+
+            _failures.Should().BeEmpty();
+            _reporter.HasFailed.Should().BeFalse();
+            _mockInnerReporter.Verify(r => r.ReportTestResults(It.Is<IEnumerable<TestResult>>(trs => trs.Count() == 2)), Times.Once);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void ReportTestResults_SeveralFailures_ActionIsInvokedForFirstFailureOnly()
+        {
+            _reporter.ReportTestResults(CreateResult("Suite.Test1", TestOutcome.Failed).Yield());
+            _reporter.ReportTestResults(CreateResult("Suite.Test2", TestOutcome.Failed).Yield());
+
+            _failures.Should().ContainSingle().Which.TestCase.FullyQualifiedName.Should().Be("Suite.Test1");
+            _reporter.HasFailed.Should().BeTrue();
+            _mockInnerReporter.Verify(r => r.ReportTestResults(It.IsAny<IEnumerable<TestResult>>()), Times.Exactly(2));
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void ReportTestsNotRun_SomeTestsWithResults_RemainingTestsAreReportedAsNotRun()
+        {
+            TestResult failedResult = CreateResult("Suite.Test1", TestOutcome.Failed);
+            TestCase testCaseNotRun = TestDataCreator.ToTestCase("Suite.Test2");
+            testCaseNotRun.Properties.Add(new TestCaseMetaDataProperty(2, 2));
+            _reporter.ReportTestResults(failedResult.Yield());
+
+            _reporter.ReportTestsNotRun(new[] { failedResult.TestCase, testCaseNotRun }, "canceled");
+
+            _mockInnerReporter.Verify(r => r.ReportTestResults(It.Is<IEnumerable<TestResult>>(
+                trs => trs.Count() == 1 && trs.Single().TestCase == testCaseNotRun && trs.Single().Outcome == TestOutcome.None && trs.Single().ErrorMessage == "canceled")),
+                Times.Once);
+        }
+
+        private TestResult CreateResult(string name, TestOutcome outcome)
+        {
+            return TestDataCreator.ToTestResult(name, outcome, 1);
+        }
+
+    }
+
+}
@@ -0,0 +1,92 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using FluentAssertions;
+using GoogleTestAdapter.ProcessExecution;
+using GoogleTestAdapter.Tests.Common;
+using GoogleTestAdapter.Tests.Common.Tests;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+namespace GoogleTestAdapter.Helpers
+{
+    [TestClass]
+    public class PreSpawningProcessExecutorTests : ProcessExecutorTests
+    {
+        private static readonly string Cmd = Path.Combine(Environment.SystemDirectory, "cmd.exe");
+
+        [TestInitialize]
+        public void Setup()
+        {
+            ProcessExecutor = new PreSpawningProcessExecutor(true, MockLogger.Object);
+        }
+
+        [TestCleanup]
+        public override void Teardown()
+        {
+            ((PreSpawningProcessExecutor)ProcessExecutor).Dispose();
+            base.Teardown();
+        }
+
+        [TestMethod]
+        [TestCategory(TestMetadata.TestCategories.Unit)]
+        public void ExecuteProcessBlocking_PingLocalHost()
+        {
+            Test_ExecuteProcessBlocking_PingLocalHost();
+        }
+
+        [TestMethod]
+        [TestCategory(TestMetadata.TestCategories.Unit)]
+        public void ExecuteProcessBlocking_SampleTests()
+        {
+            Test_ExecuteProcessBlocking_SampleTests();
+        }
+
+        [TestMethod]
+        [TestCategory(TestMetadata.TestCategories.Unit)]
+        public void ExecuteProcessBlocking_WithSimpleCommand_ReturnsOutputOfCommand()
+        {
+            Test_WithSimpleCommand_ReturnsOutputOfCommand();
+        }
+
+        [TestMethod]
+        [TestCategory(TestMetadata.TestCategories.Unit)]
+        public void ExecuteProcessBlocking_SetEnvVariable_EnvVariableIsSet()
+        {
+            Test_WithEnvSetting_EnvVariableIsSet();
+        }
+
+        [TestMethod]
+        [TestCategory(TestMetadata.TestCategories.Unit)]
+        public void ExecuteProcessBlocking_PreSpawnedCommand_PreSpawnedProcessIsResumed()
+        {
+            var executor = (PreSpawningProcessExecutor)ProcessExecutor;
+            var environmentVariables = new Dictionary<string, string> { { "MyVar", "MyValue" } };
+            executor.PreSpawn(Cmd, "/C \"echo %MyVar%\"", ".", "", environmentVariables);
+
+            executor.IsPreSpawnedFor(Cmd, "/C \"echo %MyVar%\"", ".", "", environmentVariables).Should().BeTrue();
+            var output = new List<string>();
+            int exitCode = executor.ExecuteCommandBlocking(Cmd, "/C \"echo %MyVar%\"", ".", "", environmentVariables, line => output.Add(line));
+
+            exitCode.Should().Be(0);
+            output.Should().ContainSingle().Which.Should().Be("MyValue");
+            executor.ResourceUsage.Should().NotBeNull();
+            executor.IsPreSpawnedFor(Cmd, "/C \"echo %MyVar%\"", ".", "", environmentVariables).Should().BeFalse();
+        }
+
+        [TestMethod]
+        [TestCategory(TestMetadata.TestCategories.Unit)]
+        public void ExecuteProcessBlocking_OtherCommandThanPreSpawned_OtherCommandIsExecuted()
+        {
+            var executor = (PreSpawningProcessExecutor)ProcessExecutor;
+            executor.PreSpawn(Cmd, "/C \"echo 1\"", ".", "", new Dictionary<string, string>());
+
+            executor.IsPreSpawnedFor(Cmd, "/C \"echo 1\"", ".", "", new Dictionary<string, string> { { "MyVar", "MyValue" } }).Should().BeFalse();
+            var output = new List<string>();
+            int exitCode = executor.ExecuteCommandBlocking(Cmd, "/C \"echo 2\"", ".", "", new Dictionary<string, string>(), line => output.Add(line));
+
+            exitCode.Should().Be(0);
+            output.Should().ContainSingle().Which.Should().Be("2");
+        }
+    }
+
+}
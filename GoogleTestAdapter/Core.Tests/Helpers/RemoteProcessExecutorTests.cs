@@ -0,0 +1,140 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Net;
+using System.Net.Sockets;
+using System.Text;
+using FluentAssertions;
+using GoogleTestAdapter.ProcessExecution;
+using GoogleTestAdapter.Tests.Common;
+using GoogleTestAdapter.Tests.Common.Tests;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+namespace GoogleTestAdapter.Helpers
+{
+    [TestClass]
+    public class RemoteProcessExecutorTests : ProcessExecutorTests
+    {
+        private const string Secret = "4711";
+
+        private RemoteAgentServer _server;
+
+        [TestInitialize]
+        public void Setup()
+        {
+            _server = new RemoteAgentServer(IPAddress.Loopback, 0, Path.GetDirectoryName(Path.GetFullPath(TestResources.Tests_DebugX86)), Secret, MockLogger.Object);
+            _server.Start();
+            ProcessExecutor = new RemoteProcessExecutor(new DnsEndPoint("localhost", _server.Port), Secret, true, MockLogger.Object);
+        }
+
+        [TestCleanup]
+        public override void Teardown()
+        {
+            _server.Dispose();
+            base.Teardown();
+        }
+
+        [TestMethod]
+        [TestCategory(TestMetadata.TestCategories.Unit)]
+        public void ExecuteProcessBlocking_SampleTests()
+        {
+            var output = new List<string>();
+            int exitCode = ProcessExecutor.ExecuteCommandBlocking(Path.GetFullPath(TestResources.Tests_DebugX86), null, null, "", new Dictionary<string, string>(), s => output.Add(s));
+
+            exitCode.Should().Be(1);
+            output.Should().Contain(s => s.Contains("TestMath.AddPasses"));
+            output.Should().HaveCount(641);
+        }
+
+        [TestMethod]
+        [TestCategory(TestMetadata.TestCategories.Unit)]
+        public void ExecuteProcessBlocking_NotExistingCommand_ThrowsIOException()
+        {
+            ProcessExecutor
+                .Invoking(e => e.ExecuteCommandBlocking("NotExisting.exe", "", "", null, new Dictionary<string, string>(), s => { }))
+                .Should().Throw<IOException>();
+        }
+
+        [TestMethod]
+        [TestCategory(TestMetadata.TestCategories.Unit)]
+        public void ExecuteProcessBlocking_CommandOutsideOfTestDirectory_ThrowsIOException()
+        {
+            ProcessExecutor
+                .Invoking(e => e.ExecuteCommandBlocking(Path.Combine(Environment.SystemDirectory, "cmd.exe"), "/C \"echo 2\"", ".", "", new Dictionary<string, string>(), s => { }))
+                .Should().Throw<IOException>().WithMessage("*not a test executable*");
+        }
+
+        [TestMethod]
+        [TestCategory(TestMetadata.TestCategories.Unit)]
+        public void ExecuteProcessBlocking_WrongSecret_ThrowsIOException()
+        {
+            var processExecutor = new RemoteProcessExecutor(new DnsEndPoint("localhost", _server.Port), "wrong secret", true, MockLogger.Object);
+
+            processExecutor
+                .Invoking(e => e.ExecuteCommandBlocking(Path.GetFullPath(TestResources.Tests_DebugX86), "", "", "", new Dictionary<string, string>(), s => { }))
+                .Should().Throw<IOException>().WithMessage("*Authentication failed*");
+        }
+
+        [TestMethod]
+        [TestCategory(TestMetadata.TestCategories.Unit)]
+        public void ExecuteProcessBlocking_RequestModifiedAfterHandshake_AgentRefusesRequest()
+        {
+            using (var client = new TcpClient("localhost", _server.Port))
+            using (NetworkStream stream = client.GetStream())
+            using (var reader = new BinaryReader(stream, Encoding.UTF8, true))
+            using (var writer = new BinaryWriter(stream, Encoding.UTF8, true))
+            {
+                byte[] challenge = RemoteAgentProtocol.AnswerChallenge(reader, writer, Secret);
+
+                var request = new RemoteExecutionRequest { Command = Path.GetFullPath(TestResources.Tests_DebugX86), Parameters = "--gtest_filter=foo" };
+                byte[] serializedRequest;
+                using (var requestStream = new MemoryStream())
+                using (var requestWriter = new BinaryWriter(requestStream, Encoding.UTF8))
+                {
+                    RemoteAgentProtocol.WriteRequest(requestWriter, request, Secret, challenge);
+                    serializedRequest = requestStream.ToArray();
+                }
+                ReplaceBytes(serializedRequest, "--gtest_filter=foo", "--gtest_filter=bar");
+                writer.Write(serializedRequest);
+                writer.Flush();
+
+                reader.ReadByte().Should().Be(RemoteAgentProtocol.ErrorMessage);
+                reader.ReadString().Should().Contain("modified");
+            }
+        }
+
+        [TestMethod]
+        [TestCategory(TestMetadata.TestCategories.Unit)]
+        public void ParseEndpoints_ValidAndInvalidEndpoints_AreParsedOrRejected()
+        {
+            RemoteAgentProtocol.ParseEndpoints(" localhost:4711; 192.168.1.2:4712 ;").Should().BeEquivalentTo(
+                new DnsEndPoint("localhost", 4711), new DnsEndPoint("192.168.1.2", 4712));
+            RemoteAgentProtocol.ParseEndpoints("").Should().BeEmpty();
+
+            Action parseMissingPort = () => RemoteAgentProtocol.ParseEndpoints("localhost");
+            parseMissingPort.Should().Throw<FormatException>();
+            Action parseInvalidPort = () => RemoteAgentProtocol.ParseEndpoints("localhost:70000");
+            parseInvalidPort.Should().Throw<FormatException>();
+        }
+
+        private static void ReplaceBytes(byte[] bytes, string original, string replacement)
+        {
+            byte[] originalBytes = Encoding.UTF8.GetBytes(original);
+            byte[] replacementBytes = Encoding.UTF8.GetBytes(replacement);
+            for (int i = 0; i + originalBytes.Length <= bytes.Length; i++)
+            {
+                int j = 0;
+                while (j < originalBytes.Length && bytes[i + j] == originalBytes[j])
+                    j++;
+                if (j == originalBytes.Length)
+                {
+                    Array.Copy(replacementBytes, 0, bytes, i, replacementBytes.Length);
+                    return;
+                }
+            }
+            throw new ArgumentException($"'{original}' not found");
+        }
+
+    }
+
+}
@@ -1,5 +1,6 @@
 ﻿using System;
 using System.Collections.Generic;
+using System.IO;
 using System.Linq;
 using FluentAssertions;
 using GoogleTestAdapter.Helpers;
@@ -52,6 +53,74 @@ namespace GoogleTestAdapter.Runners
             commandLine.Should().NotContain(GoogleTestConstants.FilterOption);
         }
 
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetCommandLineForShard_AllTestsNotKnown_NoFilter()
+        {
+            var testCases = TestDataCreator.CreateDummyTestCasesFull(new[] { "Suite1.Test1", "Suite2.Test1" },
+                new[] { "Suite1.Test1", "Suite1.Test2", "Suite2.Test1" }).ToList();
+
+            var args = new CommandLineGenerator(testCases, TestDataCreator.DummyExecutable.Length, "-myParam", "", TestEnvironment.Options).GetCommandLineForShard();
+
+            args.CommandLine.Should().NotContain(GoogleTestConstants.FilterOption);
+            args.CommandLine.Should().EndWith(" -myParam");
+            args.TestCases.Should().BeEquivalentTo(testCases);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetCommandLineForShard_AllTestsKnown_SynthesizedFilter()
+        {
+            string[] allTests = { "Suite1.Test1", "Suite1.Test2", "Suite2.Test1" };
+            var testCases = TestDataCreator.CreateDummyTestCasesFull(new[] { "Suite1.Test1", "Suite2.Test1" }, allTests).ToList();
+            var allTestCases = allTests.Select(t => TestDataCreator.ToTestCase(t));
+
+            var args = new CommandLineGenerator(testCases, TestDataCreator.DummyExecutable.Length, "", "", TestEnvironment.Options, allTestCases).GetCommandLineForShard();
+
+            args.CommandLine.Should().Contain($"{GoogleTestConstants.FilterOption}*-Suite1.Test2");
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetTestServerRequest_ManyTests_SingleUnsplitFilter()
+        {
+            var testsToExecute = Enumerable.Range(0, 1000).Select(i => $"MyTestSuite{i}.MyTest").ToArray();
+            var allTests = testsToExecute.Concat(testsToExecute.Select(t => t + "2")).ToArray();
+            var testCases = TestDataCreator.CreateDummyTestCasesFull(testsToExecute, allTests).ToList();
+
+            var args = new CommandLineGenerator(testCases, TestDataCreator.DummyExecutable.Length, "-myParam", "", TestEnvironment.Options).GetTestServerRequest();
+
+            args.TestCases.Should().HaveCount(1000);
+            args.CommandLine.Split(':').Should().BeEquivalentTo(testsToExecute);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetTestServerRequest_AllTestsOfExecutable_EmptyFilter()
+        {
+            var testCases = TestDataCreator.CreateDummyTestCasesFull(new[] { "Suite.Test1", "Suite.Test2" }, new[] { "Suite.Test1", "Suite.Test2" }).ToList();
+
+            var generator = new CommandLineGenerator(testCases, TestDataCreator.DummyExecutable.Length, "-myParam", "", TestEnvironment.Options);
+
+            generator.GetTestServerRequest().CommandLine.Should().BeEmpty();
+            generator.GetCommandLineForTestServer().Should().Be($"--gtest_output=\"xml:\"{DefaultArgs} -myParam");
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetCommandLines_AllTestsKnown_SingleCommandLineWithSynthesizedFilter()
+        {
+            var allTests = Enumerable.Range(0, 1000).Select(i => $"Instance/Suite.Test/{i}").ToArray();
+            var testCases = TestDataCreator.CreateDummyTestCasesFull(allTests.Skip(1).ToArray(), allTests).ToList();
+            var allTestCases = allTests.Select(t => TestDataCreator.ToTestCase(t));
+
+            var commandLines = new CommandLineGenerator(testCases, TestDataCreator.DummyExecutable.Length, "", "", TestEnvironment.Options, allTestCases).GetCommandLines().ToList();
+
+            commandLines.Should().ContainSingle();
+            commandLines.Single().CommandLine.Should().Contain($"{GoogleTestConstants.FilterOption}*-Instance/Suite.Test/0");
+            commandLines.Single().TestCases.Should().HaveCount(999);
+        }
+
         [TestMethod]
         [TestCategory(Unit)]
         public void GetCommandLines_OnlyExitCodeTestCase_DummyFilter()
@@ -284,6 +353,53 @@ namespace GoogleTestAdapter.Runners
             splittedTestsAsSet.Should().BeEquivalentTo(testsAsSet);
         }
 
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetCommandLines_ManyTestsAndFlagFile_SingleCommandLineWithFlagFile()
+        {
+            List<string> allTests = new List<string>();
+            List<string> testsToExecute = new List<string>();
+            for (int i = 0; i < 1000; i++)
+            {
+                string test1 = $"MyTestSuite{i}.MyTest";
+                string test2 = $"MyTestSuite{i}.MyTest2";
+
+                allTests.Add(test1);
+                testsToExecute.Add(test1);
+                allTests.Add(test2);
+            }
+            allTests.Add("FullSuite.MyTest");
+            testsToExecute.Add("FullSuite.MyTest");
+            IEnumerable<Model.TestCase> testCases = TestDataCreator.CreateDummyTestCasesFull(testsToExecute.ToArray(), allTests.ToArray());
+            string flagFile = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+
+            List<CommandLineGenerator.Args> commands = new CommandLineGenerator(testCases, TestDataCreator.DummyExecutable.Length, "-myParam", "", TestEnvironment.Options, null, flagFile)
+                .GetCommandLines().ToList();
+
+            commands.Should().ContainSingle();
+            commands[0].TestCases.Should().HaveCount(1001);
+            commands[0].CommandLine.Should().Be($@"--gtest_output=""xml:""{DefaultArgs} --gtest_flagfile=""{flagFile}"" -myParam");
+            commands[0].FlagFile.Should().Be(flagFile);
+
+            string flagFileContent = commands[0].FlagFileContent.Trim();
+            flagFileContent.Should().StartWith("--gtest_filter=FullSuite.*:MyTestSuite0.MyTest:");
+            flagFileContent.Split(':').Should().HaveCount(1001);
+            File.Exists(flagFile).Should().BeFalse();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetCommandLines_FewTestsAndFlagFile_FlagFileIsNotUsed()
+        {
+            IEnumerable<Model.TestCase> testCases = TestDataCreator.CreateDummyTestCasesFull(new[] { "Suite.Test1" }, new[] { "Suite.Test1", "Suite.Test2" });
+
+            List<CommandLineGenerator.Args> commands = new CommandLineGenerator(testCases, TestDataCreator.DummyExecutable.Length, "", "", TestEnvironment.Options, null, "flagfile.txt")
+                .GetCommandLines().ToList();
+
+            commands.Should().ContainSingle().Which.CommandLine.Should().EndWith($"{GoogleTestConstants.FilterOption}Suite.Test1");
+            commands[0].FlagFile.Should().BeNull();
+        }
+
         [TestMethod]
         [TestCategory(Unit)]
         public void GetCommandLines_ManyTestsWithSuites_BreaksUpLongCommandLinesCorrectly()
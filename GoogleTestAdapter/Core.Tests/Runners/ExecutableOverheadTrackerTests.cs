@@ -0,0 +1,66 @@
+﻿using System;
+using FluentAssertions;
+using GoogleTestAdapter.Scheduling;
+using GoogleTestAdapter.Tests.Common;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.Runners
+{
+    [TestClass]
+    public class ExecutableOverheadTrackerTests : TestsBase
+    {
+        private static readonly DateTime ProcessStart = new DateTime(2020, 1, 1);
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Stop_TestsHaveBeenRun_OverheadIsComputed()
+        {
+            var tracker = new ExecutableOverheadTracker();
+            tracker.Start(ProcessStart);
+
+            tracker.ReportLine("[==========] Running 3 tests from 2 test suites.", At(10));
+            tracker.ReportLine("[----------] Global test environment set-up.", At(20));
+            tracker.ReportLine("[----------] 2 tests from Suite", At(150));
+            tracker.ReportLine("[ RUN      ] Suite.Test1", At(170));
+            tracker.ReportLine("[       OK ] Suite.Test1 (10 ms)", At(180));
+            tracker.ReportLine("[ RUN      ] Suite.Test2", At(180));
+            tracker.ReportLine("some output[  FAILED  ] Suite.Test2 (5 ms)", At(185));
+            tracker.ReportLine("[----------] 2 tests from Suite (40 ms total)", At(190));
+            tracker.ReportLine("[----------] 1 test from Typed/0, where TypeParam = int", At(200));
+            tracker.ReportLine("[ RUN      ] Typed/0.Test", At(200));
+            tracker.ReportLine("[       OK ] Typed/0.Test (1 ms)", At(201));
+            tracker.ReportLine("[----------] 1 test from Typed/0, where TypeParam = int (3 ms total)", At(203));
+            tracker.ReportLine("[  FAILED  ] Suite.Test2", At(210));
+            tracker.ReportLine("[  FAILED  ] 1 test, listed below:", At(210));
+
+            ExecutableOverhead overhead = tracker.Stop(At(301));
+
+            overhead.StartupDuration.Should().Be(150);
+            overhead.ShutdownDuration.Should().Be(100);
+            overhead.ProcessDuration.Should().Be(250);
+            overhead.SuiteDurations.Should().HaveCount(2);
+            overhead.SuiteDurations["Suite"].Should().Be(25);
+            overhead.SuiteDurations["Typed/0"].Should().Be(2);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Stop_NoTestHasBeenRun_ReturnsNull()
+        {
+            var tracker = new ExecutableOverheadTracker();
+            tracker.Start(ProcessStart);
+
+            tracker.ReportLine("[==========] Running 0 tests from 0 test suites.", At(10));
+
+            tracker.Stop(At(20)).Should().BeNull();
+        }
+
+        private DateTime At(int milliseconds)
+        {
+            return ProcessStart.AddMilliseconds(milliseconds);
+        }
+
+    }
+
+}
@@ -0,0 +1,76 @@
+﻿using System.Collections.Generic;
+using System.IO;
+using FluentAssertions;
+using GoogleTestAdapter.Tests.Common;
+using GoogleTestAdapter.TestResults;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.Runners
+{
+    [TestClass]
+    public class PreSpawnedBatchTests : TestsBase
+    {
+        private string _resultXmlFile;
+        private string _eventStreamFile;
+
+        [TestInitialize]
+        public override void SetUp()
+        {
+            base.SetUp();
+            _resultXmlFile = Path.GetTempFileName();
+            _eventStreamFile = Path.GetTempFileName();
+        }
+
+        [TestCleanup]
+        public override void TearDown()
+        {
+            File.Delete(_resultXmlFile);
+            File.Delete(_eventStreamFile);
+            base.TearDown();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void TryUseFiles_SameExecutable_FilesAreHandedOutOnceAndKeptOnDispose()
+        {
+            var environmentVariables = new Dictionary<string, string>();
+            using (PreSpawnedBatch batch = CreateBatch())
+            {
+                batch.TryUseFiles("foo.exe", environmentVariables, out string resultXmlFile, out string flagFile, out string eventStreamFile).Should().BeTrue();
+                resultXmlFile.Should().Be(_resultXmlFile);
+                flagFile.Should().BeNull();
+                eventStreamFile.Should().Be(_eventStreamFile);
+                environmentVariables[EventStreamTestResultParser.EnvironmentVariable].Should().Be(_eventStreamFile);
+
+                batch.TryUseFiles("foo.exe", environmentVariables, out resultXmlFile, out flagFile, out eventStreamFile).Should().BeFalse();
+                resultXmlFile.Should().BeNull();
+            }
+
+            File.Exists(_resultXmlFile).Should().BeTrue();
+            File.Exists(_eventStreamFile).Should().BeTrue();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Dispose_FilesHaveNotBeenUsed_FilesAreDeleted()
+        {
+            var environmentVariables = new Dictionary<string, string>();
+            using (PreSpawnedBatch batch = CreateBatch())
+            {
+                batch.TryUseFiles("bar.exe", environmentVariables, out _, out _, out _).Should().BeFalse();
+                batch.TakeProcessExecutor("foo.exe", "", "", "", environmentVariables).Should().BeNull();
+                environmentVariables.Should().BeEmpty();
+            }
+
+            File.Exists(_resultXmlFile).Should().BeFalse();
+            File.Exists(_eventStreamFile).Should().BeFalse();
+        }
+
+        private PreSpawnedBatch CreateBatch()
+        {
+            var outputFiles = new TestOutputFiles(TestEnvironment.Options, TestEnvironment.Logger, "");
+            return new PreSpawnedBatch("foo.exe", _resultXmlFile, null, _eventStreamFile, outputFiles, TestEnvironment.Logger, "");
+        }
+    }
+}
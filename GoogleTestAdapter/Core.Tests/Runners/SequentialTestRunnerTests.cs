@@ -8,6 +8,7 @@ using GoogleTestAdapter.Model;
 using GoogleTestAdapter.Scheduling;
 using GoogleTestAdapter.Settings;
 using GoogleTestAdapter.Tests.Common;
+using GoogleTestAdapter.Tests.Common.Fakes;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
 using Moq;
 using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
@@ -99,6 +100,55 @@ namespace GoogleTestAdapter.Runners
                 It.Is<IEnumerable<TestResult>>(tr => CheckSingleResultHasOutcome(tr, TestOutcome.Passed))), Times.Once);
         }
 
+        [TestMethod]
+        [TestCategory(Integration)]
+        public void RunTests_CrashBudget_TestsAfterCrashAreRunByRestartedExecutable()
+        {
+            MockOptions.Setup(o => o.CrashBudget).Returns(1);
+            List<TestCase> testCasesToRun = TestDataCreator.GetTestCases("Crashing.AddPassesBeforeCrash", "Crashing.TheCrash",
+                "Crashing.AddFailsAfterCrash", "Crashing.AddPassesAfterCrash");
+            var reporter = new FakeFrameworkReporter();
+
+            var runner = new SequentialTestRunner("", 0, "", reporter, TestEnvironment.Logger, TestEnvironment.Options, new SchedulingAnalyzer(TestEnvironment.Logger));
+            runner.RunTests(testCasesToRun, false, ProcessExecutorFactory);
+
+            reporter.ReportedTestResults.Select(tr => $"{tr.TestCase.DisplayName}:{tr.Outcome}").Should().BeEquivalentTo(
+                "Crashing.AddPassesBeforeCrash:Passed",
+                "Crashing.TheCrash:Failed",
+                "Crashing.AddFailsAfterCrash:Failed",
+                "Crashing.AddPassesAfterCrash:Passed");
+        }
+
+        [TestMethod]
+        [TestCategory(Integration)]
+        public void RunTests_NoCrashBudget_TestsAfterCrashAreSkipped()
+        {
+            List<TestCase> testCasesToRun = TestDataCreator.GetTestCases("Crashing.TheCrash", "Crashing.AddPassesAfterCrash");
+            var reporter = new FakeFrameworkReporter();
+
+            var runner = new SequentialTestRunner("", 0, "", reporter, TestEnvironment.Logger, TestEnvironment.Options, new SchedulingAnalyzer(TestEnvironment.Logger));
+            runner.RunTests(testCasesToRun, false, ProcessExecutorFactory);
+
+            reporter.ReportedTestResults.Should().Contain(tr => tr.TestCase.DisplayName == "Crashing.AddPassesAfterCrash" && tr.Outcome == TestOutcome.Skipped);
+        }
+
+        [TestMethod]
+        [TestCategory(Integration)]
+        public void RunTests_PreSpawnTestProcesses_TestsOfAllBatchesAreRun()
+        {
+            MockOptions.Setup(o => o.PreSpawnTestProcesses).Returns(true);
+            List<TestCase> testCasesToRun = TestDataCreator.GetTestCases("TestMath.AddPasses", "Crashing.AddPassesBeforeCrash");
+            testCasesToRun.Add(TestDataCreator.ToTestCase("TestMath.AddPasses", TestResources.Tests_ReleaseX86));
+            var reporter = new FakeFrameworkReporter();
+
+            var runner = new SequentialTestRunner("", 0, "", reporter, TestEnvironment.Logger, TestEnvironment.Options, new SchedulingAnalyzer(TestEnvironment.Logger));
+            runner.RunTests(testCasesToRun, false, ProcessExecutorFactory);
+
+            MockLogger.Verify(l => l.LogError(It.IsAny<string>()), Times.Never);
+            reporter.ReportedTestResults.Should().HaveCount(testCasesToRun.Count);
+            reporter.ReportedTestResults.Should().OnlyContain(tr => tr.Outcome == TestOutcome.Passed);
+        }
+
         private void DoRunCancelingTests(bool killProcesses, int lower, int upper)
         {
             MockOptions.Setup(o => o.KillProcessesOnCancel).Returns(killProcesses);
@@ -0,0 +1,94 @@
+﻿using System;
+using System.Linq;
+using FluentAssertions;
+using GoogleTestAdapter.Tests.Common;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.Runners
+{
+    [TestClass]
+    public class TestFilterSynthesizerTests : TestsBase
+    {
+        private static readonly string[] AllTests =
+        {
+            "Suite.Foo", "Suite.Bar", "Suite.Baz", "Other.Test",
+            "Instance/Param.Test/0", "Instance/Param.Test/1", "Instance/Param.Other/0", "Instance2/Param.Test/0"
+        };
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void SynthesizeFilter_CompleteParameterizedInstance_SinglePrefixPattern()
+        {
+            string filter = new TestFilterSynthesizer(AllTests).SynthesizeFilter(
+                new[] { "Instance/Param.Test/0", "Instance/Param.Test/1", "Instance/Param.Other/0" });
+
+            filter.Should().Be("Instance/*");
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void SynthesizeFilter_MostTestsOfSuite_NegativePatternIsUsed()
+        {
+            string filter = new TestFilterSynthesizer(AllTests).SynthesizeFilter(new[] { "Suite.Foo", "Suite.Bar" });
+
+            filter.Should().Be("S*-Suite.Baz");
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void SynthesizeFilter_AllButFewTests_WildcardWithNegativePatterns()
+        {
+            var allTests = Enumerable.Range(0, 200).Select(i => $"Big/Param.Test/{i}").ToArray();
+            var selectedTests = allTests.Where(t => t != "Big/Param.Test/17" && t != "Big/Param.Test/42");
+
+            string filter = new TestFilterSynthesizer(allTests).SynthesizeFilter(selectedTests);
+
+            filter.Should().Be("*-Big/Param.Test/17:Big/Param.Test/42");
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void SynthesizeFilter_UnknownTest_ReturnsNull()
+        {
+            new TestFilterSynthesizer(AllTests).SynthesizeFilter(new[] { "Suite.Foo", "Suite.DoesNotExist" }).Should().BeNull();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void SynthesizeFilter_RandomSelections_FilterMatchesExactlySelectedTestsAndIsNotLongerThanPlainFilter()
+        {
+            var allTests = Enumerable.Range(0, 100).Select(i => $"Big/Param.Test/{i}")
+                .Concat(Enumerable.Range(0, 30).Select(i => $"Suite{i % 3}.Test{i}"))
+                .ToArray();
+            var synthesizer = new TestFilterSynthesizer(allTests);
+            var random = new Random(42);
+
+            for (int i = 0; i < 100; i++)
+            {
+                var selectedTests = allTests.Where(_ => random.Next(3) == 0).ToList();
+                if (selectedTests.Count == 0)
+                    continue;
+
+                string filter = synthesizer.SynthesizeFilter(selectedTests);
+
+                filter.Should().NotBeNull();
+                filter.Length.Should().BeLessOrEqualTo(string.Join(":", selectedTests).Length + 1);
+                allTests.Where(t => TestFilterSynthesizer.Matches(filter, t)).Should().BeEquivalentTo(selectedTests);
+            }
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Matches_GoogleTestFilterSemantics()
+        {
+            TestFilterSynthesizer.Matches("Suite.*", "Suite.Foo").Should().BeTrue();
+            TestFilterSynthesizer.Matches("S?ite.F*", "Suite.Foo").Should().BeTrue();
+            TestFilterSynthesizer.Matches("Suite.Bar:Other.*", "Suite.Foo").Should().BeFalse();
+            TestFilterSynthesizer.Matches("-Suite.Foo", "Suite.Bar").Should().BeTrue();
+            TestFilterSynthesizer.Matches("*-Suite.Foo", "Suite.Foo").Should().BeFalse();
+        }
+
+    }
+
+}
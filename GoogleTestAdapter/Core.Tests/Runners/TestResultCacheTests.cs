@@ -0,0 +1,91 @@
+﻿using System.Collections.Generic;
+using System.Linq;
+using FluentAssertions;
+using GoogleTestAdapter.Helpers;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.Tests.Common;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.Runners
+{
+    [TestClass]
+    public class TestResultCacheTests : TestsBase
+    {
+        private string _cacheDirectory;
+
+        [TestInitialize]
+        public override void SetUp()
+        {
+            base.SetUp();
+            _cacheDirectory = Utils.GetTempDirectory();
+        }
+
+        [TestCleanup]
+        public override void TearDown()
+        {
+            Utils.DeleteDirectory(_cacheDirectory);
+            base.TearDown();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetResults_AllTestsHavePassed_CachedResultsAreReturned()
+        {
+            var cache = new TestResultCache(_cacheDirectory, MockLogger.Object);
+            var results = new[]
+            {
+                TestDataCreator.ToTestResult("Suite.Test1", TestOutcome.Passed, 10, "foo.exe"),
+                TestDataCreator.ToTestResult("Suite.Test2", TestOutcome.Passed, 20, "foo.exe")
+            };
+            cache.StoreResults("key", "foo.exe", results);
+
+            IList<TestResult> cachedResults = cache.GetResults("key", results.Select(tr => tr.TestCase).ToList());
+
+            cachedResults.Should().HaveCount(2);
+            cachedResults.Should().OnlyContain(tr => tr.IsCached && tr.Outcome == TestOutcome.Passed);
+            cachedResults.Single(tr => tr.TestCase.FullyQualifiedName == "Suite.Test2").Duration.TotalMilliseconds.Should().Be(20);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetResults_TestHasFailedAfterPassing_ReturnsNull()
+        {
+            var cache = new TestResultCache(_cacheDirectory, MockLogger.Object);
+            TestResult passedResult = TestDataCreator.ToTestResult("Suite.Test1", TestOutcome.Passed, 10, "foo.exe");
+            TestResult otherPassedResult = TestDataCreator.ToTestResult("Suite.Test2", TestOutcome.Passed, 10, "foo.exe");
+            cache.StoreResults("key", "foo.exe", new[] { passedResult, otherPassedResult });
+            cache.StoreResults("key", "foo.exe", TestDataCreator.ToTestResult("Suite.Test1", TestOutcome.Failed, 10, "foo.exe").Yield());
+
+            cache.GetResults("key", new List<TestCase> { passedResult.TestCase, otherPassedResult.TestCase }).Should().BeNull();
+            cache.GetResults("key", new List<TestCase> { otherPassedResult.TestCase }).Should().ContainSingle();
+            cache.GetResults("otherKey", new List<TestCase> { otherPassedResult.TestCase }).Should().BeNull();
+        }
+
+        [TestMethod]
+        [TestCategory(Integration)]
+        public void ComputeKey_SettingsChange_KeyChanges()
+        {
+            var cache = new TestResultCache(_cacheDirectory, MockLogger.Object);
+            string key = cache.ComputeKey(TestResources.Tests_DebugX86, TestEnvironment.Options);
+
+            cache.ComputeKey(TestResources.Tests_DebugX86, TestEnvironment.Options).Should().Be(key);
+
+            MockOptions.Setup(o => o.AdditionalTestExecutionParam).Returns("-myParam");
+            cache.ComputeKey(TestResources.Tests_DebugX86, TestEnvironment.Options).Should().NotBe(key);
+        }
+
+        [TestMethod]
+        [TestCategory(Integration)]
+        public void ComputeKey_ExecutionModeChanges_KeyChanges()
+        {
+            var cache = new TestResultCache(_cacheDirectory, MockLogger.Object);
+            string key = cache.ComputeKey(TestResources.Tests_DebugX86, TestEnvironment.Options, "FlagFile=False");
+
+            cache.ComputeKey(TestResources.Tests_DebugX86, TestEnvironment.Options, "FlagFile=False").Should().Be(key);
+            cache.ComputeKey(TestResources.Tests_DebugX86, TestEnvironment.Options, "FlagFile=True").Should().NotBe(key);
+        }
+
+    }
+
+}
@@ -0,0 +1,97 @@
+﻿using System;
+using FluentAssertions;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.Tests.Common;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.Runners
+{
+    [TestClass]
+    public class TestTimeoutWatchdogTests : TestsBase
+    {
+        private int _nrOfTimeouts;
+
+        [TestInitialize]
+        public override void SetUp()
+        {
+            base.SetUp();
+            _nrOfTimeouts = 0;
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void CheckTimeouts_TestRunsLongerThanTestTimeout_TimeoutActionIsInvokedOnce()
+        {
+            var watchdog = CreateWatchdog(10, 0);
+            watchdog.ReportLine("[ RUN      ] Suite.Hanging");
+
+            watchdog.CheckTimeouts(DateTime.UtcNow.AddSeconds(5)).Should().BeFalse();
+            watchdog.CheckTimeouts(DateTime.UtcNow.AddSeconds(11)).Should().BeTrue();
+            watchdog.CheckTimeouts(DateTime.UtcNow.AddSeconds(12)).Should().BeTrue();
+
+            _nrOfTimeouts.Should().Be(1);
+            watchdog.HasTimedOut.Should().BeTrue();
+            watchdog.TimedOutTest.Should().Be("Suite.Hanging");
+            watchdog.TimeoutMessage.Should().Contain("Suite.Hanging").And.Contain("10s");
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void CheckTimeouts_TestHasFinished_NoTimeout()
+        {
+            var watchdog = CreateWatchdog(10, 0);
+            watchdog.ReportLine("[ RUN      ] Suite.Test");
+            watchdog.ReportLine("some output[       OK ] Suite.Test (3 ms)");
+
+            watchdog.CheckTimeouts(DateTime.UtcNow.AddSeconds(11)).Should().BeFalse();
+
+            _nrOfTimeouts.Should().Be(0);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void CheckTimeouts_ExecutableRunsLongerThanProcessTimeout_TimeoutActionIsInvoked()
+        {
+            var watchdog = CreateWatchdog(0, 60);
+            watchdog.Start();
+
+            watchdog.CheckTimeouts(DateTime.UtcNow.AddSeconds(61)).Should().BeTrue();
+
+            _nrOfTimeouts.Should().Be(1);
+            watchdog.TimedOutTest.Should().BeNull();
+            watchdog.TimeoutMessage.Should().Contain("60s");
+            watchdog.Dispose();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void CheckTimeouts_TimeoutsDisabled_NoTimeout()
+        {
+            var watchdog = CreateWatchdog(0, 0);
+            watchdog.ReportLine("[ RUN      ] Suite.Hanging");
+
+            watchdog.CheckTimeouts(DateTime.UtcNow.AddDays(1)).Should().BeFalse();
+
+            _nrOfTimeouts.Should().Be(0);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void IsTimeoutResult_TimeoutMessage_IsRecognized()
+        {
+            var testCase = TestDataCreator.ToTestCase("Suite.Test");
+
+            TestTimeoutWatchdog.IsTimeoutResult(new TestResult(testCase) { ErrorMessage = TestTimeoutWatchdog.CreateTimeoutMessage("reason") }).Should().BeTrue();
+            TestTimeoutWatchdog.IsTimeoutResult(new TestResult(testCase) { ErrorMessage = "Failed" }).Should().BeFalse();
+            TestTimeoutWatchdog.IsTimeoutResult(new TestResult(testCase)).Should().BeFalse();
+        }
+
+        private TestTimeoutWatchdog CreateWatchdog(int testTimeoutInSeconds, int processTimeoutInSeconds)
+        {
+            return new TestTimeoutWatchdog(testTimeoutInSeconds, processTimeoutInSeconds, () => _nrOfTimeouts++, TestEnvironment.Logger);
+        }
+
+    }
+
+}
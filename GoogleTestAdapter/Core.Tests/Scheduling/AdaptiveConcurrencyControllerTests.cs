@@ -0,0 +1,132 @@
+﻿using System;
+using System.Threading.Tasks;
+using FluentAssertions;
+using GoogleTestAdapter.Tests.Common;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using Moq;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    [TestClass]
+    public class AdaptiveConcurrencyControllerTests : TestsBase
+    {
+        private static readonly MachineLoad IdleMachine = new MachineLoad(10, 0, 8000);
+        private static readonly MachineLoad BusyMachine = new MachineLoad(80, 4, 8000);
+        private static readonly MachineLoad OverloadedMachine = new MachineLoad(100, 20, 8000);
+        private static readonly MachineLoad LowOnMemory = new MachineLoad(10, 0, 500);
+
+        private Mock<IMachineLoadSampler> _mockSampler;
+
+        [TestInitialize]
+        public override void SetUp()
+        {
+            base.SetUp();
+            _mockSampler = new Mock<IMachineLoadSampler>();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Limit_Initially_NumberOfProcessorsWithinBounds()
+        {
+            CreateController(1, 8, 4).Limit.Should().Be(4);
+            CreateController(1, 2, 4).Limit.Should().Be(2);
+            CreateController(6, 8, 4).Limit.Should().Be(6);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Adjust_OverloadedMachine_LimitIsLoweredDownToMinimum()
+        {
+            var controller = CreateController(2, 8, 4);
+
+            controller.Adjust(OverloadedMachine);
+            controller.Limit.Should().Be(3);
+
+            controller.Adjust(OverloadedMachine);
+            controller.Adjust(OverloadedMachine);
+            controller.Limit.Should().Be(2);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Adjust_LowOnMemory_LimitIsLowered()
+        {
+            var controller = CreateController(1, 8, 4);
+
+            controller.Adjust(LowOnMemory);
+
+            controller.Limit.Should().Be(3);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Adjust_IdleMachineWithoutWaitingProcesses_LimitIsKept()
+        {
+            var controller = CreateController(1, 8, 4);
+
+            controller.Adjust(IdleMachine);
+            controller.Adjust(BusyMachine);
+
+            controller.Limit.Should().Be(4);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Adjust_IdleMachineWithWaitingProcess_LimitIsRaisedUpToMaximumAndProcessIsStarted()
+        {
+            var controller = CreateController(1, 2, 1);
+            IDisposable firstPermit = controller.Acquire();
+            Task<IDisposable> secondAcquisition = Task.Run(() => controller.Acquire());
+            secondAcquisition.Wait(200).Should().BeFalse();
+
+            controller.Adjust(IdleMachine);
+            controller.Adjust(IdleMachine);
+
+            secondAcquisition.Wait(5000).Should().BeTrue();
+            controller.Limit.Should().Be(2);
+
+            secondAcquisition.Result.Dispose();
+            firstPermit.Dispose();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Acquire_LimitReached_BlocksUntilPermitIsReleased()
+        {
+            var controller = CreateController(1, 1, 1);
+            IDisposable permit = controller.Acquire();
+
+            Task<IDisposable> acquisition = Task.Run(() => controller.Acquire());
+            acquisition.Wait(200).Should().BeFalse();
+
+            permit.Dispose();
+            permit.Dispose();
+            acquisition.Wait(5000).Should().BeTrue();
+            acquisition.Result.Dispose();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Dispose_WaitingProcess_IsReleasedAndSamplerIsDisposed()
+        {
+            var controller = CreateController(1, 1, 1);
+            controller.Acquire();
+
+            Task<IDisposable> acquisition = Task.Run(() => controller.Acquire());
+            acquisition.Wait(200).Should().BeFalse();
+
+            controller.Dispose();
+
+            acquisition.Wait(5000).Should().BeTrue();
+            _mockSampler.Verify(s => s.Dispose(), Times.Once);
+        }
+
+        private AdaptiveConcurrencyController CreateController(int minLimit, int maxLimit, int nrOfProcessors)
+        {
+            return new AdaptiveConcurrencyController(minLimit, maxLimit, nrOfProcessors, _mockSampler.Object, TestEnvironment.Logger);
+        }
+
+    }
+
+}
@@ -0,0 +1,94 @@
+﻿using System.Collections.Generic;
+using System.Linq;
+using FluentAssertions;
+using GoogleTestAdapter.Tests.Common;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    [TestClass]
+    public class CpuSetPlannerTests : TestsBase
+    {
+        private static readonly IList<NumaNode> TwoNodesWithEightProcessors = new List<NumaNode>
+        {
+            new NumaNode(0, Enumerable.Range(0, 8)),
+            new NumaNode(1, Enumerable.Range(8, 8))
+        };
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void CreateCpuSets_TwoNodesAndFourThreads_TwoDisjointCpuSetsPerNode()
+        {
+            IList<CpuSet> cpuSets = new CpuSetPlanner(TwoNodesWithEightProcessors).CreateCpuSets(4);
+
+            cpuSets.Select(s => s.ToString()).Should().Equal("0-3", "4-7", "8-11", "12-15");
+            cpuSets.Select(s => CpuSet.FormatNumbers(s.NumaNodes)).Should().Equal("0", "0", "1", "1");
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void CreateCpuSets_ThreeThreads_CpuSetsDoNotSpanNodes()
+        {
+            IList<CpuSet> cpuSets = new CpuSetPlanner(TwoNodesWithEightProcessors).CreateCpuSets(3);
+
+            cpuSets.Select(s => s.ToString()).Should().Equal("0-3", "4-7", "8-15");
+            cpuSets.SelectMany(s => s.Processors).Should().OnlyHaveUniqueItems();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void CreateCpuSets_SingleThread_CpuSetSpansAllNodes()
+        {
+            IList<CpuSet> cpuSets = new CpuSetPlanner(TwoNodesWithEightProcessors).CreateCpuSets(1);
+
+            cpuSets.Should().ContainSingle();
+            cpuSets[0].ToString().Should().Be("0-15");
+            cpuSets[0].AffinityMask.Should().Be(0xFFFFUL);
+            CpuSet.FormatNumbers(cpuSets[0].NumaNodes).Should().Be("0-1");
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void CreateCpuSets_UnevenNodes_ThreadsAreDistributedProportionally()
+        {
+            var numaNodes = new List<NumaNode>
+            {
+                new NumaNode(0, Enumerable.Range(0, 12)),
+                new NumaNode(1, Enumerable.Range(12, 4))
+            };
+
+            IList<CpuSet> cpuSets = new CpuSetPlanner(numaNodes).CreateCpuSets(4);
+
+            cpuSets.Select(s => s.ToString()).Should().Equal("0-3", "4-7", "8-11", "12-15");
+            cpuSets.Select(s => CpuSet.FormatNumbers(s.NumaNodes)).Should().Equal("0", "0", "0", "1");
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void CreateCpuSets_MoreThreadsThanProcessors_ProcessorsAreShared()
+        {
+            var numaNodes = new List<NumaNode> { new NumaNode(0, new[] { 0, 1 }) };
+
+            IList<CpuSet> cpuSets = new CpuSetPlanner(numaNodes).CreateCpuSets(3);
+
+            cpuSets.Select(s => s.ToString()).Should().Equal("0", "1", "0");
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void AddEnvironmentVariables_CpuSet_VariablesAreSet()
+        {
+            var cpuSet = new CpuSet(new[] { 10, 0, 1, 2, 3, 8 }, new[] { 0 });
+            var environmentVariables = new Dictionary<string, string>();
+
+            cpuSet.AddEnvironmentVariables(environmentVariables);
+
+            environmentVariables[CpuSet.CpuSetEnvironmentVariable].Should().Be("0-3,8,10");
+            environmentVariables[CpuSet.CpuCountEnvironmentVariable].Should().Be("6");
+            environmentVariables[CpuSet.NumaNodesEnvironmentVariable].Should().Be("0");
+        }
+
+    }
+
+}
@@ -0,0 +1,96 @@
+﻿using System.Collections.Generic;
+using System.Linq;
+using FluentAssertions;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.Tests.Common;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    [TestClass]
+    public class ExecutableAffinityTestsSplitterTests : TestsBase
+    {
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void SplitTestcases_ExecutablesOfEqualDuration_EachExecutableIsRunByOneThread()
+        {
+            IDictionary<TestCase, int> durations = new Dictionary<TestCase, int>();
+            AddTests(durations, "a.exe", 10);
+            AddTests(durations, "b.exe", 10);
+            AddTests(durations, "c.exe", 10);
+            AddTests(durations, "d.exe", 10);
+            MockOptions.Setup(o => o.MaxNrOfThreads).Returns(4);
+
+            List<List<TestCase>> result = new ExecutableAffinityTestsSplitter(durations.Keys, durations, TestEnvironment.Options).SplitTestcases();
+
+            result.Should().HaveCount(4);
+            result.Should().OnlyContain(testCases => testCases.Count == 10 && testCases.Select(tc => tc.Source).Distinct().Count() == 1);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void SplitTestcases_OneLongExecutable_ExecutableIsSplitAlongSuites()
+        {
+            IDictionary<TestCase, int> durations = new Dictionary<TestCase, int>();
+            AddTests(durations, "big.exe", 40);
+            AddTests(durations, "small.exe", 4);
+            MockOptions.Setup(o => o.MaxNrOfThreads).Returns(4);
+
+            List<List<TestCase>> result = new ExecutableAffinityTestsSplitter(durations.Keys, durations, TestEnvironment.Options).SplitTestcases();
+
+            result.Should().HaveCount(4);
+            result.SelectMany(testCases => testCases).Should().BeEquivalentTo(durations.Keys);
+            result.Should().OnlyContain(testCases => testCases.Where(tc => tc.Source == "big.exe").Select(tc => tc.FullyQualifiedName.Split('.')[0]).Distinct().Count() == 1);
+            result.Should().ContainSingle(testCases => testCases.Any(tc => tc.Source == "small.exe"))
+                .Which.Count(tc => tc.Source == "small.exe").Should().Be(4);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void SplitTestcases_LessTestsThanThreads_NoEmptyLists()
+        {
+            IDictionary<TestCase, int> durations = new Dictionary<TestCase, int>();
+            AddTests(durations, "a.exe", 2);
+            MockOptions.Setup(o => o.MaxNrOfThreads).Returns(8);
+
+            List<List<TestCase>> result = new ExecutableAffinityTestsSplitter(durations.Keys, null, TestEnvironment.Options).SplitTestcases();
+
+            result.Should().HaveCount(2);
+            result.Should().OnlyContain(testCases => testCases.Count == 1);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void SplitTestcases_ExpensiveProcessStartup_ExecutableIsNotSplit()
+        {
+            IDictionary<TestCase, int> durations = new Dictionary<TestCase, int>();
+            AddTests(durations, "a.exe", 8);
+            AddTests(durations, "b.exe", 8);
+            var overheads = new Dictionary<string, ExecutableOverhead>
+            {
+                { "a.exe", new ExecutableOverhead { StartupDuration = 5000, ShutdownDuration = 1000 } }
+            };
+            MockOptions.Setup(o => o.MaxNrOfThreads).Returns(2);
+
+            List<List<TestCase>> result = new ExecutableAffinityTestsSplitter(durations.Keys, durations, TestEnvironment.Options, overheads).SplitTestcases();
+
+            result.Should().HaveCount(2);
+            result.Should().OnlyContain(testCases => testCases.Select(tc => tc.Source).Distinct().Count() == 1);
+        }
+
+        /// <summary>
+        /// Tests of 100ms each are distributed round robin to 4 suites
+        /// </summary>
+        private void AddTests(IDictionary<TestCase, int> durations, string executable, int nrOfTests)
+        {
+            for (int i = 0; i < nrOfTests; i++)
+            {
+                durations.Add(TestDataCreator.ToTestCase($"Suite{i % 4}.Test{i}", executable), 100);
+            }
+        }
+
+    }
+
+}
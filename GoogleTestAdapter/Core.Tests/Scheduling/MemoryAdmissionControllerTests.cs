@@ -0,0 +1,140 @@
+﻿using System;
+using System.Threading.Tasks;
+using FluentAssertions;
+using GoogleTestAdapter.Tests.Common;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    [TestClass]
+    public class MemoryAdmissionControllerTests : TestsBase
+    {
+        private const long Gb = 1024L * 1024L * 1024L;
+
+        private const string HeavyExecutable = @"C:\NonExisting\Heavy.exe";
+        private const string LightExecutable = @"C:\NonExisting\Light.exe";
+        private const string UnknownExecutable = @"C:\NonExisting\Unknown.exe";
+
+        private MemoryAdmissionController _controller;
+
+        [TestInitialize]
+        public override void SetUp()
+        {
+            base.SetUp();
+            _controller = new MemoryAdmissionController(10 * Gb, TestEnvironment.Logger);
+            _controller.ReportPeakMemory(HeavyExecutable, 6 * Gb);
+            _controller.ReportPeakMemory(LightExecutable, 1 * Gb);
+        }
+
+        [TestCleanup]
+        public override void TearDown()
+        {
+            _controller.Dispose();
+            base.TearDown();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Acquire_PredictedTotalExceedsBudget_BlocksUntilAdmissionIsReleased()
+        {
+            IDisposable admission = _controller.Acquire(HeavyExecutable);
+
+            Task<IDisposable> acquisition = Task.Run(() => _controller.Acquire(HeavyExecutable));
+            acquisition.Wait(200).Should().BeFalse();
+
+            admission.Dispose();
+            admission.Dispose();
+            acquisition.Wait(5000).Should().BeTrue();
+            acquisition.Result.Dispose();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Acquire_HeavyProcessIsWaiting_LighterProcessesAreAdmitted()
+        {
+            IDisposable admission = _controller.Acquire(HeavyExecutable);
+            Task<IDisposable> heavyAcquisition = Task.Run(() => _controller.Acquire(HeavyExecutable));
+            heavyAcquisition.Wait(200).Should().BeFalse();
+
+            Task<IDisposable> lightAcquisition = Task.Run(() => _controller.Acquire(LightExecutable));
+            Task<IDisposable> unknownAcquisition = Task.Run(() => _controller.Acquire(UnknownExecutable));
+            lightAcquisition.Wait(5000).Should().BeTrue();
+            unknownAcquisition.Wait(5000).Should().BeTrue();
+            heavyAcquisition.IsCompleted.Should().BeFalse();
+
+            admission.Dispose();
+            heavyAcquisition.Wait(5000).Should().BeTrue();
+            heavyAcquisition.Result.Dispose();
+            lightAcquisition.Result.Dispose();
+            unknownAcquisition.Result.Dispose();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Acquire_HeavyProcessHasBeenBypassedTooOften_LighterProcessesWaitBehindIt()
+        {
+            var controller = new MemoryAdmissionController(10 * Gb, TestEnvironment.Logger, maxNrOfBypasses: 2);
+            controller.ReportPeakMemory(HeavyExecutable, 6 * Gb);
+            controller.ReportPeakMemory(LightExecutable, 1 * Gb);
+            IDisposable heavyAdmission = controller.Acquire(HeavyExecutable);
+            Task<IDisposable> heavyAcquisition = Task.Run(() => controller.Acquire(HeavyExecutable));
+            heavyAcquisition.Wait(200).Should().BeFalse();
+
+            IDisposable firstLightAdmission = controller.Acquire(LightExecutable);
+            IDisposable secondLightAdmission = controller.Acquire(LightExecutable);
+            Task<IDisposable> lightAcquisition = Task.Run(() => controller.Acquire(LightExecutable));
+            lightAcquisition.Wait(200).Should().BeFalse();
+
+            heavyAdmission.Dispose();
+            heavyAcquisition.Wait(5000).Should().BeTrue();
+            lightAcquisition.Wait(5000).Should().BeTrue();
+
+            heavyAcquisition.Result.Dispose();
+            lightAcquisition.Result.Dispose();
+            firstLightAdmission.Dispose();
+            secondLightAdmission.Dispose();
+            controller.Dispose();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Acquire_NoProcessIsRunning_ProcessExceedingBudgetIsAdmitted()
+        {
+            _controller.ReportPeakMemory(HeavyExecutable, 12 * Gb);
+
+            Task<IDisposable> acquisition = Task.Run(() => _controller.Acquire(HeavyExecutable));
+
+            acquisition.Wait(5000).Should().BeTrue();
+            acquisition.Result.Dispose();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void ReportPeakMemory_SeveralProcesses_HighestPeakOfRunIsPredictedAndReturned()
+        {
+            _controller.GetPredictedPeakMemory(UnknownExecutable).Should().Be(0);
+
+            _controller.ReportPeakMemory(HeavyExecutable, 4 * Gb).Should().Be(6 * Gb);
+            _controller.ReportPeakMemory(HeavyExecutable, 7 * Gb).Should().Be(7 * Gb);
+
+            _controller.GetPredictedPeakMemory(HeavyExecutable).Should().Be(7 * Gb);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Dispose_WaitingProcess_IsReleased()
+        {
+            _controller.Acquire(HeavyExecutable);
+
+            Task<IDisposable> acquisition = Task.Run(() => _controller.Acquire(HeavyExecutable));
+            acquisition.Wait(200).Should().BeFalse();
+
+            _controller.Dispose();
+
+            acquisition.Wait(5000).Should().BeTrue();
+        }
+
+    }
+
+}
@@ -0,0 +1,114 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading.Tasks;
+using FluentAssertions;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.Tests.Common;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    [TestClass]
+    public class ResourceLockManagerTests : TestsBase
+    {
+        private ResourceLockManager _resourceLocks;
+
+        [TestInitialize]
+        public override void SetUp()
+        {
+            base.SetUp();
+            _resourceLocks = new ResourceLockManager();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GroupByLocks_MixedTests_UnconstrainedTestsFirstAndConstrainedTestsGroupedByLocks()
+        {
+            var free1 = CreateTestCase("Suite.Free1");
+            var free2 = CreateTestCase("Suite.Free2");
+            var db1 = CreateTestCase("Suite.Db1", new Trait("Resource", "Database"));
+            var db2 = CreateTestCase("Suite.Db2", new Trait("resource", "database"));
+            var exclusive = CreateTestCase("Suite.Exclusive", new Trait("Exclusive", "true"));
+            var notExclusive = CreateTestCase("Suite.NotExclusive", new Trait("Exclusive", "false"));
+
+            var groups = ResourceLockManager.GroupByLocks(new[] { db1, exclusive, free1, db2, notExclusive, free2 }).ToList();
+
+            groups.Should().HaveCount(3);
+            groups[0].Should().Equal(free1, notExclusive, free2);
+            groups.Should().ContainSingle(g => g.SequenceEqual(new[] { db1, db2 }));
+            groups.Should().ContainSingle(g => g.SequenceEqual(new[] { exclusive }));
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetLockKey_SeveralResources_KeyDoesNotDependOnOrder()
+        {
+            var testCase1 = CreateTestCase("Suite.Test1", new Trait("Resource", "Port"), new Trait("Resource", "Database"));
+            var testCase2 = CreateTestCase("Suite.Test2", new Trait("Resource", "Database"), new Trait("Resource", "Port"));
+
+            ResourceLockManager.GetLockKey(testCase1).Should().Be(ResourceLockManager.GetLockKey(testCase2));
+            ResourceLockManager.GetLockKey(CreateTestCase("Suite.Test3")).Should().BeEmpty();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Acquire_SameResource_BlocksUntilReleased()
+        {
+            IDisposable locks = _resourceLocks.Acquire(new[] { CreateTestCase("Suite.Db1", new Trait("Resource", "Database")) });
+
+            Task<IDisposable> acquisition = Task.Run(() => _resourceLocks.Acquire(new[] { CreateTestCase("Suite.Db2", new Trait("Resource", "Database")) }));
+            acquisition.Wait(200).Should().BeFalse();
+
+            locks.Dispose();
+            acquisition.Wait(5000).Should().BeTrue();
+            acquisition.Result.Dispose();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Acquire_DifferentResourcesAndUnconstrainedTests_DoNotBlock()
+        {
+            var locks = new List<IDisposable>
+            {
+                _resourceLocks.Acquire(new[] { CreateTestCase("Suite.Db", new Trait("Resource", "Database")) }),
+                _resourceLocks.Acquire(new[] { CreateTestCase("Suite.Port", new Trait("Resource", "Port")) }),
+                _resourceLocks.Acquire(new[] { CreateTestCase("Suite.Free1") }),
+                _resourceLocks.Acquire(new[] { CreateTestCase("Suite.Free2") })
+            };
+
+            locks.ForEach(l => l.Dispose());
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Acquire_ExclusiveTest_WaitsForRunningProcessesAndBlocksNewOnes()
+        {
+            IDisposable running = _resourceLocks.Acquire(new[] { CreateTestCase("Suite.Free1") });
+
+            Task<IDisposable> exclusiveAcquisition = Task.Run(() => _resourceLocks.Acquire(new[] { CreateTestCase("Suite.Exclusive", new Trait("Exclusive", "true")) }));
+            exclusiveAcquisition.Wait(200).Should().BeFalse();
+
+            Task<IDisposable> otherAcquisition = Task.Run(() => _resourceLocks.Acquire(new[] { CreateTestCase("Suite.Free2") }));
+            otherAcquisition.Wait(200).Should().BeFalse();
+
+            running.Dispose();
+            exclusiveAcquisition.Wait(5000).Should().BeTrue();
+            otherAcquisition.Wait(200).Should().BeFalse();
+
+            exclusiveAcquisition.Result.Dispose();
+            otherAcquisition.Wait(5000).Should().BeTrue();
+            otherAcquisition.Result.Dispose();
+        }
+
+        private TestCase CreateTestCase(string name, params Trait[] traits)
+        {
+            TestCase testCase = TestDataCreator.ToTestCase(name);
+            testCase.Traits.AddRange(traits);
+            return testCase;
+        }
+
+    }
+
+}
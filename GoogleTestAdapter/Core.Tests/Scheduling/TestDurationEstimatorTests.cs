@@ -0,0 +1,47 @@
+﻿using System.Collections.Generic;
+using FluentAssertions;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.Tests.Common;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    [TestClass]
+    public class TestDurationEstimatorTests : TestsBase
+    {
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetDurations_PartiallyKnownDurations_MissingDurationsAreEstimatedFromSuiteExecutableAndAllTests()
+        {
+            TestCase known1 = TestDataCreator.ToTestCase("Suite1.Test1", "a.exe");
+            TestCase known2 = TestDataCreator.ToTestCase("Suite1.Test2", "a.exe");
+            TestCase known3 = TestDataCreator.ToTestCase("Suite1.Test3", "a.exe");
+            TestCase known4 = TestDataCreator.ToTestCase("Suite2.Test1", "b.exe");
+            TestCase newTestOfKnownSuite = TestDataCreator.ToTestCase("Suite1.NewTest", "a.exe");
+            TestCase newTestOfKnownExecutable = TestDataCreator.ToTestCase("NewSuite.Test", "b.exe");
+            TestCase newTestOfNewExecutable = TestDataCreator.ToTestCase("NewSuite.Test", "c.exe");
+            var knownDurations = new Dictionary<TestCase, int> { { known1, 10 }, { known2, 30 }, { known3, 1000 }, { known4, 7 } };
+
+            IDictionary<TestCase, int> durations = new TestDurationEstimator(knownDurations)
+                .GetDurations(new[] { known1, known4, newTestOfKnownSuite, newTestOfKnownExecutable, newTestOfNewExecutable });
+
+            durations.Should().HaveCount(5);
+            durations[known1].Should().Be(10);
+            durations[known4].Should().Be(7);
+            durations[newTestOfKnownSuite].Should().Be(30);
+            durations[newTestOfKnownExecutable].Should().Be(7);
+            durations[newTestOfNewExecutable].Should().Be(20);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetDuration_NoDurationsKnown_ReturnsOne()
+        {
+            new TestDurationEstimator(new Dictionary<TestCase, int>()).GetDuration(TestDataCreator.ToTestCase("Suite.Test")).Should().Be(1);
+        }
+
+    }
+
+}
@@ -133,6 +133,121 @@ namespace GoogleTestAdapter.Scheduling
             File.Delete(GetDurationsFile(serializer, tempFile));
         }
 
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void UpdateTestDurations_ResultWithResourceUsage_ResourceUsageIsWrittenAndKeptForResultsWithoutUsage()
+        {
+            string tempFile = Path.GetTempFileName();
+            Model.TestResult testResult = TestDataCreator.ToTestResult("TestSuite1.Test1", Model.TestOutcome.Passed, 3, tempFile);
+            testResult.ResourceUsage = new Model.ResourceUsage
+            {
+                UserTime = TimeSpan.FromMilliseconds(20),
+                KernelTime = TimeSpan.FromMilliseconds(5),
+                PeakMemoryInBytes = 4096 * 1024,
+                PageFaults = 100,
+                ReadBytes = 1000,
+                WriteBytes = 2000
+            };
+
+            var serializer = new TestDurationSerializer();
+            serializer.UpdateTestDurations(testResult.Yield());
+            serializer.UpdateTestDurations(TestDataCreator.ToTestResult("TestSuite1.Test1", Model.TestOutcome.Passed, 4, tempFile).Yield());
+
+            serializer.ReadTestDurations(testResult.TestCase.Yield())[testResult.TestCase].Should().Be(4);
+            Model.ResourceUsage resourceUsage = serializer.ReadResourceUsages(testResult.TestCase.Yield())[testResult.TestCase];
+            resourceUsage.CpuTime.Should().Be(TimeSpan.FromMilliseconds(25));
+            resourceUsage.PeakMemoryInBytes.Should().Be(4096 * 1024);
+            resourceUsage.PageFaults.Should().Be(100);
+            resourceUsage.ReadBytes.Should().Be(1000);
+            resourceUsage.WriteBytes.Should().Be(2000);
+
+            File.Delete(GetDurationsFile(serializer, tempFile));
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void ReadResourceUsages_NoResourceUsageKnown_EmptyDictionary()
+        {
+            string tempFile = Path.GetTempFileName();
+            Model.TestResult testResult = TestDataCreator.ToTestResult("TestSuite1.Test1", Model.TestOutcome.Passed, 3, tempFile);
+
+            var serializer = new TestDurationSerializer();
+            serializer.UpdateTestDurations(testResult.Yield());
+
+            serializer.ReadResourceUsages(testResult.TestCase.Yield()).Should().BeEmpty();
+
+            File.Delete(GetDurationsFile(serializer, tempFile));
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void ReadLastOutcomes_PassedAndFailedResults_LastOutcomesAreReturned()
+        {
+            string tempFile = Path.GetTempFileName();
+            Model.TestResult passedResult = TestDataCreator.ToTestResult("TestSuite1.Test1", Model.TestOutcome.Passed, 3, tempFile);
+            Model.TestResult failedResult = TestDataCreator.ToTestResult("TestSuite1.Test2", Model.TestOutcome.Failed, 3, tempFile);
+            Model.TestResult skippedResult = TestDataCreator.ToTestResult("TestSuite1.Test3", Model.TestOutcome.Skipped, 0, tempFile);
+
+            var serializer = new TestDurationSerializer();
+            serializer.UpdateTestDurations(new[] { passedResult, failedResult, skippedResult });
+
+            IDictionary<Model.TestCase, Model.TestOutcome> outcomes = serializer.ReadLastOutcomes(new[] { passedResult.TestCase, failedResult.TestCase, skippedResult.TestCase });
+            outcomes.Should().HaveCount(2);
+            outcomes[passedResult.TestCase].Should().Be(Model.TestOutcome.Passed);
+            outcomes[failedResult.TestCase].Should().Be(Model.TestOutcome.Failed);
+
+            File.Delete(GetDurationsFile(serializer, tempFile));
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void UpdateExecutableOverhead_OverheadsOfSeveralRuns_SuiteOverheadsAreMergedAndTestDurationsAreKept()
+        {
+            string tempFile = Path.GetTempFileName();
+            Model.TestResult testResult = TestDataCreator.ToTestResult("TestSuite1.Test1", Model.TestOutcome.Passed, 3, tempFile);
+            var firstOverhead = new ExecutableOverhead { StartupDuration = 100, ShutdownDuration = 20 };
+            firstOverhead.SuiteDurations["TestSuite1"] = 50;
+            var secondOverhead = new ExecutableOverhead { StartupDuration = 110, ShutdownDuration = 30 };
+            secondOverhead.SuiteDurations["TestSuite2"] = 60;
+
+            var serializer = new TestDurationSerializer();
+            serializer.UpdateTestDurations(testResult.Yield());
+            serializer.UpdateExecutableOverhead(tempFile, firstOverhead);
+            serializer.UpdateExecutableOverhead(tempFile, secondOverhead);
+
+            serializer.ReadTestDurations(testResult.TestCase.Yield())[testResult.TestCase].Should().Be(3);
+            IDictionary<string, ExecutableOverhead> overheads = serializer.ReadExecutableOverheads(new[] { tempFile, TestResources.Tests_DebugX86 });
+            overheads.Should().ContainSingle();
+            ExecutableOverhead overhead = overheads[tempFile];
+            overhead.StartupDuration.Should().Be(110);
+            overhead.ShutdownDuration.Should().Be(30);
+            overhead.SuiteDurations.Should().HaveCount(2);
+            overhead.SuiteDurations["TestSuite1"].Should().Be(50);
+            overhead.SuiteDurations["TestSuite2"].Should().Be(60);
+
+            File.Delete(GetDurationsFile(serializer, tempFile));
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void UpdatePeakMemory_PeakMemoriesOfSeveralRuns_LastPeakMemoryIsReadAndTestDurationsAreKept()
+        {
+            string tempFile = Path.GetTempFileName();
+            Model.TestResult testResult = TestDataCreator.ToTestResult("TestSuite1.Test1", Model.TestOutcome.Passed, 3, tempFile);
+
+            var serializer = new TestDurationSerializer();
+            serializer.UpdateTestDurations(testResult.Yield());
+            serializer.UpdatePeakMemory(tempFile, 6000000000);
+            serializer.UpdatePeakMemory(tempFile, 5000000000);
+
+            serializer.ReadTestDurations(testResult.TestCase.Yield())[testResult.TestCase].Should().Be(3);
+            IDictionary<string, long> peakMemories = serializer.ReadPeakMemories(new[] { tempFile, TestResources.Tests_DebugX86 });
+            peakMemories.Should().ContainSingle();
+            peakMemories[tempFile].Should().Be(5000000000);
+
+            File.Delete(GetDurationsFile(serializer, tempFile));
+        }
+
 
         private string GetDurationsFile(TestDurationSerializer serializer, string executable)
         {
@@ -0,0 +1,63 @@
+﻿using System.Collections.Generic;
+using System.Linq;
+using FluentAssertions;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.Tests.Common;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    [TestClass]
+    public class TestPriorityPlannerTests : TestsBase
+    {
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetBatches_RecentlyFailedTests_AreRunFirstInBatchesOfTheirOwn()
+        {
+            TestCase a1 = TestDataCreator.ToTestCase("Suite.A1", "a.exe");
+            TestCase a2 = TestDataCreator.ToTestCase("Suite.A2", "a.exe");
+            TestCase b1 = TestDataCreator.ToTestCase("Suite.B1", "b.exe");
+            var durations = new Dictionary<TestCase, int> { { a1, 1000 }, { a2, 10 }, { b1, 100 } };
+
+            List<List<TestCase>> batches = new TestPriorityPlanner(durations, new[] { a2 }).GetBatches(new[] { a1, a2, b1 });
+
+            batches.Should().HaveCount(3);
+            batches[0].Should().Equal(a2);
+            batches[1].Should().Equal(a1);
+            batches[2].Should().Equal(b1);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetBatches_NoFailures_ExecutablesAreOrderedLongestFirst()
+        {
+            TestCase a1 = TestDataCreator.ToTestCase("Suite.A1", "a.exe");
+            TestCase a2 = TestDataCreator.ToTestCase("Suite.A2", "a.exe");
+            TestCase b1 = TestDataCreator.ToTestCase("Suite.B1", "b.exe");
+            TestCase b2 = TestDataCreator.ToTestCase("Suite.B2", "b.exe");
+            TestCase c1 = TestDataCreator.ToTestCase("Suite.C1", "c.exe");
+            var durations = new Dictionary<TestCase, int> { { a1, 5 }, { a2, 10 }, { b1, 100 }, { b2, 200 } };
+
+            List<List<TestCase>> batches = new TestPriorityPlanner(durations, null).GetBatches(new[] { a1, a2, b1, b2, c1 });
+
+            // c1 has no known duration, and neither has any test of its suite or executable, so it takes as long as the median test
+            batches.Select(b => b[0].Source).Should().Equal("b.exe", "c.exe", "a.exe");
+            batches[2].Should().Equal(a2, a1);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetBatches_NoDurationsKnown_OneBatchPerExecutable()
+        {
+            var testCases = TestDataCreator.CreateDummyTestCases("Suite.Test1", "Suite.Test2");
+
+            List<List<TestCase>> batches = new TestPriorityPlanner(null, null).GetBatches(testCases);
+
+            batches.Should().ContainSingle().Which.Should().HaveCount(2);
+        }
+
+    }
+
+}
@@ -0,0 +1,125 @@
+﻿using System.Collections.Generic;
+using System.Linq;
+using FluentAssertions;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.Tests.Common;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    [TestClass]
+    public class TestShardPlannerTests : TestsBase
+    {
+        private static readonly string[] AllTests = { "Suite.Test1", "Suite.Test2", "Suite.Test3", "Other.Test1" };
+
+        [TestInitialize]
+        public override void SetUp()
+        {
+            base.SetUp();
+            MockOptions.Setup(o => o.MaxNrOfThreads).Returns(4);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Constructor_ThresholdIsZero_NoExecutableIsSharded()
+        {
+            var testCases = TestDataCreator.CreateDummyTestCases(AllTests).ToList();
+
+            var planner = new TestShardPlanner(testCases, TestEnvironment.Options);
+
+            planner.ShardedExecutables.Should().BeEmpty();
+            planner.RemainingTestCases.Should().BeEquivalentTo(testCases);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Constructor_AllTestsSelected_ExecutableIsShardedOncePerThread()
+        {
+            MockOptions.Setup(o => o.NativeShardingThreshold).Returns(100);
+            var testCases = TestDataCreator.CreateDummyTestCases(AllTests).ToList();
+
+            var planner = new TestShardPlanner(testCases, TestEnvironment.Options);
+
+            planner.RemainingTestCases.Should().BeEmpty();
+            ShardedExecutable shardedExecutable = planner.ShardedExecutables.Should().ContainSingle().Subject;
+            shardedExecutable.NrOfShards.Should().Be(4);
+            shardedExecutable.TestCases.Should().BeEquivalentTo(testCases);
+            shardedExecutable.Shards.Select(s => s.ShardIndex).Should().Equal(0, 1, 2, 3);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Constructor_TestWithResourceConstraint_ExecutableIsNotSharded()
+        {
+            MockOptions.Setup(o => o.NativeShardingThreshold).Returns(100);
+            var testCases = TestDataCreator.CreateDummyTestCases(AllTests).ToList();
+            testCases[1].Traits.Add(new Trait(ResourceLockManager.ResourceTrait, "Database"));
+
+            var planner = new TestShardPlanner(testCases, TestEnvironment.Options);
+
+            planner.ShardedExecutables.Should().BeEmpty();
+            planner.RemainingTestCases.Should().BeEquivalentTo(testCases);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Constructor_MostTestsSelected_ExecutableIsShardedDependingOnThreshold()
+        {
+            var testCases = TestDataCreator.CreateDummyTestCasesFull(AllTests.Take(3).ToArray(), AllTests).ToList();
+
+            MockOptions.Setup(o => o.NativeShardingThreshold).Returns(80);
+            new TestShardPlanner(testCases, TestEnvironment.Options).ShardedExecutables.Should().BeEmpty();
+
+            MockOptions.Setup(o => o.NativeShardingThreshold).Returns(75);
+            new TestShardPlanner(testCases, TestEnvironment.Options).ShardedExecutables.Should().ContainSingle()
+                .Which.NrOfShards.Should().Be(3);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Constructor_SingleThread_NoExecutableIsSharded()
+        {
+            MockOptions.Setup(o => o.NativeShardingThreshold).Returns(100);
+            MockOptions.Setup(o => o.MaxNrOfThreads).Returns(1);
+            var testCases = TestDataCreator.CreateDummyTestCases(AllTests).ToList();
+
+            var planner = new TestShardPlanner(testCases, TestEnvironment.Options);
+
+            planner.ShardedExecutables.Should().BeEmpty();
+            planner.RemainingTestCases.Should().HaveCount(4);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void FinishShard_LastShard_ReturnsTestsWithoutResultAndCrashedTest()
+        {
+            var testCases = TestDataCreator.CreateDummyTestCases(AllTests).ToList();
+            var shardedExecutable = new ShardedExecutable(TestDataCreator.DummyExecutable, testCases, 2);
+
+            shardedExecutable.FinishShard(testCases.Take(1), testCases[1], out IList<TestCase> _, out TestCase _)
+                .Should().BeFalse();
+            shardedExecutable.FinishShard(testCases.Skip(2).Take(1), null, out IList<TestCase> testCasesWithoutResults, out TestCase crashedTestCase)
+                .Should().BeTrue();
+
+            testCasesWithoutResults.Should().BeEquivalentTo(testCases[1], testCases[3]);
+            crashedTestCase.Should().Be(testCases[1]);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void AddEnvironmentVariables_ShardVariablesAreSet()
+        {
+            var shardedExecutable = new ShardedExecutable(TestDataCreator.DummyExecutable, new List<TestCase>(), 3);
+            var environmentVariables = new Dictionary<string, string> { { "FOO", "bar" } };
+
+            shardedExecutable.Shards.Last().AddEnvironmentVariables(environmentVariables);
+
+            environmentVariables.Should().Contain("GTEST_TOTAL_SHARDS", "3");
+            environmentVariables.Should().Contain("GTEST_SHARD_INDEX", "2");
+            environmentVariables.Should().Contain("FOO", "bar");
+        }
+
+    }
+
+}
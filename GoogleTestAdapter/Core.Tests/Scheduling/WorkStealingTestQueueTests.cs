@@ -0,0 +1,164 @@
+﻿using System.Collections.Generic;
+using System.Linq;
+using System.Threading.Tasks;
+using FluentAssertions;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.Tests.Common;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    [TestClass]
+    public class WorkStealingTestQueueTests : TestsBase
+    {
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void TryTake_SingleThread_ChunksShrinkTowardsEnd()
+        {
+            var testCases = CreateTestCases("foo.exe", 100);
+            var queue = new WorkStealingTestQueue(testCases, 1);
+
+            var chunkSizes = new List<int>();
+            while (queue.TryTake(0, out List<TestCase> chunk))
+                chunkSizes.Add(chunk.Count);
+
+            chunkSizes.Sum().Should().Be(100);
+            chunkSizes.First().Should().Be(50);
+            chunkSizes.Last().Should().Be(1);
+            chunkSizes.Should().BeInDescendingOrder();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void TryTake_ChunksNeverMixExecutables()
+        {
+            var testCases = CreateTestCases("foo.exe", 7).Concat(CreateTestCases("bar.exe", 9)).ToList();
+            var queue = new WorkStealingTestQueue(testCases, 3);
+
+            var chunks = new List<List<TestCase>>();
+            for (int threadId = 0; queue.TryTake(threadId, out List<TestCase> chunk); threadId = (threadId + 1) % 3)
+                chunks.Add(chunk);
+
+            chunks.Should().OnlyContain(c => c.Select(tc => tc.Source).Distinct().Count() == 1);
+            chunks.SelectMany(c => c).Should().BeEquivalentTo(testCases);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void TryTake_OwnDequeIsEmpty_StealsFromBackOfOtherDeque()
+        {
+            var testCases = CreateTestCases("foo.exe", 8);
+            var queue = new WorkStealingTestQueue(testCases, 2);
+
+            // thread 1 drains its own deque (tests 4..7)
+            var ownTests = new List<TestCase>();
+            while (ownTests.Count < 4)
+            {
+                queue.TryTake(1, out List<TestCase> chunk).Should().BeTrue();
+                ownTests.AddRange(chunk);
+            }
+            ownTests.Select(tc => tc.DisplayName).Should().BeEquivalentTo("Suite.Test4", "Suite.Test5", "Suite.Test6", "Suite.Test7");
+
+            queue.TryTake(1, out List<TestCase> stolen).Should().BeTrue();
+            stolen.Should().ContainSingle().Which.DisplayName.Should().Be("Suite.Test3");
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void TryTake_Durations_LongTestIsTakenAlone()
+        {
+            var testCases = CreateTestCases("foo.exe", 10);
+            var durations = testCases.ToDictionary(tc => tc, tc => 10);
+            durations[testCases[0]] = 1000;
+            var queue = new WorkStealingTestQueue(testCases, 2, durations);
+
+            queue.TryTake(0, out List<TestCase> chunk).Should().BeTrue();
+
+            chunk.Should().ContainSingle().Which.Should().Be(testCases[0]);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void TryTake_ConcurrentThreads_EachTestIsTakenExactlyOnce()
+        {
+            var testCases = CreateTestCases("foo.exe", 500).Concat(CreateTestCases("bar.exe", 300)).ToList();
+            var queue = new WorkStealingTestQueue(testCases, 8);
+
+            var takenTests = new List<TestCase>[8];
+            Parallel.For(0, 8, threadId =>
+            {
+                takenTests[threadId] = new List<TestCase>();
+                while (queue.TryTake(threadId, out List<TestCase> chunk))
+                    takenTests[threadId].AddRange(chunk);
+            });
+
+            takenTests.SelectMany(t => t).Should().BeEquivalentTo(testCases);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void TryTake_Canceled_ReturnsFalse()
+        {
+            var queue = new WorkStealingTestQueue(CreateTestCases("foo.exe", 10), 2);
+
+            queue.Cancel();
+
+            queue.TryTake(0, out List<TestCase> _).Should().BeFalse();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void Constructor_LessTestsThanThreads_NrOfThreadsIsReduced()
+        {
+            var queue = new WorkStealingTestQueue(CreateTestCases("foo.exe", 3), 8);
+
+            queue.NrOfThreads.Should().Be(3);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void TryTake_TestsAreAddedWhileTaking_EachTestIsTakenExactlyOnce()
+        {
+            var testCases = CreateTestCases("foo.exe", 200).Concat(CreateTestCases("bar.exe", 100)).ToList();
+            var queue = new WorkStealingTestQueue(4);
+
+            var takenTests = new List<TestCase>[4];
+            Task consumers = Task.Run(() => Parallel.For(0, 4, threadId =>
+            {
+                takenTests[threadId] = new List<TestCase>();
+                while (queue.TryTake(threadId, out List<TestCase> chunk))
+                    takenTests[threadId].AddRange(chunk);
+            }));
+            queue.Add(testCases.Take(200));
+            queue.Add(testCases.Skip(200));
+            queue.CompleteAdding();
+
+            consumers.Wait(10000).Should().BeTrue();
+            takenTests.SelectMany(t => t).Should().BeEquivalentTo(testCases);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void TryTake_AddingNotCompleted_WaitsForTests()
+        {
+            var queue = new WorkStealingTestQueue(2);
+
+            Task<bool> take = Task.Run(() => queue.TryTake(0, out List<TestCase> _));
+
+            take.Wait(200).Should().BeFalse();
+            queue.CompleteAdding();
+            take.Wait(10000).Should().BeTrue();
+            take.Result.Should().BeFalse();
+        }
+
+        private List<TestCase> CreateTestCases(string executable, int nrOfTests)
+        {
+            return Enumerable.Range(0, nrOfTests)
+                .Select(i => TestDataCreator.ToTestCase($"Suite.Test{i}", executable))
+                .ToList();
+        }
+
+    }
+
+}
@@ -4,6 +4,7 @@ using System.Linq;
 using System.Reflection;
 using FluentAssertions;
 using GoogleTestAdapter.Common;
+using GoogleTestAdapter.Scheduling;
 using GoogleTestAdapter.Tests.Common;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
 using Moq;
@@ -58,7 +59,10 @@ namespace GoogleTestAdapter.Settings
             new PlaceholderAndValue(PlaceholderReplacer.ExecutableDirPlaceholder, Path.GetFullPath(Path.GetDirectoryName(TestResources.Tests_DebugX86))),
             new PlaceholderAndValue(PlaceholderReplacer.ExecutablePlaceholder, TestResources.Tests_DebugX86),
             new PlaceholderAndValue(PlaceholderReplacer.TestDirPlaceholder, "testDirectory"),
-            new PlaceholderAndValue(PlaceholderReplacer.ThreadIdPlaceholder, 42)
+            new PlaceholderAndValue(PlaceholderReplacer.ThreadIdPlaceholder, 42),
+            new PlaceholderAndValue(PlaceholderReplacer.CpuSetPlaceholder, "0-3,8"),
+            new PlaceholderAndValue(PlaceholderReplacer.CpuCountPlaceholder, 5),
+            new PlaceholderAndValue(PlaceholderReplacer.NumaNodesPlaceholder, "0-1")
         };
 
         private static readonly List<MethodnameAndPlaceholder> UnsupportedCombinations = new List<MethodnameAndPlaceholder>
@@ -73,6 +77,21 @@ namespace GoogleTestAdapter.Settings
             new MethodnameAndPlaceholder(nameof(PlaceholderReplacer.ReplacePathExtensionPlaceholders), PlaceholderReplacer.ThreadIdPlaceholder),
             new MethodnameAndPlaceholder(nameof(PlaceholderReplacer.ReplaceWorkingDirPlaceholdersForDiscovery), PlaceholderReplacer.ThreadIdPlaceholder),
 
+            new MethodnameAndPlaceholder(nameof(PlaceholderReplacer.ReplaceAdditionalPdbsPlaceholders), PlaceholderReplacer.CpuSetPlaceholder),
+            new MethodnameAndPlaceholder(nameof(PlaceholderReplacer.ReplaceAdditionalTestExecutionParamPlaceholdersForDiscovery), PlaceholderReplacer.CpuSetPlaceholder),
+            new MethodnameAndPlaceholder(nameof(PlaceholderReplacer.ReplacePathExtensionPlaceholders), PlaceholderReplacer.CpuSetPlaceholder),
+            new MethodnameAndPlaceholder(nameof(PlaceholderReplacer.ReplaceWorkingDirPlaceholdersForDiscovery), PlaceholderReplacer.CpuSetPlaceholder),
+
+            new MethodnameAndPlaceholder(nameof(PlaceholderReplacer.ReplaceAdditionalPdbsPlaceholders), PlaceholderReplacer.CpuCountPlaceholder),
+            new MethodnameAndPlaceholder(nameof(PlaceholderReplacer.ReplaceAdditionalTestExecutionParamPlaceholdersForDiscovery), PlaceholderReplacer.CpuCountPlaceholder),
+            new MethodnameAndPlaceholder(nameof(PlaceholderReplacer.ReplacePathExtensionPlaceholders), PlaceholderReplacer.CpuCountPlaceholder),
+            new MethodnameAndPlaceholder(nameof(PlaceholderReplacer.ReplaceWorkingDirPlaceholdersForDiscovery), PlaceholderReplacer.CpuCountPlaceholder),
+
+            new MethodnameAndPlaceholder(nameof(PlaceholderReplacer.ReplaceAdditionalPdbsPlaceholders), PlaceholderReplacer.NumaNodesPlaceholder),
+            new MethodnameAndPlaceholder(nameof(PlaceholderReplacer.ReplaceAdditionalTestExecutionParamPlaceholdersForDiscovery), PlaceholderReplacer.NumaNodesPlaceholder),
+            new MethodnameAndPlaceholder(nameof(PlaceholderReplacer.ReplacePathExtensionPlaceholders), PlaceholderReplacer.NumaNodesPlaceholder),
+            new MethodnameAndPlaceholder(nameof(PlaceholderReplacer.ReplaceWorkingDirPlaceholdersForDiscovery), PlaceholderReplacer.NumaNodesPlaceholder),
+
             new MethodnameAndPlaceholder(nameof(PlaceholderReplacer.ReplaceSetupBatchPlaceholders), PlaceholderReplacer.ExecutablePlaceholder),
             new MethodnameAndPlaceholder(nameof(PlaceholderReplacer.ReplaceSetupBatchPlaceholders), PlaceholderReplacer.ExecutableDirPlaceholder),
             new MethodnameAndPlaceholder(nameof(PlaceholderReplacer.ReplaceSetupBatchPlaceholders), PlaceholderReplacer.ConfigurationNamePlaceholder),
@@ -163,6 +182,7 @@ namespace GoogleTestAdapter.Settings
             {
                 case "executable": return TestResources.Tests_DebugX86;
                 case "threadId": return 42;
+                case "cpuSet": return new CpuSet(new[] { 8, 0, 1, 2, 3 }, new[] { 0, 1 });
                 default: return parameter.Name;
             }
         }
@@ -0,0 +1,83 @@
+﻿using System.Collections.Generic;
+using FluentAssertions;
+using GoogleTestAdapter.Common;
+using GoogleTestAdapter.DiaResolver;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.Tests.Common;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using Moq;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.TestCases
+{
+
+    [TestClass]
+    public class TestImpactAnalyzerTests : TestsBase
+    {
+        private const string TestFile = @"C:\prj\SampleTests\Tests\BasicTests.cpp";
+        private const string OtherTestFile = @"C:\prj\SampleTests\Tests\FixtureTests.cpp";
+        private const string ProductionFile = @"C:\prj\SampleTests\LibProject\Lib.cpp";
+        private const string ProductionHeader = @"C:\prj\SampleTests\LibProject\Lib.h";
+
+        private TestCase[] _testCases;
+        private TestImpactAnalyzer _analyzer;
+
+        [TestInitialize]
+        public override void SetUp()
+        {
+            base.SetUp();
+
+            _testCases = new[]
+            {
+                TestDataCreator.ToTestCase("BasicTests.Foo", TestResources.Tests_DebugX86, TestFile),
+                TestDataCreator.ToTestCase("BasicTests.Bar", TestResources.Tests_DebugX86, TestFile),
+                TestDataCreator.ToTestCase("FixtureTests.Baz", TestResources.Tests_DebugX86, OtherTestFile)
+            };
+
+            var mockResolver = new Mock<IDiaResolver>();
+            mockResolver.Setup(r => r.GetSourceFiles()).Returns(new List<string> { TestFile, OtherTestFile, ProductionFile, ProductionHeader });
+            var mockFactory = new Mock<IDiaResolverFactory>();
+            mockFactory.Setup(f => f.Create(It.IsAny<string>(), It.IsAny<string>(), It.IsAny<ILogger>())).Returns(mockResolver.Object);
+
+            _analyzer = new TestImpactAnalyzer(mockFactory.Object, TestEnvironment.Options, TestEnvironment.Logger);
+        }
+
+        [TestMethod]
+        [TestCategory(Integration)]
+        public void SelectAffectedTests_UnrelatedSourceFileChanged_NoTestsAreSelected()
+        {
+            IList<TestCase> affectedTests = _analyzer.SelectAffectedTests(_testCases, new[] { "OtherProject/Other.cpp", "README.md" });
+
+            affectedTests.Should().BeEmpty();
+        }
+
+        [TestMethod]
+        [TestCategory(Integration)]
+        public void SelectAffectedTests_ProductionFileChanged_AllTestsOfExecutableAreSelected()
+        {
+            IList<TestCase> affectedTests = _analyzer.SelectAffectedTests(_testCases, new[] { "SampleTests/LibProject/Lib.cpp" });
+
+            affectedTests.Should().BeEquivalentTo(_testCases);
+        }
+
+        [TestMethod]
+        [TestCategory(Integration)]
+        public void SelectAffectedTests_TestFileChanged_OnlyTestsOfFileAreSelected()
+        {
+            IList<TestCase> affectedTests = _analyzer.SelectAffectedTests(_testCases, new[] { "SampleTests/Tests/basictests.cpp" });
+
+            affectedTests.Should().BeEquivalentTo(_testCases[0], _testCases[1]);
+        }
+
+        [TestMethod]
+        [TestCategory(Integration)]
+        public void SelectAffectedTests_UnknownHeaderChanged_AllTestsAreSelected()
+        {
+            IList<TestCase> affectedTests = _analyzer.SelectAffectedTests(_testCases, new[] { "OtherProject/Declarations.h" });
+
+            affectedTests.Should().BeEquivalentTo(_testCases);
+        }
+
+    }
+
+}
@@ -0,0 +1,242 @@
+﻿using System;
+using System.IO;
+using System.Linq;
+using System.Text;
+using FluentAssertions;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.Tests.Common;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.TestResults
+{
+    [TestClass]
+    public class EventStreamTestResultParserTests : TestsBase
+    {
+        private string _eventStreamFile;
+
+        [TestInitialize]
+        public override void SetUp()
+        {
+            base.SetUp();
+            _eventStreamFile = Path.GetTempFileName();
+        }
+
+        [TestCleanup]
+        public override void TearDown()
+        {
+            File.Delete(_eventStreamFile);
+            base.TearDown();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetTestResults_FileDoesNotExist_EmptyResult()
+        {
+            var testCases = TestDataCreator.CreateDummyTestCases("Suite.Test");
+
+            var results = new EventStreamTestResultParser(testCases, _eventStreamFile + ".doesnotexist", TestEnvironment.Logger).GetTestResults();
+
+            results.Should().BeEmpty();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetTestResults_PassedAndSkippedTests_ResultsWithMicrosecondDurations()
+        {
+            var testCases = TestDataCreator.CreateDummyTestCases("Suite.Passed", "Suite.Skipped");
+            new EventStreamWriter()
+                .TestStart("Suite.Passed").TestEnd("Suite.Passed", 0, 1500)
+                .TestStart("Suite.Skipped").TestEnd("Suite.Skipped", 2, 10)
+                .WriteTo(_eventStreamFile);
+
+            var results = new EventStreamTestResultParser(testCases, _eventStreamFile, TestEnvironment.Logger).GetTestResults();
+
+            results.Should().HaveCount(2);
+            results[0].Outcome.Should().Be(TestOutcome.Passed);
+            results[0].Duration.Should().Be(TimeSpan.FromTicks(15000));
+            results[1].Outcome.Should().Be(TestOutcome.Skipped);
+            results[1].Duration.Should().Be(StreamingStandardOutputTestResultParser.ShortTestDuration);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetTestResults_FailedTest_ErrorMessageAndStackTraceFromFailures()
+        {
+            var testCases = TestDataCreator.CreateDummyTestCases("Suite.Failed");
+            new EventStreamWriter()
+                .TestStart("Suite.Failed")
+                .TestFailure(@"c:\tests\test.cpp", 17, "Value of: 1\nExpected: 2")
+                .TestFailure(@"c:\tests\test.cpp", 23, "Failed")
+                .TestEnd("Suite.Failed", 1, 5000)
+                .WriteTo(_eventStreamFile);
+
+            var results = new EventStreamTestResultParser(testCases, _eventStreamFile, TestEnvironment.Logger).GetTestResults();
+
+            results.Should().ContainSingle();
+            results[0].Outcome.Should().Be(TestOutcome.Failed);
+            results[0].ErrorMessage.Should().Be("#1 - Value of: 1\nExpected: 2\n#2 - Failed");
+            results[0].ErrorStackTrace.Should().Contain(@"at #1 - test.cpp:17 in c:\tests\test.cpp:line 17");
+            results[0].ErrorStackTrace.Should().Contain(@"at #2 - test.cpp:23 in c:\tests\test.cpp:line 23");
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetTestResults_StreamEndsWithinTest_TestIsReportedAsCrashed()
+        {
+            var testCases = TestDataCreator.CreateDummyTestCases("Suite.Passed", "Suite.Crashing", "Suite.NotRun");
+            new EventStreamWriter()
+                .TestStart("Suite.Passed").TestEnd("Suite.Passed", 0, 1000)
+                .TestStart("Suite.Crashing")
+                .WriteTo(_eventStreamFile);
+
+            var parser = new EventStreamTestResultParser(testCases, _eventStreamFile, TestEnvironment.Logger);
+            var results = parser.GetTestResults();
+
+            results.Should().HaveCount(2);
+            results[1].TestCase.FullyQualifiedName.Should().Be("Suite.Crashing");
+            results[1].Outcome.Should().Be(TestOutcome.Failed);
+            results[1].ErrorMessage.Should().StartWith(StreamingStandardOutputTestResultParser.CrashText);
+            parser.CrashedTestCase.FullyQualifiedName.Should().Be("Suite.Crashing");
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetTestResults_IncompleteRecordAndUnknownRecordType_ValidRecordsAreParsed()
+        {
+            var testCases = TestDataCreator.CreateDummyTestCases("Suite.Passed", "Suite.Crashing");
+            new EventStreamWriter()
+                .Record(42, new byte[] { 1, 2, 3 })
+                .TestStart("Suite.Passed").TestEnd("Suite.Passed", 0, 1000)
+                .TestStart("Suite.Crashing").TestEnd("Suite.Crashing", 0, 1000)
+                .WriteTo(_eventStreamFile, nrOfBytesToCutOff: 3);
+
+            var results = new EventStreamTestResultParser(testCases, _eventStreamFile, TestEnvironment.Logger).GetTestResults();
+
+            results.Select(tr => $"{tr.TestCase.FullyQualifiedName}:{tr.Outcome}").Should().BeEquivalentTo(
+                "Suite.Passed:Passed", "Suite.Crashing:Failed");
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void ReadNewTestResults_StreamGrowsWhileReading_EachResultIsReturnedOnceAndIncompleteRecordIsReadLater()
+        {
+            var testCases = TestDataCreator.CreateDummyTestCases("Suite.First", "Suite.Second", "Suite.Crashing");
+            var writer = new EventStreamWriter()
+                .TestStart("Suite.First").TestEnd("Suite.First", 0, 1000)
+                .TestStart("Suite.Second").TestEnd("Suite.Second", 1, 1000);
+            writer.WriteTo(_eventStreamFile, nrOfBytesToCutOff: 3);
+            var parser = new EventStreamTestResultParser(testCases, _eventStreamFile, TestEnvironment.Logger);
+
+            var firstResults = parser.ReadNewTestResults();
+            writer.TestStart("Suite.Crashing").WriteTo(_eventStreamFile);
+            var secondResults = parser.ReadNewTestResults();
+            var remainingResults = parser.GetTestResults();
+
+            firstResults.Select(tr => tr.TestCase.FullyQualifiedName).Should().BeEquivalentTo("Suite.First");
+            secondResults.Select(tr => $"{tr.TestCase.FullyQualifiedName}:{tr.Outcome}").Should().BeEquivalentTo("Suite.Second:Failed");
+            remainingResults.Select(tr => tr.TestCase.FullyQualifiedName).Should().BeEquivalentTo("Suite.Crashing");
+            parser.CrashedTestCase.FullyQualifiedName.Should().Be("Suite.Crashing");
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetTestResults_ResourceUsageRecord_ResourceUsageIsAttachedToResult()
+        {
+            var testCases = TestDataCreator.CreateDummyTestCases("Suite.Measured", "Suite.NotMeasured");
+            new EventStreamWriter()
+                .TestStart("Suite.Measured")
+                .TestResourceUsage("Suite.Measured", 2000, 1000, 8 * 1024 * 1024, 42, 512, 1024)
+                .TestEnd("Suite.Measured", 0, 5000)
+                .TestStart("Suite.NotMeasured").TestEnd("Suite.NotMeasured", 0, 5000)
+                .WriteTo(_eventStreamFile);
+
+            var results = new EventStreamTestResultParser(testCases, _eventStreamFile, TestEnvironment.Logger).GetTestResults();
+
+            results.Should().HaveCount(2);
+            ResourceUsage resourceUsage = results[0].ResourceUsage;
+            resourceUsage.UserTime.Should().Be(TimeSpan.FromMilliseconds(2));
+            resourceUsage.KernelTime.Should().Be(TimeSpan.FromMilliseconds(1));
+            resourceUsage.PeakMemoryInBytes.Should().Be(8 * 1024 * 1024);
+            resourceUsage.PageFaults.Should().Be(42);
+            resourceUsage.ReadBytes.Should().Be(512);
+            resourceUsage.WriteBytes.Should().Be(1024);
+            results[1].ResourceUsage.Should().BeNull();
+        }
+
+        private class EventStreamWriter
+        {
+            private readonly MemoryStream _stream = new MemoryStream();
+
+            internal EventStreamWriter TestStart(string testName)
+            {
+                return Record(1, Payload(w => WriteString(w, testName)));
+            }
+
+            internal EventStreamWriter TestFailure(string file, int line, string message)
+            {
+                return Record(2, Payload(w =>
+                {
+                    WriteString(w, file);
+                    w.Write(line);
+                    WriteString(w, message);
+                }));
+            }
+
+            internal EventStreamWriter TestEnd(string testName, byte outcome, long durationInUs)
+            {
+                return Record(3, Payload(w =>
+                {
+                    WriteString(w, testName);
+                    w.Write(outcome);
+                    w.Write(durationInUs);
+                }));
+            }
+
+            internal EventStreamWriter TestResourceUsage(string testName, long userTimeInUs, long kernelTimeInUs, long peakMemoryInBytes, long pageFaults, long readBytes, long writeBytes)
+            {
+                return Record(4, Payload(w =>
+                {
+                    WriteString(w, testName);
+                    w.Write(userTimeInUs);
+                    w.Write(kernelTimeInUs);
+                    w.Write(peakMemoryInBytes);
+                    w.Write(pageFaults);
+                    w.Write(readBytes);
+                    w.Write(writeBytes);
+                }));
+            }
+
+            internal EventStreamWriter Record(byte recordType, byte[] payload)
+            {
+                var writer = new BinaryWriter(_stream);
+                writer.Write(payload.Length);
+                writer.Write(recordType);
+                writer.Write(payload);
+                return this;
+            }
+
+            internal void WriteTo(string file, int nrOfBytesToCutOff = 0)
+            {
+                byte[] bytes = _stream.ToArray();
+                File.WriteAllBytes(file, bytes.Take(bytes.Length - nrOfBytesToCutOff).ToArray());
+            }
+
+            private static byte[] Payload(Action<BinaryWriter> write)
+            {
+                var stream = new MemoryStream();
+                write(new BinaryWriter(stream));
+                return stream.ToArray();
+            }
+
+            private static void WriteString(BinaryWriter writer, string value)
+            {
+                byte[] bytes = Encoding.UTF8.GetBytes(value);
+                writer.Write(bytes.Length);
+                writer.Write(bytes);
+            }
+        }
+
+    }
+
+}
@@ -0,0 +1,107 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading;
+using GoogleTestAdapter.Common;
+using GoogleTestAdapter.Model;
+
+namespace GoogleTestAdapter.Framework
+{
+    /// <summary>
+    /// Forwards everything to the given reporter on a dedicated thread, such that callers (i.e., test threads) do
+    /// not have to wait for the reporter (which might e.g. throttle reporting). Reports are queued in a bounded
+    /// channel; callers only block if the channel is full. Further actions (e.g. storing test durations) can be
+    /// executed on the reporting thread with Post(). Complete() has to be called once all reports have been made.
+    /// </summary>
+    public class AsyncTestFrameworkReporter : ITestFrameworkReporter
+    {
+        public const int DefaultCapacity = 1000;
+
+        private readonly ITestFrameworkReporter _innerReporter;
+        private readonly ILogger _logger;
+        private readonly BlockingCollection<Action> _channel;
+        private readonly Thread _reportingThread;
+
+        private volatile TestRunCanceledException _cancelException;
+
+        public AsyncTestFrameworkReporter(ITestFrameworkReporter innerReporter, ILogger logger, int capacity = DefaultCapacity)
+        {
+            _innerReporter = innerReporter;
+            _logger = logger;
+            _channel = new BlockingCollection<Action>(capacity);
+            _reportingThread = new Thread(ReportQueuedActions) { Name = "GTA Result Reporter", IsBackground = true };
+            _reportingThread.Start();
+        }
+
+        public void ReportTestsFound(IEnumerable<TestCase> testCases)
+        {
+            List<TestCase> testCasesAsList = testCases.ToList();
+            Post(() => _innerReporter.ReportTestsFound(testCasesAsList));
+        }
+
+        public void ReportTestsStarted(IEnumerable<TestCase> testCases)
+        {
+            List<TestCase> testCasesAsList = testCases.ToList();
+            Post(() => _innerReporter.ReportTestsStarted(testCasesAsList));
+        }
+
+        /// <exception cref="TestRunCanceledException">if a previous report has revealed that test execution has been canceled</exception>
+        public void ReportTestResults(IEnumerable<TestResult> testResults)
+        {
+            if (_cancelException != null)
+                throw new TestRunCanceledException(_cancelException.Message, _cancelException.InnerException);
+
+            List<TestResult> testResultsAsList = testResults.ToList();
+            Post(() => _innerReporter.ReportTestResults(testResultsAsList));
+        }
+
+        /// <summary>
+        /// Executes the given action on the reporting thread, after all reports made before. Blocks if the channel is full.
+        /// </summary>
+        public void Post(Action action)
+        {
+            try
+            {
+                _channel.Add(action);
+            }
+            catch (InvalidOperationException)
+            {
+                // channel has been completed, i.e., reporting is over - execute synchronously
+                action();
+            }
+        }
+
+        /// <summary>
+        /// Waits until all queued actions have been executed and stops the reporting thread.
+        /// </summary>
+        public void Complete()
+        {
+            _channel.CompleteAdding();
+            _reportingThread.Join();
+        }
+
+        private void ReportQueuedActions()
+        {
+            foreach (Action action in _channel.GetConsumingEnumerable())
+            {
+                try
+                {
+                    action();
+                }
+                catch (TestRunCanceledException e)
+                {
+                    if (_cancelException == null)
+                        _logger.DebugInfo($"Reporting has been canceled: {e.InnerException?.Message ?? e.Message}");
+                    _cancelException = e;
+                }
+                catch (Exception e)
+                {
+                    _logger.LogError($"Exception while reporting test results: {e}");
+                }
+            }
+        }
+
+    }
+
+}
@@ -0,0 +1,89 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using GoogleTestAdapter.Model;
+
+namespace GoogleTestAdapter.Framework
+{
+    /// <summary>
+    /// Forwards everything to the given reporter and invokes the given action (which is supposed to cancel
+    /// test execution) as soon as the first failed test result has been reported. Keeps track of the tests
+    /// which have received results such that the remaining tests can be reported as not run.
+    /// </summary>
+    public class FailFastTestFrameworkReporter : ITestFrameworkReporter
+    {
+        private readonly ITestFrameworkReporter _innerReporter;
+        private readonly Action<TestResult> _onFirstFailure;
+
+        private readonly ISet<TestCase> _testCasesWithResults = new HashSet<TestCase>();
+        private readonly object _lock = new object();
+
+        public FailFastTestFrameworkReporter(ITestFrameworkReporter innerReporter, Action<TestResult> onFirstFailure)
+        {
+            _innerReporter = innerReporter;
+            _onFirstFailure = onFirstFailure;
+        }
+
+        public bool HasFailed { get; private set; }
+
+        public void ReportTestsFound(IEnumerable<TestCase> testCases)
+        {
+            _innerReporter.ReportTestsFound(testCases);
+        }
+
+        public void ReportTestsStarted(IEnumerable<TestCase> testCases)
+        {
+            _innerReporter.ReportTestsStarted(testCases);
+        }
+
+        public void ReportTestResults(IEnumerable<TestResult> testResults)
+        {
+            TestResult[] testResultsAsArray = testResults as TestResult[] ?? testResults.ToArray();
+
+            TestResult firstFailure = null;
+            lock (_lock)
+            {
+                foreach (TestResult testResult in testResultsAsArray)
+                {
+                    _testCasesWithResults.Add(testResult.TestCase);
+                }
+
+                if (!HasFailed)
+                {
+                    firstFailure = testResultsAsArray.FirstOrDefault(tr => tr.Outcome == TestOutcome.Failed);
+                    HasFailed = firstFailure != null;
+                }
+            }
+
+            _innerReporter.ReportTestResults(testResultsAsArray);
+
+            if (firstFailure != null)
+                _onFirstFailure(firstFailure);
+        }
+
+        /// <summary>
+        /// Reports results with outcome None for those of the given tests which have not received a result yet.
+        /// </summary>
+        public void ReportTestsNotRun(IEnumerable<TestCase> testCases, string reason)
+        {
+            List<TestCase> testCasesNotRun;
+            lock (_lock)
+            {
+                testCasesNotRun = testCases
+                    .Where(tc => !tc.IsExitCodeTestCase && !_testCasesWithResults.Contains(tc))
+                    .ToList();
+            }
+            if (testCasesNotRun.Count == 0)
+                return;
+
+            ReportTestResults(testCasesNotRun.Select(tc => new TestResult(tc)
+            {
+                ComputerName = Environment.MachineName,
+                Outcome = TestOutcome.None,
+                ErrorMessage = reason
+            }).ToArray());
+        }
+
+    }
+
+}
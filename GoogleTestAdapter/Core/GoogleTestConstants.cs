@@ -25,6 +25,8 @@ namespace GoogleTestAdapter
 
         public const string ListTestsOption = "--gtest_list_tests";
         public const string FilterOption = " --gtest_filter=";
+        public const string FlagFileOption = " --gtest_flagfile";
+        public const string FlagFileMarker = "gtest_flagfile";
 
         public const string TestBodySignature = "::TestBody";
         public const string ParameterizedTestMarker = "  # GetParam() = ";
@@ -45,6 +47,11 @@ namespace GoogleTestAdapter
             return "--gtest_output=\"xml:" + resultXmlFile + "\"";
         }
 
+        public static string GetFlagFileOption(string flagFile)
+        {
+            return FlagFileOption + "=\"" + flagFile + "\"";
+        }
+
         public static string GetCatchExceptionsOption(bool catchThem)
         {
             int optionValue = catchThem ? 1 : 0;
@@ -1,12 +1,17 @@
-﻿using System.Linq;
+﻿using System;
+using System.Linq;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using GoogleTestAdapter.Common;
+using GoogleTestAdapter.DiaResolver;
 using GoogleTestAdapter.Model;
 using GoogleTestAdapter.Runners;
 using GoogleTestAdapter.Framework;
+using GoogleTestAdapter.Helpers;
 using GoogleTestAdapter.ProcessExecution.Contracts;
 using GoogleTestAdapter.Scheduling;
 using GoogleTestAdapter.Settings;
+using GoogleTestAdapter.TestCases;
 using GoogleTestAdapter.TestResults;
 
 namespace GoogleTestAdapter
@@ -20,40 +25,147 @@ namespace GoogleTestAdapter
         private readonly IDebuggedProcessExecutorFactory _processExecutorFactory;
         private readonly IExitCodeTestsReporter _exitCodeTestsReporter;
         private readonly SchedulingAnalyzer _schedulingAnalyzer;
+        private readonly IDiaResolverFactory _diaResolverFactory;
 
         private ITestRunner _runner;
         private bool _canceled;
 
-        public GoogleTestExecutor(ILogger logger, SettingsWrapper settings, IDebuggedProcessExecutorFactory processExecutorFactory, IExitCodeTestsReporter exitCodeTestsReporter)
+        public GoogleTestExecutor(ILogger logger, SettingsWrapper settings, IDebuggedProcessExecutorFactory processExecutorFactory, IExitCodeTestsReporter exitCodeTestsReporter, IDiaResolverFactory diaResolverFactory = null)
         {
             _logger = logger;
             _settings = settings;
             _processExecutorFactory = processExecutorFactory;
             _exitCodeTestsReporter = exitCodeTestsReporter;
             _schedulingAnalyzer = new SchedulingAnalyzer(logger);
+            _diaResolverFactory = diaResolverFactory ?? DefaultDiaResolverFactory.Instance;
         }
 
 
         public void RunTests(IEnumerable<TestCase> testCasesToRun, ITestFrameworkReporter reporter, bool isBeingDebugged)
+        {
+            RunTests(testCasesToRun, null, reporter, isBeingDebugged);
+        }
+
+        /// <param name="allTestCases">All (discovered) tests of the executables containing the tests to run. If provided, 
+        /// short test filters (e.g. making use of wildcards) are computed from them. May be null.</param>
+        public void RunTests(IEnumerable<TestCase> testCasesToRun, IEnumerable<TestCase> allTestCases, ITestFrameworkReporter reporter, bool isBeingDebugged)
         {
             TestCase[] testCasesToRunAsArray = testCasesToRun as TestCase[] ?? testCasesToRun.ToArray();
+            if (!string.IsNullOrWhiteSpace(_settings.ChangedFilesList) && !isBeingDebugged)
+                testCasesToRunAsArray = SelectAffectedTests(testCasesToRunAsArray);
             _logger.LogInfo("Running " + testCasesToRunAsArray.Length + " tests...");
 
+            reporter = DecorateReporter(reporter, out FailFastTestFrameworkReporter failFastReporter, out AsyncTestFrameworkReporter asyncReporter);
+
+            bool canceled;
+            lock (this)
+            {
+                canceled = _canceled;
+                if (!canceled)
+                    ComputeTestRunner(reporter, isBeingDebugged, allTestCases?.GroupByExecutable());
+            }
+            if (canceled)
+            {
+                asyncReporter?.Complete();
+                return;
+            }
+
+            try
+            {
+                _runner.RunTests(testCasesToRunAsArray, isBeingDebugged, _processExecutorFactory);
+            }
+            finally
+            {
+                asyncReporter?.Complete();
+            }
+
+            FinishTestRun(testCasesToRunAsArray, failFastReporter, isBeingDebugged);
+        }
+
+        /// <summary>
+        /// Discovers and runs the tests of the given executables. If possible, the tests of an executable are executed as soon as its
+        /// discovery has completed, while other executables are still being discovered.
+        /// </summary>
+        /// <param name="discoverTestCases">Returns all tests of an executable; invoked concurrently for different executables.</param>
+        /// <param name="selectTestCasesToRun">Selects the tests to be run from all tests of an executable.</param>
+        public void RunTests(IEnumerable<string> executables, Func<string, IList<TestCase>> discoverTestCases,
+            Func<IList<TestCase>, IList<TestCase>> selectTestCasesToRun, ITestFrameworkReporter reporter, bool isBeingDebugged)
+        {
+            string[] executablesAsArray = executables.OrderBy(e => e).ToArray();
+            if (!CanRunTestsWhileDiscovering(isBeingDebugged))
+            {
+                var allTestCases = new List<TestCase>();
+                var selectedTestCases = new List<TestCase>();
+                Utils.SpawnAndWait(executablesAsArray
+                    .Select(executable => (Action)(() =>
+                    {
+                        IList<TestCase> testCases = discoverTestCases(executable);
+                        IList<TestCase> testCasesToRun = selectTestCasesToRun(testCases);
+                        lock (allTestCases)
+                        {
+                            allTestCases.AddRange(testCases);
+                            selectedTestCases.AddRange(testCasesToRun);
+                        }
+                    }))
+                    .ToArray());
+
+                if (selectedTestCases.Count > 0 && !_canceled)
+                    RunTests(selectedTestCases, _settings.SynthesizeTestFilters ? allTestCases : null, reporter, isBeingDebugged);
+                return;
+            }
+
+            _logger.LogInfo($"Running tests of {executablesAsArray.Length} executables while discovering them...");
+
+            reporter = DecorateReporter(reporter, out FailFastTestFrameworkReporter failFastReporter, out AsyncTestFrameworkReporter asyncReporter);
+
+            var allTestCasesOfExecutables = _settings.SynthesizeTestFilters ? new ConcurrentDictionary<string, List<TestCase>>() : null;
+            var allTestCasesToRun = new List<TestCase>();
+            ParallelTestRunner runner = null;
             lock (this)
             {
-                if (_canceled)
+                if (!_canceled)
                 {
-                    return;
+                    runner = new ParallelTestRunner(reporter, _logger, _settings, _schedulingAnalyzer, allTestCasesOfExecutables);
+                    _runner = runner;
                 }
-                ComputeTestRunner(reporter, isBeingDebugged);
+            }
+            if (runner == null)
+            {
+                asyncReporter?.Complete();
+                return;
             }
 
-            _runner.RunTests(testCasesToRunAsArray, isBeingDebugged, _processExecutorFactory);
+            try
+            {
+                runner.RunTests(addTestCases => Utils.SpawnAndWait(executablesAsArray
+                    .Select(executable => (Action)(() =>
+                    {
+                        if (_canceled)
+                            return;
 
-            _exitCodeTestsReporter.ReportExitCodeTestCases(_runner.ExecutableResults, isBeingDebugged);
+                        IList<TestCase> testCases = discoverTestCases(executable);
+                        IList<TestCase> testCasesToRun = selectTestCasesToRun(testCases);
+                        if (testCasesToRun.Count == 0 || _canceled)
+                            return;
 
-            if (_settings.ParallelTestExecution)
-                _schedulingAnalyzer.PrintStatisticsToDebugOutput();
+                        allTestCasesOfExecutables?.TryAdd(executable, testCases.ToList());
+                        lock (allTestCasesToRun)
+                        {
+                            allTestCasesToRun.AddRange(testCasesToRun);
+                        }
+                        _logger.DebugInfo($"Discovered {testCasesToRun.Count} tests to be run in executable {executable}");
+                        addTestCases(testCasesToRun);
+                    }))
+                    .ToArray()),
+                    _settings.MaxNrOfThreads, isBeingDebugged, _processExecutorFactory);
+            }
+            finally
+            {
+                asyncReporter?.Complete();
+            }
+
+            _logger.LogInfo("Ran " + allTestCasesToRun.Count + " tests");
+            FinishTestRun(allTestCasesToRun, failFastReporter, isBeingDebugged);
         }
 
         public void Cancel()
@@ -65,20 +177,98 @@ namespace GoogleTestAdapter
             }
         }
 
-        private void ComputeTestRunner(ITestFrameworkReporter reporter, bool isBeingDebugged)
+        private ITestFrameworkReporter DecorateReporter(ITestFrameworkReporter reporter,
+            out FailFastTestFrameworkReporter failFastReporter, out AsyncTestFrameworkReporter asyncReporter)
         {
-            if (_settings.ParallelTestExecution && !isBeingDebugged)
+            failFastReporter = null;
+            if (_settings.FailFast)
             {
-                _runner = new ParallelTestRunner(reporter, _logger, _settings, _schedulingAnalyzer);
+                failFastReporter = new FailFastTestFrameworkReporter(reporter, CancelAfterFailure);
+                reporter = failFastReporter;
+            }
+
+            asyncReporter = null;
+            if (_settings.AsyncResultReporting)
+            {
+                asyncReporter = new AsyncTestFrameworkReporter(reporter, _logger);
+                reporter = asyncReporter;
+            }
+
+            return reporter;
+        }
+
+        private void FinishTestRun(IEnumerable<TestCase> testCasesToRun, FailFastTestFrameworkReporter failFastReporter, bool isBeingDebugged)
+        {
+            if (failFastReporter != null && failFastReporter.HasFailed)
+                failFastReporter.ReportTestsNotRun(testCasesToRun, "Test has not been run since test execution has been canceled after the first failure (option '" + SettingsWrapper.OptionFailFast + "')");
+
+            _exitCodeTestsReporter.ReportExitCodeTestCases(_runner.ExecutableResults, isBeingDebugged);
+
+            if (_settings.ParallelTestExecution)
+                _schedulingAnalyzer.PrintStatisticsToDebugOutput();
+        }
+
+        /// <summary>
+        /// Tests can only be run while further executables are being discovered if they are assigned to the threads
+        /// dynamically (i.e., with work stealing), and if no decisions have to be made based on all tests (native sharding,
+        /// test impact analysis)
+        /// </summary>
+        private bool CanRunTestsWhileDiscovering(bool isBeingDebugged)
+        {
+            return !isBeingDebugged
+                && _settings.ParallelTestExecution && _settings.WorkStealingTestExecution
+                && string.IsNullOrWhiteSpace(_settings.RemoteAgents)
+                && _settings.NativeShardingThreshold <= 0
+                && string.IsNullOrWhiteSpace(_settings.ChangedFilesList);
+        }
+
+        private TestCase[] SelectAffectedTests(TestCase[] testCasesToRun)
+        {
+            IList<string> changedFiles;
+            try
+            {
+                changedFiles = TestImpactAnalyzer.ReadChangedFiles(_settings.ChangedFilesList);
+            }
+            catch (Exception e)
+            {
+                _logger.LogError($"Could not read changed files from '{_settings.ChangedFilesList}', running all tests: {e.Message}");
+                return testCasesToRun;
+            }
+
+            TestCase[] affectedTests = new TestImpactAnalyzer(_diaResolverFactory, _settings, _logger)
+                .SelectAffectedTests(testCasesToRun, changedFiles)
+                .ToArray();
+            _logger.LogInfo($"{affectedTests.Length} of {testCasesToRun.Length} tests are affected by {changedFiles.Count} changed files (option '{SettingsWrapper.OptionChangedFilesList}')");
+            return affectedTests;
+        }
+
+        private void CancelAfterFailure(TestResult failedTestResult)
+        {
+            _logger.LogInfo($"Test {failedTestResult.TestCase.DisplayName} has failed - canceling test execution (option '{SettingsWrapper.OptionFailFast}')");
+            Cancel();
+        }
+
+        private void ComputeTestRunner(ITestFrameworkReporter reporter, bool isBeingDebugged, IDictionary<string, List<TestCase>> allTestCasesOfExecutables)
+        {
+            bool useRemoteAgents = !string.IsNullOrWhiteSpace(_settings.RemoteAgents);
+            if ((_settings.ParallelTestExecution || useRemoteAgents) && !isBeingDebugged)
+            {
+                _runner = new ParallelTestRunner(reporter, _logger, _settings, _schedulingAnalyzer, allTestCasesOfExecutables);
             }
             else
             {
-                _runner = new PreparingTestRunner(reporter, _logger, _settings, _schedulingAnalyzer);
+                _runner = new PreparingTestRunner(-1, reporter, _logger, _settings, _schedulingAnalyzer,
+                    new TestExecutionContext { AllTestCasesOfExecutables = allTestCasesOfExecutables });
                 if (_settings.ParallelTestExecution && isBeingDebugged)
                 {
                     _logger.DebugInfo(
                         "Parallel execution is selected in options, but tests are executed sequentially because debugger is attached.");
                 }
+                if (useRemoteAgents && isBeingDebugged)
+                {
+                    _logger.DebugInfo(
+                        "Remote agents are configured in options, but tests are executed locally because debugger is attached.");
+                }
             }
         }
 
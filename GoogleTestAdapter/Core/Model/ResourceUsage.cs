@@ -0,0 +1,31 @@
+﻿using System;
+
+namespace GoogleTestAdapter.Model
+{
+    /// <summary>
+    /// Resources consumed by a test or by a test executable. Values which could not be measured are 0.
+    /// </summary>
+    public class ResourceUsage
+    {
+        public TimeSpan UserTime { get; set; }
+        public TimeSpan KernelTime { get; set; }
+        /// <summary>
+        /// Peak committed memory (private bytes); for a test executable, of all its processes together. Where no
+        /// commit charge is available (i.e., for tests on non-Windows platforms), the peak resident set size.
+        /// </summary>
+        public long PeakMemoryInBytes { get; set; }
+        public long PageFaults { get; set; }
+        public long ReadBytes { get; set; }
+        public long WriteBytes { get; set; }
+
+        public TimeSpan CpuTime => UserTime + KernelTime;
+
+        public override string ToString()
+        {
+            return $"CPU time {(long)UserTime.TotalMilliseconds}ms user, {(long)KernelTime.TotalMilliseconds}ms kernel; " +
+                   $"peak memory {PeakMemoryInBytes / 1024}KB; page faults {PageFaults}; I/O {ReadBytes} bytes read, {WriteBytes} bytes written";
+        }
+
+    }
+
+}
@@ -15,6 +15,12 @@ namespace GoogleTestAdapter.Model
         public string ErrorMessage { get; set; }
         public string ErrorStackTrace { get; set; }
         public TimeSpan Duration { get; set; }
+        public ResourceUsage ResourceUsage { get; set; }
+
+        /// <summary>
+        /// True if the result has been taken from the result cache instead of running the test.
+        /// </summary>
+        public bool IsCached { get; set; }
 
         public TestResult(TestCase testCase)
         {
@@ -5,7 +5,9 @@ using System.Text;
 using System.Threading;
 using GoogleTestAdapter.Common;
 using GoogleTestAdapter.Helpers;
+using GoogleTestAdapter.Model;
 using GoogleTestAdapter.ProcessExecution.Contracts;
+using GoogleTestAdapter.Scheduling;
 
 namespace GoogleTestAdapter.ProcessExecution
 {
@@ -15,7 +17,23 @@ namespace GoogleTestAdapter.ProcessExecution
         private readonly bool _printTestOutput;
         private readonly ILogger _logger;
         
+        private readonly object _lock = new object();
         private Process _process;
+        private int? _processId;
+        private bool _isCanceled;
+
+        /// <summary>
+        /// Resources consumed by the last executed command (including its child processes); null if not available.
+        /// Since Process can not be started suspended, the job object is assigned right after the start, and child
+        /// processes started before that are not measured (they are still killed with the process tree on cancel).
+        /// PreSpawningProcessExecutor does not have this limitation.
+        /// </summary>
+        public ResourceUsage ResourceUsage { get; private set; }
+
+        /// <summary>
+        /// If set, the executed command (including its child processes) only runs on the given logical processors.
+        /// </summary>
+        public CpuSet CpuSet { get; set; }
 
         public static void LogStartOfOutput(ILogger logger, string command, string parameters)
         {
@@ -54,6 +72,7 @@ namespace GoogleTestAdapter.ProcessExecution
             foreach (var environmentVariable in environmentVariables)
                 processStartInfo.EnvironmentVariables[environmentVariable.Key] = environmentVariable.Value;
 
+            ResourceUsage = null;
             _process = new Process {StartInfo = processStartInfo};
             using (AutoResetEvent outputWaitHandle = new AutoResetEvent(false))
             using (AutoResetEvent errorWaitHandle = new AutoResetEvent(false))
@@ -86,12 +105,29 @@ namespace GoogleTestAdapter.ProcessExecution
                 }
 
                 _process.Start();
+                lock (_lock)
+                {
+                    _processId = _process.Id;
+                    if (_isCanceled)
+                        ProcessUtils.KillProcessTree(_process.Id, _logger);
+                }
+                JobObject jobObject = JobObject.TryCreate(_process, _logger);
+                if (CpuSet != null)
+                    SetProcessorAffinity(_process, jobObject, CpuSet, _logger);
                 _process.BeginOutputReadLine();
                 _process.BeginErrorReadLine();
 
-                if (_process.WaitForExit(int.MaxValue) &&
-                    outputWaitHandle.WaitOne(int.MaxValue) &&
-                    errorWaitHandle.WaitOne(int.MaxValue))
+                bool hasExited = _process.WaitForExit(int.MaxValue) &&
+                                 outputWaitHandle.WaitOne(int.MaxValue) &&
+                                 errorWaitHandle.WaitOne(int.MaxValue);
+                ResourceUsage = jobObject?.GetResourceUsage();
+                jobObject?.Dispose();
+                lock (_lock)
+                {
+                    _processId = null;
+                }
+
+                if (hasExited)
                 {
                     if (_printTestOutput)
                     {
@@ -107,11 +143,36 @@ namespace GoogleTestAdapter.ProcessExecution
             }
         }
 
+        /// <summary>
+        /// Sets the affinity of the job if possible, such that child processes are affected, too; otherwise
+        /// of the process only (which is inherited by child processes started afterwards).
+        /// </summary>
+        internal static void SetProcessorAffinity(Process process, JobObject jobObject, CpuSet cpuSet, ILogger logger)
+        {
+            if (jobObject != null && jobObject.TrySetProcessorAffinity(cpuSet.AffinityMask, logger))
+                return;
+
+            try
+            {
+                process.ProcessorAffinity = new IntPtr((long)cpuSet.AffinityMask);
+            }
+            catch (Exception e)
+            {
+                logger.DebugWarning($"Could not set processor affinity of process {process.Id} to CPU set {cpuSet}: {e.Message}");
+            }
+        }
+
+        /// <summary>
+        /// Kills the process tree of the running command. If the command has not been started yet, the cancel request
+        /// is remembered, and the process is killed as soon as it has been started.
+        /// </summary>
         public void Cancel()
         {
-            if (_process != null)
+            lock (_lock)
             {
-                ProcessUtils.KillProcess(_process.Id, _logger);
+                _isCanceled = true;
+                if (_processId != null)
+                    ProcessUtils.KillProcessTree(_processId.Value, _logger);
             }
         }
 
@@ -0,0 +1,200 @@
+﻿using System;
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+using GoogleTestAdapter.Common;
+using GoogleTestAdapter.Model;
+
+namespace GoogleTestAdapter.ProcessExecution
+{
+    /// <summary>
+    /// Windows job object used for measuring the resources consumed by a test executable, including all
+    /// processes started by it.
+    /// </summary>
+    public sealed class JobObject : IDisposable
+    {
+        private static class NativeMethods
+        {
+            internal const int JobObjectBasicLimitInformation = 2;
+            internal const int JobObjectBasicAndIoAccountingInformation = 8;
+            internal const int JobObjectExtendedLimitInformation = 9;
+            internal const uint JobObjectLimitAffinity = 0x00000010;
+
+            [DllImport("kernel32.dll", CharSet = CharSet.Unicode, SetLastError = true)]
+            internal static extern IntPtr CreateJobObject(IntPtr jobAttributes, string name);
+
+            [DllImport("kernel32.dll", SetLastError = true)]
+            internal static extern bool AssignProcessToJobObject(IntPtr job, IntPtr process);
+
+            [DllImport("kernel32.dll", SetLastError = true)]
+            internal static extern bool QueryInformationJobObject(IntPtr job, int jobObjectInfoClass,
+                out JOBOBJECT_BASIC_AND_IO_ACCOUNTING_INFORMATION info, int infoLength, IntPtr returnLength);
+
+            [DllImport("kernel32.dll", SetLastError = true)]
+            internal static extern bool QueryInformationJobObject(IntPtr job, int jobObjectInfoClass,
+                out JOBOBJECT_EXTENDED_LIMIT_INFORMATION info, int infoLength, IntPtr returnLength);
+
+            [DllImport("kernel32.dll", SetLastError = true)]
+            internal static extern bool SetInformationJobObject(IntPtr job, int jobObjectInfoClass,
+                ref JOBOBJECT_BASIC_LIMIT_INFORMATION info, int infoLength);
+
+            [DllImport("kernel32.dll", SetLastError = true)]
+            internal static extern bool CloseHandle(IntPtr handle);
+        }
+
+        // ReSharper disable InconsistentNaming, FieldCanBeMadeReadOnly.Local, MemberCanBePrivate.Local
+        [StructLayout(LayoutKind.Sequential)]
+        private struct JOBOBJECT_BASIC_ACCOUNTING_INFORMATION
+        {
+            public long TotalUserTime;
+            public long TotalKernelTime;
+            public long ThisPeriodTotalUserTime;
+            public long ThisPeriodTotalKernelTime;
+            public uint TotalPageFaultCount;
+            public uint TotalProcesses;
+            public uint ActiveProcesses;
+            public uint TotalTerminatedProcesses;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        private struct IO_COUNTERS
+        {
+            public ulong ReadOperationCount;
+            public ulong WriteOperationCount;
+            public ulong OtherOperationCount;
+            public ulong ReadTransferCount;
+            public ulong WriteTransferCount;
+            public ulong OtherTransferCount;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        private struct JOBOBJECT_BASIC_AND_IO_ACCOUNTING_INFORMATION
+        {
+            public JOBOBJECT_BASIC_ACCOUNTING_INFORMATION BasicInfo;
+            public IO_COUNTERS IoInfo;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        private struct JOBOBJECT_BASIC_LIMIT_INFORMATION
+        {
+            public long PerProcessUserTimeLimit;
+            public long PerJobUserTimeLimit;
+            public uint LimitFlags;
+            public UIntPtr MinimumWorkingSetSize;
+            public UIntPtr MaximumWorkingSetSize;
+            public uint ActiveProcessLimit;
+            public UIntPtr Affinity;
+            public uint PriorityClass;
+            public uint SchedulingClass;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        private struct JOBOBJECT_EXTENDED_LIMIT_INFORMATION
+        {
+            public JOBOBJECT_BASIC_LIMIT_INFORMATION BasicLimitInformation;
+            public IO_COUNTERS IoInfo;
+            public UIntPtr ProcessMemoryLimit;
+            public UIntPtr JobMemoryLimit;
+            public UIntPtr PeakProcessMemoryUsed;
+            public UIntPtr PeakJobMemoryUsed;
+        }
+        // ReSharper restore InconsistentNaming, FieldCanBeMadeReadOnly.Local, MemberCanBePrivate.Local
+
+        private IntPtr _handle;
+
+        private JobObject(IntPtr handle)
+        {
+            _handle = handle;
+        }
+
+        /// <summary>
+        /// Creates a job object and assigns the (just started) process to it. Returns null if this is not possible,
+        /// e.g. because the process is already part of a job which does not allow nested jobs.
+        /// </summary>
+        public static JobObject TryCreate(Process process, ILogger logger)
+        {
+            return TryCreate(process.Handle, process.Id, logger);
+        }
+
+        /// <summary>
+        /// Creates a job object and assigns the process with the given handle to it. If the process has been created
+        /// suspended, this guarantees that all its child processes are part of the job, too.
+        /// </summary>
+        public static JobObject TryCreate(IntPtr processHandle, int processId, ILogger logger)
+        {
+            try
+            {
+                IntPtr handle = NativeMethods.CreateJobObject(IntPtr.Zero, null);
+                if (handle == IntPtr.Zero)
+                {
+                    logger.DebugWarning($"Could not create job object, error code: {Marshal.GetLastWin32Error()}");
+                    return null;
+                }
+
+                var jobObject = new JobObject(handle);
+                if (!NativeMethods.AssignProcessToJobObject(handle, processHandle))
+                {
+                    logger.DebugWarning($"Could not assign process {processId} to job object, error code: {Marshal.GetLastWin32Error()}");
+                    jobObject.Dispose();
+                    return null;
+                }
+                return jobObject;
+            }
+            catch (Exception e)
+            {
+                logger.DebugWarning($"Could not create job object: {e.Message}");
+                return null;
+            }
+        }
+
+        /// <summary>
+        /// Restricts all processes of the job to the given logical processors (of the current processor group).
+        /// </summary>
+        public bool TrySetProcessorAffinity(ulong affinityMask, ILogger logger)
+        {
+            var limitInfo = new JOBOBJECT_BASIC_LIMIT_INFORMATION
+            {
+                LimitFlags = NativeMethods.JobObjectLimitAffinity,
+                Affinity = new UIntPtr(affinityMask)
+            };
+            if (NativeMethods.SetInformationJobObject(_handle, NativeMethods.JobObjectBasicLimitInformation, ref limitInfo, Marshal.SizeOf(typeof(JOBOBJECT_BASIC_LIMIT_INFORMATION))))
+                return true;
+
+            logger.DebugWarning($"Could not set processor affinity of job object to {affinityMask:X}, error code: {Marshal.GetLastWin32Error()}");
+            return false;
+        }
+
+        /// <summary>
+        /// Returns the resources consumed by all processes of the job so far, or null if they could not be queried.
+        /// </summary>
+        public ResourceUsage GetResourceUsage()
+        {
+            if (!NativeMethods.QueryInformationJobObject(_handle, NativeMethods.JobObjectBasicAndIoAccountingInformation,
+                    out JOBOBJECT_BASIC_AND_IO_ACCOUNTING_INFORMATION accountingInfo, Marshal.SizeOf(typeof(JOBOBJECT_BASIC_AND_IO_ACCOUNTING_INFORMATION)), IntPtr.Zero)
+                || !NativeMethods.QueryInformationJobObject(_handle, NativeMethods.JobObjectExtendedLimitInformation,
+                    out JOBOBJECT_EXTENDED_LIMIT_INFORMATION limitInfo, Marshal.SizeOf(typeof(JOBOBJECT_EXTENDED_LIMIT_INFORMATION)), IntPtr.Zero))
+                return null;
+
+            return new ResourceUsage
+            {
+                UserTime = TimeSpan.FromTicks(accountingInfo.BasicInfo.TotalUserTime),
+                KernelTime = TimeSpan.FromTicks(accountingInfo.BasicInfo.TotalKernelTime),
+                // committed memory of all processes of the job at the same time, not only of the largest one
+                PeakMemoryInBytes = (long)limitInfo.PeakJobMemoryUsed.ToUInt64(),
+                PageFaults = accountingInfo.BasicInfo.TotalPageFaultCount,
+                ReadBytes = (long)accountingInfo.IoInfo.ReadTransferCount,
+                WriteBytes = (long)accountingInfo.IoInfo.WriteTransferCount
+            };
+        }
+
+        public void Dispose()
+        {
+            if (_handle != IntPtr.Zero)
+            {
+                NativeMethods.CloseHandle(_handle);
+                _handle = IntPtr.Zero;
+            }
+        }
+
+    }
+
+}
@@ -0,0 +1,504 @@
+﻿using System;
+using System.Collections;
+using System.Collections.Generic;
+using System.Collections.Specialized;
+using System.ComponentModel;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Runtime.InteropServices;
+using System.Text;
+using GoogleTestAdapter.Common;
+using GoogleTestAdapter.Helpers;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.ProcessExecution.Contracts;
+using GoogleTestAdapter.Scheduling;
+using Microsoft.Win32.SafeHandles;
+
+namespace GoogleTestAdapter.ProcessExecution
+{
+    /// <summary>
+    /// Executes commands in processes which are created in suspended state. A process can be created in advance
+    /// with PreSpawn() (e.g. while the previous test batch is still running); it is resumed as soon as the same
+    /// command is executed, such that process creation (including mapping of the executable and scanning it by
+    /// anti virus software) does not delay execution. Dynamic loading and static initialization only happen once
+    /// the process has been resumed. Commands which have not been pre-spawned are created and resumed right away.
+    /// </summary>
+    public sealed class PreSpawningProcessExecutor : IProcessExecutor, IDisposable
+    {
+        public const int ExecutionFailed = int.MaxValue;
+
+        private readonly bool _printTestOutput;
+        private readonly ILogger _logger;
+        private readonly object _lock = new object();
+
+        private SuspendedProcess _process;
+        private bool _isCanceled;
+
+        /// <summary>
+        /// Resources consumed by the last executed command (including its child processes); null if not available.
+        /// </summary>
+        public ResourceUsage ResourceUsage { get; private set; }
+
+        /// <summary>
+        /// If set, the executed command (including its child processes) only runs on the given logical processors.
+        /// </summary>
+        public CpuSet CpuSet { get; set; }
+
+        public PreSpawningProcessExecutor(bool printTestOutput, ILogger logger)
+        {
+            _printTestOutput = printTestOutput;
+            _logger = logger;
+        }
+
+        /// <summary>
+        /// Creates the process for the given command in suspended state. A previously pre-spawned process is terminated.
+        /// </summary>
+        /// <exception cref="Win32Exception">if the process can not be created</exception>
+        public void PreSpawn(string command, string parameters, string workingDir, string pathExtension, IDictionary<string, string> environmentVariables)
+        {
+            var process = SuspendedProcess.Create(command, parameters, workingDir, pathExtension, environmentVariables, CpuSet, _logger);
+            lock (_lock)
+            {
+                _process?.Dispose();
+                _process = process;
+            }
+            _logger.DebugInfo($"Pre-spawned process {process.Id} for executable {command}");
+        }
+
+        public bool IsPreSpawnedFor(string command, string parameters, string workingDir, string pathExtension, IDictionary<string, string> environmentVariables)
+        {
+            lock (_lock)
+            {
+                return _process != null && _process.IsCreatedFor(command, parameters, workingDir, pathExtension, environmentVariables);
+            }
+        }
+
+        public int ExecuteCommandBlocking(string command, string parameters, string workingDir, string pathExtension, IDictionary<string, string> environmentVariables,
+            Action<string> reportOutputLine)
+        {
+            ResourceUsage = null;
+            SuspendedProcess process;
+            try
+            {
+                lock (_lock)
+                {
+                    if (_process == null || !_process.IsCreatedFor(command, parameters, workingDir, pathExtension, environmentVariables))
+                    {
+                        _process?.Dispose();
+                        _process = null;
+                        _process = SuspendedProcess.Create(command, parameters, workingDir, pathExtension, environmentVariables, CpuSet, _logger);
+                    }
+                    process = _process;
+                }
+            }
+            catch (Win32Exception ex)
+            {
+                string nativeErrorMessage = new Win32Exception(ex.NativeErrorCode).Message;
+                _logger.LogError($"{ex.Message} ({ex.NativeErrorCode}: {nativeErrorMessage})");
+                return ExecutionFailed;
+            }
+
+            try
+            {
+                // the process is resumed under the lock such that a concurrent Cancel() either prevents resuming it,
+                // or finds it resumed and kills it
+                lock (_lock)
+                {
+                    if (_isCanceled)
+                    {
+                        _logger.DebugInfo($"Execution has been canceled, terminating suspended process {process.Id} of executable {command}");
+                        return ExecutionFailed;
+                    }
+                    process.Resume();
+                }
+
+                if (_printTestOutput)
+                {
+                    DotNetProcessExecutor.LogStartOfOutput(_logger, command, parameters);
+                }
+
+                int exitCode = process.Wait(line =>
+                {
+                    reportOutputLine?.Invoke(line);
+                    if (_printTestOutput)
+                    {
+                        _logger.LogInfo(line);
+                    }
+                });
+                ResourceUsage = process.GetResourceUsage();
+
+                if (_printTestOutput)
+                {
+                    DotNetProcessExecutor.LogEndOfOutput(_logger);
+                }
+
+                _logger.DebugInfo($"Executable {command} returned with exit code {exitCode}");
+                return exitCode;
+            }
+            catch (Win32Exception ex)
+            {
+                _logger.LogError($"Executable {command} did not return properly: {ex.Message}");
+                return ExecutionFailed;
+            }
+            finally
+            {
+                lock (_lock)
+                {
+                    process.Dispose();
+                    if (_process == process)
+                        _process = null;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Kills the process tree of the running command. If the command's process has not been resumed yet, the cancel
+        /// request is remembered, and the process is terminated instead of being resumed.
+        /// </summary>
+        public void Cancel()
+        {
+            lock (_lock)
+            {
+                _isCanceled = true;
+                if (_process != null && _process.IsResumed)
+                    ProcessUtils.KillProcessTree(_process.Id, _logger);
+            }
+        }
+
+        /// <summary>
+        /// Terminates a pre-spawned process which has not been used.
+        /// </summary>
+        public void Dispose()
+        {
+            lock (_lock)
+            {
+                _process?.Dispose();
+                _process = null;
+            }
+        }
+
+        private sealed class SuspendedProcess : IDisposable
+        {
+            private readonly string _command;
+            private readonly string _parameters;
+            private readonly string _workingDir;
+            private readonly string _pathExtension;
+            private readonly IDictionary<string, string> _environmentVariables;
+
+            private SafeWaitHandle _processHandle;
+            private SafeWaitHandle _threadHandle;
+            private SafeFileHandle _outputReadingEnd;
+            private JobObject _jobObject;
+
+            public int Id { get; private set; }
+            public bool IsResumed { get; private set; }
+
+            private SuspendedProcess(string command, string parameters, string workingDir, string pathExtension, IDictionary<string, string> environmentVariables)
+            {
+                _command = command;
+                _parameters = parameters;
+                _workingDir = workingDir;
+                _pathExtension = pathExtension;
+                _environmentVariables = new Dictionary<string, string>(environmentVariables);
+            }
+
+            public static SuspendedProcess Create(string command, string parameters, string workingDir, string pathExtension, IDictionary<string, string> environmentVariables,
+                CpuSet cpuSet, ILogger logger)
+            {
+                var process = new SuspendedProcess(command, parameters, workingDir, pathExtension, environmentVariables);
+                try
+                {
+                    NativeMethods.CreatePipe(out process._outputReadingEnd, out SafeFileHandle outputWritingEnd);
+                    using (outputWritingEnd)
+                    {
+                        var processInfo = NativeMethods.CreateSuspendedProcess(command, parameters, workingDir,
+                            CreateEnvironment(pathExtension, environmentVariables), outputWritingEnd);
+                        process._processHandle = new SafeWaitHandle(processInfo.hProcess, true);
+                        process._threadHandle = new SafeWaitHandle(processInfo.hThread, true);
+                        process.Id = processInfo.dwProcessId;
+                    }
+                    process._jobObject = JobObject.TryCreate(process._processHandle.DangerousGetHandle(), process.Id, logger);
+                    if (cpuSet != null)
+                    {
+                        using (Process dotNetProcess = Process.GetProcessById(process.Id))
+                        {
+                            DotNetProcessExecutor.SetProcessorAffinity(dotNetProcess, process._jobObject, cpuSet, logger);
+                        }
+                    }
+                    return process;
+                }
+                catch
+                {
+                    process.Dispose();
+                    throw;
+                }
+            }
+
+            public bool IsCreatedFor(string command, string parameters, string workingDir, string pathExtension, IDictionary<string, string> environmentVariables)
+            {
+                return !IsResumed
+                       && _command == command
+                       && (_parameters ?? "") == (parameters ?? "")
+                       && (_workingDir ?? "") == (workingDir ?? "")
+                       && (_pathExtension ?? "") == (pathExtension ?? "")
+                       && _environmentVariables.Count == environmentVariables.Count
+                       && _environmentVariables.All(kvp => environmentVariables.TryGetValue(kvp.Key, out string value) && value == kvp.Value);
+            }
+
+            public void Resume()
+            {
+                IsResumed = true;
+                if (NativeMethods.ResumeThread(_threadHandle) == -1)
+                    throw new Win32Exception(Marshal.GetLastWin32Error(), "Could not resume process");
+            }
+
+            public int Wait(Action<string> reportOutputLine)
+            {
+                using (var stream = new FileStream(_outputReadingEnd, FileAccess.Read, 4096, false))
+                using (var reader = new StreamReader(stream, Encoding.Default))
+                {
+                    _outputReadingEnd = null;
+                    string line;
+                    while ((line = reader.ReadLine()) != null)
+                    {
+                        reportOutputLine(line);
+                    }
+                }
+
+                NativeMethods.WaitForSingleObject(_processHandle, NativeMethods.INFINITE);
+                if (!NativeMethods.GetExitCodeProcess(_processHandle, out int exitCode))
+                    throw new Win32Exception(Marshal.GetLastWin32Error(), "Could not get exit code of process");
+
+                return exitCode;
+            }
+
+            public ResourceUsage GetResourceUsage()
+            {
+                return _jobObject?.GetResourceUsage();
+            }
+
+            public void Dispose()
+            {
+                if (!IsResumed && _processHandle != null && !_processHandle.IsInvalid)
+                    NativeMethods.TerminateProcess(_processHandle, ExecutionFailed);
+
+                _jobObject?.Dispose();
+                _outputReadingEnd?.Dispose();
+                _threadHandle?.Dispose();
+                _processHandle?.Dispose();
+                _jobObject = null;
+                _outputReadingEnd = null;
+                _threadHandle = null;
+                _processHandle = null;
+            }
+
+            /// <summary>
+            /// Creates a Unicode environment block: "name=value" entries sorted by name, each terminated by a null
+            /// character, and a final null character terminating the block
+            /// </summary>
+            private static string CreateEnvironment(string pathExtension, IDictionary<string, string> environmentVariables)
+            {
+                StringDictionary envVariables = new ProcessStartInfo().EnvironmentVariables;
+
+                if (!string.IsNullOrEmpty(pathExtension))
+                    envVariables["PATH"] = Utils.GetExtendedPath(pathExtension);
+                foreach (var environmentVariable in environmentVariables)
+                    envVariables[environmentVariable.Key] = environmentVariable.Value;
+
+                var envVariablesList = new List<string>();
+                foreach (DictionaryEntry entry in envVariables)
+                    envVariablesList.Add($"{entry.Key}={entry.Value}");
+                envVariablesList.Sort(StringComparer.OrdinalIgnoreCase);
+
+                var result = new StringBuilder();
+                foreach (string envVariable in envVariablesList)
+                {
+                    result.Append(envVariable).Append('\0');
+                }
+                result.Append('\0');
+
+                return result.ToString();
+            }
+        }
+
+        // ReSharper disable InconsistentNaming, FieldCanBeMadeReadOnly.Local, MemberCanBePrivate.Local, NotAccessedField.Local
+        private static class NativeMethods
+        {
+            internal const uint INFINITE = 0xFFFFFFFF;
+
+            private const int STARTF_USESTDHANDLES = 0x00000100;
+            private const uint CREATE_SUSPENDED = 0x00000004;
+            private const uint CREATE_UNICODE_ENVIRONMENT = 0x00000400;
+            private const uint CREATE_NO_WINDOW = 0x08000000;
+            private const uint EXTENDED_STARTUPINFO_PRESENT = 0x00080000;
+            private const uint HANDLE_FLAG_INHERIT = 0x00000001;
+            private static readonly IntPtr PROC_THREAD_ATTRIBUTE_HANDLE_LIST = (IntPtr)0x00020002;
+
+            [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Unicode)]
+            private struct STARTUPINFO
+            {
+                public int cb;
+                public string lpReserved;
+                public string lpDesktop;
+                public string lpTitle;
+                public int dwX;
+                public int dwY;
+                public int dwXSize;
+                public int dwYSize;
+                public int dwXCountChars;
+                public int dwYCountChars;
+                public int dwFillAttribute;
+                public int dwFlags;
+                public short wShowWindow;
+                public short cbReserved2;
+                public IntPtr lpReserved2;
+                public IntPtr hStdInput;
+                public IntPtr hStdOutput;
+                public IntPtr hStdError;
+            }
+
+            [StructLayout(LayoutKind.Sequential)]
+            private struct STARTUPINFOEX
+            {
+                public STARTUPINFO StartupInfo;
+                public IntPtr lpAttributeList;
+            }
+
+            [StructLayout(LayoutKind.Sequential)]
+            internal struct PROCESS_INFORMATION
+            {
+                public IntPtr hProcess;
+                public IntPtr hThread;
+                public int dwProcessId;
+                public int dwThreadId;
+            }
+
+            internal static void CreatePipe(out SafeFileHandle readingEnd, out SafeFileHandle writingEnd)
+            {
+                if (!CreatePipe(out readingEnd, out writingEnd, IntPtr.Zero, 0))
+                    throw new Win32Exception(Marshal.GetLastWin32Error(), "Could not create pipe");
+
+                if (!SetHandleInformation(writingEnd, HANDLE_FLAG_INHERIT, HANDLE_FLAG_INHERIT))
+                {
+                    readingEnd.Dispose();
+                    writingEnd.Dispose();
+                    throw new Win32Exception(Marshal.GetLastWin32Error(), "Could not set handle information");
+                }
+            }
+
+            /// <summary>
+            /// The child process only inherits the writing end of the output pipe; this is important since the process
+            /// might live (suspended) for a while, and would otherwise keep open pipes of processes started concurrently
+            /// </summary>
+            internal static PROCESS_INFORMATION CreateSuspendedProcess(string command, string parameters, string workingDir, string environment,
+                SafeFileHandle outputWritingEnd)
+            {
+                string commandLine = $"\"{command}\"";
+                if (!string.IsNullOrEmpty(parameters))
+                    commandLine += $" {parameters}";
+                if (string.IsNullOrEmpty(workingDir))
+                    workingDir = null;
+
+                IntPtr attributeList = IntPtr.Zero;
+                IntPtr inheritedHandles = Marshal.AllocHGlobal(IntPtr.Size);
+                // copied including the embedded null characters (a string parameter would be cut off at the first one)
+                IntPtr environmentBlock = Marshal.StringToHGlobalUni(environment);
+                try
+                {
+                    Marshal.WriteIntPtr(inheritedHandles, outputWritingEnd.DangerousGetHandle());
+
+                    IntPtr size = IntPtr.Zero;
+                    InitializeProcThreadAttributeList(IntPtr.Zero, 1, 0, ref size);
+                    attributeList = Marshal.AllocHGlobal(size);
+                    if (!InitializeProcThreadAttributeList(attributeList, 1, 0, ref size))
+                    {
+                        Marshal.FreeHGlobal(attributeList);
+                        attributeList = IntPtr.Zero;
+                        throw new Win32Exception(Marshal.GetLastWin32Error(), "Could not initialize process attributes");
+                    }
+                    if (!UpdateProcThreadAttribute(attributeList, 0, PROC_THREAD_ATTRIBUTE_HANDLE_LIST, inheritedHandles, (IntPtr)IntPtr.Size, IntPtr.Zero, IntPtr.Zero))
+                        throw new Win32Exception(Marshal.GetLastWin32Error(), "Could not set inherited handles");
+
+                    var startupInfo = new STARTUPINFOEX
+                    {
+                        StartupInfo = new STARTUPINFO
+                        {
+                            cb = Marshal.SizeOf(typeof(STARTUPINFOEX)),
+                            dwFlags = STARTF_USESTDHANDLES,
+                            hStdOutput = outputWritingEnd.DangerousGetHandle(),
+                            hStdError = outputWritingEnd.DangerousGetHandle()
+                        },
+                        lpAttributeList = attributeList
+                    };
+
+                    if (!CreateProcess(null, commandLine, IntPtr.Zero, IntPtr.Zero, true,
+                        CREATE_SUSPENDED | CREATE_NO_WINDOW | EXTENDED_STARTUPINFO_PRESENT | CREATE_UNICODE_ENVIRONMENT,
+                        environmentBlock, workingDir, ref startupInfo, out PROCESS_INFORMATION processInfo))
+                    {
+                        throw new Win32Exception(Marshal.GetLastWin32Error(),
+                            $"Could not create process. Command: '{command}', parameters: '{parameters}', working dir: '{workingDir}'");
+                    }
+
+                    return processInfo;
+                }
+                finally
+                {
+                    if (attributeList != IntPtr.Zero)
+                    {
+                        DeleteProcThreadAttributeList(attributeList);
+                        Marshal.FreeHGlobal(attributeList);
+                    }
+                    Marshal.FreeHGlobal(inheritedHandles);
+                    Marshal.FreeHGlobal(environmentBlock);
+                }
+            }
+
+            [DllImport("kernel32.dll", CharSet = CharSet.Unicode, SetLastError = true, BestFitMapping = false, ThrowOnUnmappableChar = true)]
+            [return: MarshalAs(UnmanagedType.Bool)]
+            private static extern bool CreateProcess(
+                string lpApplicationName, string lpCommandLine,
+                IntPtr lpProcessAttributes, IntPtr lpThreadAttributes,
+                bool bInheritHandles, uint dwCreationFlags,
+                IntPtr lpEnvironment, string lpCurrentDirectory,
+                [In] ref STARTUPINFOEX lpStartupInfo, out PROCESS_INFORMATION lpProcessInformation);
+
+            [DllImport("kernel32.dll", SetLastError = true)]
+            [return: MarshalAs(UnmanagedType.Bool)]
+            private static extern bool InitializeProcThreadAttributeList(IntPtr lpAttributeList, int dwAttributeCount, int dwFlags, ref IntPtr lpSize);
+
+            [DllImport("kernel32.dll", SetLastError = true)]
+            [return: MarshalAs(UnmanagedType.Bool)]
+            private static extern bool UpdateProcThreadAttribute(IntPtr lpAttributeList, uint dwFlags, IntPtr attribute, IntPtr lpValue, IntPtr cbSize,
+                IntPtr lpPreviousValue, IntPtr lpReturnSize);
+
+            [DllImport("kernel32.dll", SetLastError = true)]
+            private static extern void DeleteProcThreadAttributeList(IntPtr lpAttributeList);
+
+            [DllImport("kernel32.dll", SetLastError = true)]
+            [return: MarshalAs(UnmanagedType.Bool)]
+            private static extern bool CreatePipe(out SafeFileHandle hReadPipe, out SafeFileHandle hWritePipe, IntPtr securityAttributes, int nSize);
+
+            [DllImport("kernel32.dll", SetLastError = true)]
+            [return: MarshalAs(UnmanagedType.Bool)]
+            private static extern bool SetHandleInformation(SafeHandle hObject, uint dwMask, uint dwFlags);
+
+            [DllImport("kernel32.dll", SetLastError = true)]
+            internal static extern int ResumeThread(SafeHandle hThread);
+
+            [DllImport("kernel32.dll", SetLastError = true)]
+            internal static extern uint WaitForSingleObject(SafeHandle hHandle, uint dwMilliseconds);
+
+            [DllImport("kernel32.dll", SetLastError = true)]
+            [return: MarshalAs(UnmanagedType.Bool)]
+            internal static extern bool GetExitCodeProcess(SafeHandle hProcess, out int lpExitCode);
+
+            [DllImport("kernel32.dll", SetLastError = true)]
+            [return: MarshalAs(UnmanagedType.Bool)]
+            internal static extern bool TerminateProcess(SafeHandle hProcess, int uExitCode);
+        }
+        // ReSharper restore InconsistentNaming, FieldCanBeMadeReadOnly.Local, MemberCanBePrivate.Local, NotAccessedField.Local
+
+    }
+
+}
@@ -0,0 +1,206 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Net;
+using System.Security.Cryptography;
+using System.Text;
+
+namespace GoogleTestAdapter.ProcessExecution
+{
+    /// <summary>
+    /// Protocol between adapter and remote agents: the adapter connects to an agent and proves that it knows the
+    /// shared secret by answering the agent's challenge (an HMAC of a random nonce), then sends a single request
+    /// describing the command to be executed (authenticated by an HMAC of the challenge and the request, such that
+    /// it can not be replaced after the handshake), and receives the command's output lines followed by its exit code
+    /// (or an error message). While the command is executed, the adapter can send a cancel message, which makes
+    /// the agent kill the command's process tree; the exit code is still sent afterwards. Closing the connection
+    /// cancels the command, too.
+    /// All strings are written as length-prefixed UTF-8 strings (see BinaryWriter.Write(string)).
+    /// </summary>
+    public static class RemoteAgentProtocol
+    {
+        public const int Version = 3;
+
+        /// <summary>
+        /// Environment variable holding the secret shared by adapter and agents, on both sides.
+        /// </summary>
+        public const string SecretEnvironmentVariable = "GTA_REMOTE_AGENT_SECRET";
+
+        private const int ChallengeLength = 32;
+        private const int MaxMacLength = 1024;
+        private const int MaxRequestLength = 16 * 1024 * 1024;
+
+        public const byte OutputLineMessage = 1;
+        public const byte ExitCodeMessage = 2;
+        public const byte ErrorMessage = 3;
+        public const byte CancelMessage = 4;
+
+        public static byte[] WriteChallenge(BinaryWriter writer)
+        {
+            var challenge = new byte[ChallengeLength];
+            using (var random = new RNGCryptoServiceProvider())
+            {
+                random.GetBytes(challenge);
+            }
+            writer.Write(challenge);
+            writer.Flush();
+            return challenge;
+        }
+
+        /// <summary>
+        /// Returns the challenge, which is needed for authenticating the request.
+        /// </summary>
+        public static byte[] AnswerChallenge(BinaryReader reader, BinaryWriter writer, string secret)
+        {
+            byte[] challenge = reader.ReadBytes(ChallengeLength);
+            if (challenge.Length < ChallengeLength)
+                throw new EndOfStreamException();
+
+            WriteBytes(writer, ComputeMac(secret, challenge));
+            writer.Flush();
+            return challenge;
+        }
+
+        /// <exception cref="UnauthorizedAccessException">if the adapter does not know the secret</exception>
+        public static void VerifyResponse(BinaryReader reader, string secret, byte[] challenge)
+        {
+            byte[] response = ReadBytes(reader, MaxMacLength);
+            if (!AreEqual(response, ComputeMac(secret, challenge)))
+                throw new UnauthorizedAccessException("Authentication failed - adapter and agent must use the same secret");
+        }
+
+        public static void WriteRequest(BinaryWriter writer, RemoteExecutionRequest request, string secret, byte[] challenge)
+        {
+            byte[] serializedRequest;
+            using (var stream = new MemoryStream())
+            using (var requestWriter = new BinaryWriter(stream, Encoding.UTF8))
+            {
+                requestWriter.Write(request.Command);
+                requestWriter.Write(request.Parameters ?? "");
+                requestWriter.Write(request.WorkingDir ?? "");
+                requestWriter.Write(request.PathExtension ?? "");
+                requestWriter.Write(request.EnvironmentVariables.Count);
+                foreach (KeyValuePair<string, string> environmentVariable in request.EnvironmentVariables)
+                {
+                    requestWriter.Write(environmentVariable.Key);
+                    requestWriter.Write(environmentVariable.Value ?? "");
+                }
+                requestWriter.Flush();
+                serializedRequest = stream.ToArray();
+            }
+
+            writer.Write(Version);
+            WriteBytes(writer, serializedRequest);
+            WriteBytes(writer, ComputeMac(secret, challenge, serializedRequest));
+            writer.Flush();
+        }
+
+        /// <exception cref="InvalidDataException">if the request has been sent by an incompatible adapter</exception>
+        /// <exception cref="UnauthorizedAccessException">if the request has not been sent by the authenticated adapter</exception>
+        public static RemoteExecutionRequest ReadRequest(BinaryReader reader, string secret, byte[] challenge)
+        {
+            int version = reader.ReadInt32();
+            if (version != Version)
+                throw new InvalidDataException($"Unsupported protocol version {version}, expected {Version}");
+
+            byte[] serializedRequest = ReadBytes(reader, MaxRequestLength);
+            byte[] mac = ReadBytes(reader, MaxMacLength);
+            if (!AreEqual(mac, ComputeMac(secret, challenge, serializedRequest)))
+                throw new UnauthorizedAccessException("Request has been modified after authentication");
+
+            using (var requestReader = new BinaryReader(new MemoryStream(serializedRequest), Encoding.UTF8))
+            {
+                var request = new RemoteExecutionRequest
+                {
+                    Command = requestReader.ReadString(),
+                    Parameters = requestReader.ReadString(),
+                    WorkingDir = requestReader.ReadString(),
+                    PathExtension = requestReader.ReadString()
+                };
+                int nrOfEnvironmentVariables = requestReader.ReadInt32();
+                for (int i = 0; i < nrOfEnvironmentVariables; i++)
+                {
+                    request.EnvironmentVariables[requestReader.ReadString()] = requestReader.ReadString();
+                }
+                return request;
+            }
+        }
+
+        /// <summary>
+        /// Parses a list of endpoints of the form "host:port", separated by ';'.
+        /// </summary>
+        /// <exception cref="FormatException">if an endpoint is invalid</exception>
+        public static IList<DnsEndPoint> ParseEndpoints(string endpoints)
+        {
+            var result = new List<DnsEndPoint>();
+            foreach (string endpoint in endpoints.Split(new[] { ';' }, StringSplitOptions.RemoveEmptyEntries))
+            {
+                string trimmedEndpoint = endpoint.Trim();
+                int separatorIndex = trimmedEndpoint.LastIndexOf(':');
+                if (separatorIndex <= 0 
+                    || !int.TryParse(trimmedEndpoint.Substring(separatorIndex + 1), out int port) 
+                    || port <= IPEndPoint.MinPort || port > IPEndPoint.MaxPort)
+                    throw new FormatException($"Invalid remote agent '{trimmedEndpoint}', expected format is host:port");
+
+                result.Add(new DnsEndPoint(trimmedEndpoint.Substring(0, separatorIndex), port));
+            }
+            return result;
+        }
+
+        private static void WriteBytes(BinaryWriter writer, byte[] bytes)
+        {
+            writer.Write(bytes.Length);
+            writer.Write(bytes);
+        }
+
+        /// <exception cref="InvalidDataException">if the announced length exceeds maxLength</exception>
+        private static byte[] ReadBytes(BinaryReader reader, int maxLength)
+        {
+            int length = reader.ReadInt32();
+            if (length < 0 || length > maxLength)
+                throw new InvalidDataException($"Invalid length {length}, expected at most {maxLength}");
+
+            byte[] bytes = reader.ReadBytes(length);
+            if (bytes.Length < length)
+                throw new EndOfStreamException();
+            return bytes;
+        }
+
+        /// <summary>
+        /// HMAC-SHA256 of the concatenated data.
+        /// </summary>
+        private static byte[] ComputeMac(string secret, byte[] challenge, byte[] data = null)
+        {
+            using (var hmac = new HMACSHA256(Encoding.UTF8.GetBytes(secret)))
+            {
+                hmac.TransformBlock(challenge, 0, challenge.Length, null, 0);
+                hmac.TransformFinalBlock(data ?? new byte[0], 0, data?.Length ?? 0);
+                return hmac.Hash;
+            }
+        }
+
+        /// <summary>
+        /// Compares in constant time such that a MAC can not be guessed byte by byte.
+        /// </summary>
+        private static bool AreEqual(byte[] actual, byte[] expected)
+        {
+            int difference = actual.Length ^ expected.Length;
+            for (int i = 0; i < expected.Length; i++)
+            {
+                difference |= expected[i] ^ (i < actual.Length ? actual[i] : 0);
+            }
+            return difference == 0;
+        }
+
+    }
+
+    public class RemoteExecutionRequest
+    {
+        public string Command { get; set; }
+        public string Parameters { get; set; }
+        public string WorkingDir { get; set; }
+        public string PathExtension { get; set; }
+        public IDictionary<string, string> EnvironmentVariables { get; } = new Dictionary<string, string>();
+    }
+
+}
@@ -0,0 +1,177 @@
+﻿using System;
+using System.IO;
+using System.Net;
+using System.Net.Sockets;
+using System.Text;
+using System.Threading;
+using GoogleTestAdapter.Common;
+
+namespace GoogleTestAdapter.ProcessExecution
+{
+    /// <summary>
+    /// Server side of the remote agent protocol (see RemoteAgentProtocol): accepts connections from adapters and
+    /// executes one command per connection. Connections are served concurrently, i.e., an adapter which lists an
+    /// agent several times will run that many test processes on the agent's machine at the same time.
+    /// Only adapters knowing the shared secret are served, and only executables within the test directory are run.
+    /// </summary>
+    public class RemoteAgentServer : IDisposable
+    {
+        private readonly TcpListener _listener;
+        private readonly string _testDirectory;
+        private readonly string _secret;
+        private readonly ILogger _logger;
+        private Thread _acceptThread;
+
+        /// <param name="address">Address to listen at; IPAddress.Loopback only accepts connections from the local machine</param>
+        /// <param name="port">Port to listen at; 0 lets the system choose a free port</param>
+        /// <param name="testDirectory">Directory containing the test executables which may be executed (including subdirectories)</param>
+        /// <param name="secret">Secret which must be known by the adapters</param>
+        public RemoteAgentServer(IPAddress address, int port, string testDirectory, string secret, ILogger logger)
+        {
+            if (string.IsNullOrEmpty(secret))
+                throw new ArgumentException("A secret is required", nameof(secret));
+
+            _listener = new TcpListener(address, port);
+            _testDirectory = Path.GetFullPath(testDirectory).TrimEnd(Path.DirectorySeparatorChar, Path.AltDirectorySeparatorChar) + Path.DirectorySeparatorChar;
+            _secret = secret;
+            _logger = logger;
+        }
+
+        public int Port => ((IPEndPoint)_listener.LocalEndpoint).Port;
+
+        public void Start()
+        {
+            _listener.Start();
+            _acceptThread = new Thread(AcceptConnections) { Name = "GTA remote agent", IsBackground = true };
+            _acceptThread.Start();
+            _logger.LogInfo($"Remote agent is listening at {_listener.LocalEndpoint}, executing tests within {_testDirectory}");
+        }
+
+        public void Dispose()
+        {
+            _listener.Stop();
+            _acceptThread?.Join();
+        }
+
+
+        private void AcceptConnections()
+        {
+            while (true)
+            {
+                TcpClient client;
+                try
+                {
+                    client = _listener.AcceptTcpClient();
+                }
+                catch (Exception e) when (e is SocketException || e is ObjectDisposedException || e is InvalidOperationException)
+                {
+                    // listener has been stopped
+                    return;
+                }
+
+                new Thread(() => HandleConnection(client)) { Name = "GTA remote agent connection", IsBackground = true }.Start();
+            }
+        }
+
+        private void HandleConnection(TcpClient client)
+        {
+            string remoteEndPoint = client.Client.RemoteEndPoint.ToString();
+            using (client)
+            using (NetworkStream stream = client.GetStream())
+            using (var reader = new BinaryReader(stream, Encoding.UTF8, true))
+            using (var writer = new BinaryWriter(stream, Encoding.UTF8, true))
+            {
+                client.NoDelay = true;
+                try
+                {
+                    byte[] challenge = RemoteAgentProtocol.WriteChallenge(writer);
+                    RemoteAgentProtocol.VerifyResponse(reader, _secret, challenge);
+
+                    RemoteExecutionRequest request = RemoteAgentProtocol.ReadRequest(reader, _secret, challenge);
+                    VerifyCommand(request.Command);
+                    _logger.DebugInfo($"Executing command for {remoteEndPoint}: {request.Command} {request.Parameters}");
+
+                    var executor = new DotNetProcessExecutor(false, _logger);
+                    var cancelThread = new Thread(() => WaitForCancellation(stream, executor)) { IsBackground = true };
+                    cancelThread.Start();
+
+                    int exitCode = executor.ExecuteCommandBlocking(request.Command, request.Parameters, request.WorkingDir, request.PathExtension,
+                        request.EnvironmentVariables, line =>
+                        {
+                            lock (writer)
+                            {
+                                writer.Write(RemoteAgentProtocol.OutputLineMessage);
+                                writer.Write(line);
+                            }
+                        });
+
+                    lock (writer)
+                    {
+                        writer.Write(RemoteAgentProtocol.ExitCodeMessage);
+                        writer.Write(exitCode);
+                        writer.Flush();
+                    }
+                }
+                catch (Exception e) when (e is IOException || e is ObjectDisposedException)
+                {
+                    _logger.LogWarning($"Lost connection to {remoteEndPoint}: {e.Message}");
+                }
+                catch (Exception e)
+                {
+                    _logger.LogError($"Could not execute command for {remoteEndPoint}: {e.Message}");
+                    TrySendError(writer, e.Message);
+                }
+            }
+        }
+
+        /// <exception cref="UnauthorizedAccessException">if the command is not an executable within the test directory</exception>
+        private void VerifyCommand(string command)
+        {
+            string fullPath = Path.IsPathRooted(command) ? Path.GetFullPath(command) : null;
+            if (fullPath == null
+                || !fullPath.StartsWith(_testDirectory, StringComparison.OrdinalIgnoreCase)
+                || !string.Equals(Path.GetExtension(fullPath), ".exe", StringComparison.OrdinalIgnoreCase)
+                || !File.Exists(fullPath))
+                throw new UnauthorizedAccessException($"Command {command} is not a test executable within {_testDirectory}");
+        }
+
+        /// <summary>
+        /// The adapter does not send anything after its request except for cancel messages,
+        /// so reading returns as soon as the command is to be canceled or the connection is closed.
+        /// A cancel request arriving before the process has been started is remembered by the executor.
+        /// </summary>
+        private void WaitForCancellation(NetworkStream stream, DotNetProcessExecutor executor)
+        {
+            try
+            {
+                stream.ReadByte();
+            }
+            catch (Exception e) when (e is IOException || e is ObjectDisposedException)
+            {
+                // connection has been closed by the agent after the command has finished
+                return;
+            }
+
+            executor.Cancel();
+        }
+
+        private void TrySendError(BinaryWriter writer, string message)
+        {
+            try
+            {
+                lock (writer)
+                {
+                    writer.Write(RemoteAgentProtocol.ErrorMessage);
+                    writer.Write(message);
+                    writer.Flush();
+                }
+            }
+            catch (Exception e) when (e is IOException || e is ObjectDisposedException)
+            {
+                _logger.DebugWarning($"Could not report error to adapter: {e.Message}");
+            }
+        }
+
+    }
+
+}
@@ -0,0 +1,146 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Net;
+using System.Net.Sockets;
+using System.Text;
+using GoogleTestAdapter.Common;
+using GoogleTestAdapter.ProcessExecution.Contracts;
+
+namespace GoogleTestAdapter.ProcessExecution
+{
+    /// <summary>
+    /// Executes commands on a remote agent (see RemoteAgentServer). Files passed to the command (e.g. the result
+    /// XML file) must be accessible by the agent under the same path, and the agent must have been started with
+    /// the same secret.
+    /// </summary>
+    public class RemoteProcessExecutor : IProcessExecutor
+    {
+        private readonly DnsEndPoint _agent;
+        private readonly string _secret;
+        private readonly bool _printTestOutput;
+        private readonly ILogger _logger;
+
+        private NetworkStream _stream;
+        private bool _canceled;
+
+        public RemoteProcessExecutor(DnsEndPoint agent, string secret, bool printTestOutput, ILogger logger)
+        {
+            _agent = agent;
+            _secret = secret;
+            _printTestOutput = printTestOutput;
+            _logger = logger;
+        }
+
+        /// <exception cref="IOException">if the agent can not be reached or reports an error</exception>
+        public int ExecuteCommandBlocking(string command, string parameters, string workingDir, string pathExtension, IDictionary<string, string> environmentVariables,
+            Action<string> reportOutputLine)
+        {
+            var request = new RemoteExecutionRequest
+            {
+                Command = command,
+                Parameters = parameters,
+                WorkingDir = workingDir,
+                PathExtension = pathExtension
+            };
+            foreach (KeyValuePair<string, string> environmentVariable in environmentVariables)
+            {
+                request.EnvironmentVariables[environmentVariable.Key] = environmentVariable.Value;
+            }
+
+            try
+            {
+                using (var client = new TcpClient())
+                {
+                    client.NoDelay = true;
+                    client.Connect(_agent.Host, _agent.Port);
+
+                    NetworkStream stream = client.GetStream();
+                    using (var writer = new BinaryWriter(stream, Encoding.UTF8, true))
+                    using (var reader = new BinaryReader(stream, Encoding.UTF8, true))
+                    {
+                        byte[] challenge = RemoteAgentProtocol.AnswerChallenge(reader, writer, _secret);
+                        lock (this)
+                        {
+                            RemoteAgentProtocol.WriteRequest(writer, request, _secret, challenge);
+                            _stream = stream;
+                            if (_canceled)
+                                SendCancelMessage();
+                        }
+                        if (_printTestOutput)
+                            DotNetProcessExecutor.LogStartOfOutput(_logger, command, parameters);
+
+                        int exitCode = ReadMessages(reader, reportOutputLine);
+
+                        if (_printTestOutput)
+                            DotNetProcessExecutor.LogEndOfOutput(_logger);
+                        _logger.DebugInfo($"Executable {command} returned with exit code {exitCode} on remote agent {_agent.Host}:{_agent.Port}");
+                        return exitCode;
+                    }
+                }
+            }
+            catch (SocketException e)
+            {
+                throw new IOException($"Could not execute command on remote agent {_agent.Host}:{_agent.Port}: {e.Message}", e);
+            }
+            finally
+            {
+                lock (this)
+                {
+                    _stream = null;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Makes the agent kill the process (tree) executing the command.
+        /// </summary>
+        public void Cancel()
+        {
+            lock (this)
+            {
+                _canceled = true;
+                if (_stream != null)
+                    SendCancelMessage();
+            }
+        }
+
+
+        private void SendCancelMessage()
+        {
+            try
+            {
+                _stream.WriteByte(RemoteAgentProtocol.CancelMessage);
+            }
+            catch (Exception e) when (e is IOException || e is ObjectDisposedException)
+            {
+                _logger.DebugWarning($"Could not cancel command on remote agent {_agent.Host}:{_agent.Port}: {e.Message}");
+            }
+        }
+
+        private int ReadMessages(BinaryReader reader, Action<string> reportOutputLine)
+        {
+            while (true)
+            {
+                byte messageType = reader.ReadByte();
+                switch (messageType)
+                {
+                    case RemoteAgentProtocol.OutputLineMessage:
+                        string line = reader.ReadString();
+                        reportOutputLine?.Invoke(line);
+                        if (_printTestOutput)
+                            _logger.LogInfo(line);
+                        break;
+                    case RemoteAgentProtocol.ExitCodeMessage:
+                        return reader.ReadInt32();
+                    case RemoteAgentProtocol.ErrorMessage:
+                        throw new IOException($"Remote agent {_agent.Host}:{_agent.Port} could not execute command: {reader.ReadString()}");
+                    default:
+                        throw new IOException($"Remote agent {_agent.Host}:{_agent.Port} sent unknown message type {messageType}");
+                }
+            }
+        }
+
+    }
+
+}
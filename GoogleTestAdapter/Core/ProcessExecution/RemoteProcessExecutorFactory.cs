@@ -0,0 +1,46 @@
+﻿using System.Net;
+using GoogleTestAdapter.Common;
+using GoogleTestAdapter.ProcessExecution.Contracts;
+
+namespace GoogleTestAdapter.ProcessExecution
+{
+    /// <summary>
+    /// Creates executors which run commands on a remote agent. Since a remote process can not be debugged,
+    /// debugging executors are created by the local factory.
+    /// </summary>
+    public class RemoteProcessExecutorFactory : IDebuggedProcessExecutorFactory
+    {
+        private readonly DnsEndPoint _agent;
+        private readonly string _secret;
+        private readonly IDebuggedProcessExecutorFactory _localFactory;
+
+        public RemoteProcessExecutorFactory(DnsEndPoint agent, string secret, IDebuggedProcessExecutorFactory localFactory)
+        {
+            _agent = agent;
+            _secret = secret;
+            _localFactory = localFactory;
+        }
+
+        /// <summary>
+        /// Creates executors of local processes, e.g. for test setup and teardown batches (agents only execute test executables).
+        /// </summary>
+        public IDebuggedProcessExecutorFactory LocalFactory => _localFactory;
+
+        public IProcessExecutor CreateExecutor(bool printTestOutput, ILogger logger)
+        {
+            return new RemoteProcessExecutor(_agent, _secret, printTestOutput, logger);
+        }
+
+        public IDebuggedProcessExecutor CreateFrameworkDebuggingExecutor(bool printTestOutput, ILogger logger)
+        {
+            return _localFactory.CreateFrameworkDebuggingExecutor(printTestOutput, logger);
+        }
+
+        public IDebuggedProcessExecutor CreateNativeDebuggingExecutor(DebuggerEngine debuggerEngine, bool printTestOutput, ILogger logger)
+        {
+            return _localFactory.CreateNativeDebuggingExecutor(debuggerEngine, printTestOutput, logger);
+        }
+
+    }
+
+}
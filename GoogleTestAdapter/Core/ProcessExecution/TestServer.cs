@@ -0,0 +1,150 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Text;
+using GoogleTestAdapter.Common;
+using GoogleTestAdapter.Helpers;
+
+namespace GoogleTestAdapter.ProcessExecution
+{
+    /// <summary>
+    /// A test executable which has been started in test server mode (see GTA_TestServer.h). The server process
+    /// keeps running and executes one batch of tests per filter written to its stdin, thus avoiding process startup
+    /// and static initialization for every batch. Results are written to the same result XML file for every batch.
+    /// The end of a batch is marked on stdout and stderr; the streams are kept apart such that lines of a stream
+    /// are attributed to the batch they have been written by, whichever stream is read first.
+    /// </summary>
+    public class TestServer : IDisposable
+    {
+        public const string EnvironmentVariable = "GTA_TEST_SERVER";
+        public const string BatchFinishedMarker = "GTA_TEST_SERVER_BATCH_FINISHED:";
+        public const string ExitCommand = "GTA_TEST_SERVER_EXIT";
+
+        private const int ShutdownTimeoutInMs = 5000;
+
+        private readonly string _executable;
+        private readonly ILogger _logger;
+        private readonly Process _process;
+        private readonly BlockingCollection<string> _outputLines = new BlockingCollection<string>();
+        private readonly BlockingCollection<string> _errorLines = new BlockingCollection<string>();
+
+        public TestServer(string executable, string parameters, string workingDir, string pathExtension,
+            IDictionary<string, string> environmentVariables, string resultXmlFile, ILogger logger)
+        {
+            _executable = executable;
+            _logger = logger;
+            ResultXmlFile = resultXmlFile;
+
+            var processStartInfo = new ProcessStartInfo(executable, parameters)
+            {
+                StandardOutputEncoding = Encoding.Default,
+                RedirectStandardInput = true,
+                RedirectStandardOutput = true,
+                RedirectStandardError = true,
+                UseShellExecute = false,
+                CreateNoWindow = true,
+                WorkingDirectory = workingDir
+            };
+
+            if (!string.IsNullOrEmpty(pathExtension))
+                processStartInfo.EnvironmentVariables["PATH"] = Utils.GetExtendedPath(pathExtension);
+
+            foreach (var environmentVariable in environmentVariables)
+                processStartInfo.EnvironmentVariables[environmentVariable.Key] = environmentVariable.Value;
+            processStartInfo.EnvironmentVariables[EnvironmentVariable] = "1";
+
+            _process = new Process { StartInfo = processStartInfo };
+            _process.OutputDataReceived += (sender, e) => HandleOutputLine(_outputLines, e.Data);
+            _process.ErrorDataReceived += (sender, e) => HandleOutputLine(_errorLines, e.Data);
+            _process.Start();
+            _process.BeginOutputReadLine();
+            _process.BeginErrorReadLine();
+
+            _logger.DebugInfo($"Started test server for executable {executable}, process id {_process.Id}");
+        }
+
+        public string ResultXmlFile { get; }
+
+        public bool IsRunning => !_outputLines.IsCompleted && !_errorLines.IsCompleted;
+
+        /// <summary>
+        /// Runs the tests matching the given filter. All output of the batch is passed to reportOutputLine: first the
+        /// lines written to stdout, then the ones written to stderr. Returns the result of RUN_ALL_TESTS(), or the exit
+        /// code of the server process if it has terminated (e.g. because a test crashed); in the latter case, the
+        /// server can not be used any more.
+        /// </summary>
+        public int RunBatch(string filter, Action<string> reportOutputLine)
+        {
+            if (!IsRunning)
+                throw new InvalidOperationException($"Test server for executable {_executable} is not running");
+
+            _process.StandardInput.WriteLine(filter);
+            _process.StandardInput.Flush();
+
+            int? result = ReadBatchOutput(_outputLines, reportOutputLine);
+            // stderr is only read up to its marker, such that late lines are not attributed to the next batch
+            ReadBatchOutput(_errorLines, reportOutputLine);
+            if (result.HasValue)
+                return result.Value;
+
+            _process.WaitForExit();
+            _logger.DebugInfo($"Test server for executable {_executable} terminated with exit code {_process.ExitCode}");
+            return _process.ExitCode;
+        }
+
+        public void Cancel()
+        {
+            ProcessUtils.KillProcessTree(_process.Id, _logger);
+        }
+
+        public void Dispose()
+        {
+            try
+            {
+                if (IsRunning)
+                {
+                    _process.StandardInput.WriteLine(ExitCommand);
+                    _process.StandardInput.Close();
+                    if (!_process.WaitForExit(ShutdownTimeoutInMs))
+                    {
+                        _logger.DebugWarning($"Test server for executable {_executable} did not terminate within {ShutdownTimeoutInMs}ms");
+                        Cancel();
+                    }
+                }
+            }
+            catch (Exception e)
+            {
+                _logger.DebugWarning($"Exception while shutting down test server for executable {_executable}: {e.Message}");
+            }
+            finally
+            {
+                _process.Dispose();
+            }
+        }
+
+        /// <summary>
+        /// Returns the result reported with the stream's batch finished marker, or null if the stream has been closed
+        /// </summary>
+        private static int? ReadBatchOutput(BlockingCollection<string> lines, Action<string> reportOutputLine)
+        {
+            foreach (string line in lines.GetConsumingEnumerable())
+            {
+                if (line.StartsWith(BatchFinishedMarker) && int.TryParse(line.Substring(BatchFinishedMarker.Length), out int result))
+                    return result;
+                reportOutputLine?.Invoke(line);
+            }
+            return null;
+        }
+
+        private static void HandleOutputLine(BlockingCollection<string> lines, string line)
+        {
+            if (line != null)
+                lines.Add(line);
+            else
+                lines.CompleteAdding();
+        }
+
+    }
+
+}
@@ -0,0 +1,249 @@
+#pragma once
+
+#include "gtest\gtest.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#ifdef _WIN32
+// prevent windows.h from defining min() and max() macros in the including test code
+#ifndef NOMINMAX
+#define NOMINMAX
+#define GTA_UNDEF_NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#include <share.h>
+#ifdef GTA_UNDEF_NOMINMAX
+#undef NOMINMAX
+#undef GTA_UNDEF_NOMINMAX
+#endif
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+/*
+ * Structured event stream for the Google Test Adapter.
+ *
+ * Call gta::InstallEventListener() after ::testing::InitGoogleTest() (or use GTA_EVENT_LISTENER_MAIN() as your
+ * main() function). If started by the adapter, environment variable GTA_EVENT_STREAM contains the name of a file
+ * (or pipe) to which the listener writes one binary record per test event; the adapter then creates its test results
+ * from these records instead of parsing the console output. If the variable is not set, nothing is installed.
+ *
+ * Format (all integers little endian):
+ *   record  := uint32 payload length, uint8 record type, payload
+ *   string  := uint32 length in bytes, UTF-8 bytes
+ *   type 1 (test start):   string full test name
+ *   type 2 (test failure): string file (empty if unknown), int32 line (-1 if unknown), string message
+ *   type 3 (test end):     string full test name, uint8 outcome (0: passed, 1: failed, 2: skipped), uint64 duration in us
+ *   type 4 (resources):    string full test name, uint64 user time in us, uint64 kernel time in us, uint64 peak memory in bytes,
+ *                          uint64 page faults, uint64 bytes read, uint64 bytes written
+ *
+ * Record type 4 is written right before the test end record. All values except peak memory are the deltas of the
+ * test; peak memory is the peak committed memory (private bytes) of the process up to the end of the test, which
+ * is the metric the adapter measures for whole test executables, too. On platforms without commit charge, it is the
+ * peak resident set size.
+ * Define GTA_EVENT_STREAM_NO_RESOURCE_USAGE to not write such records.
+ */
+
+#define GTA_EVENT_STREAM_ENV_VAR "GTA_EVENT_STREAM"
+
+
+namespace gta {
+
+  class EventStreamListener : public ::testing::EmptyTestEventListener {
+  public:
+    explicit EventStreamListener(FILE* stream) : stream_(stream) {}
+
+    ~EventStreamListener() override {
+      fclose(stream_);
+    }
+
+    void OnTestStart(const ::testing::TestInfo& test_info) override {
+      start_ = std::chrono::steady_clock::now();
+#ifndef GTA_EVENT_STREAM_NO_RESOURCE_USAGE
+      start_usage_ = GetResourceUsage();
+#endif
+
+      std::string payload;
+      AppendString(payload, GetFullName(test_info));
+      WriteRecord(kTestStart, payload);
+    }
+
+    void OnTestPartResult(const ::testing::TestPartResult& result) override {
+      if (!result.failed())
+        return;
+
+      std::string payload;
+      AppendString(payload, result.file_name() != nullptr ? result.file_name() : "");
+      AppendInt(payload, static_cast<uint32_t>(result.line_number()), 4);
+      AppendString(payload, result.message() != nullptr ? result.message() : "");
+      WriteRecord(kTestFailure, payload);
+    }
+
+    void OnTestEnd(const ::testing::TestInfo& test_info) override {
+      auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_);
+
+#ifndef GTA_EVENT_STREAM_NO_RESOURCE_USAGE
+      ResourceUsage usage = GetResourceUsage();
+      std::string usage_payload;
+      AppendString(usage_payload, GetFullName(test_info));
+      AppendInt(usage_payload, usage.user_time_us - start_usage_.user_time_us, 8);
+      AppendInt(usage_payload, usage.kernel_time_us - start_usage_.kernel_time_us, 8);
+      AppendInt(usage_payload, usage.peak_memory_bytes, 8);
+      AppendInt(usage_payload, usage.page_faults - start_usage_.page_faults, 8);
+      AppendInt(usage_payload, usage.read_bytes - start_usage_.read_bytes, 8);
+      AppendInt(usage_payload, usage.write_bytes - start_usage_.write_bytes, 8);
+      WriteRecord(kTestResourceUsage, usage_payload);
+#endif
+
+      std::string payload;
+      AppendString(payload, GetFullName(test_info));
+      payload.push_back(static_cast<char>(GetOutcome(*test_info.result())));
+      AppendInt(payload, static_cast<uint64_t>(duration.count()), 8);
+      WriteRecord(kTestEnd, payload);
+    }
+
+  private:
+    static const uint8_t kTestStart = 1;
+    static const uint8_t kTestFailure = 2;
+    static const uint8_t kTestEnd = 3;
+    static const uint8_t kTestResourceUsage = 4;
+
+    struct ResourceUsage {
+      uint64_t user_time_us = 0;
+      uint64_t kernel_time_us = 0;
+      uint64_t peak_memory_bytes = 0;
+      uint64_t page_faults = 0;
+      uint64_t read_bytes = 0;
+      uint64_t write_bytes = 0;
+    };
+
+#ifdef _WIN32
+    static uint64_t ToMicroseconds(const FILETIME& time) {
+      return ((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 10;
+    }
+
+    static ResourceUsage GetResourceUsage() {
+      ResourceUsage usage;
+      HANDLE process = GetCurrentProcess();
+
+      FILETIME creation_time, exit_time, kernel_time, user_time;
+      if (GetProcessTimes(process, &creation_time, &exit_time, &kernel_time, &user_time)) {
+        usage.user_time_us = ToMicroseconds(user_time);
+        usage.kernel_time_us = ToMicroseconds(kernel_time);
+      }
+
+      PROCESS_MEMORY_COUNTERS memory_counters;
+      if (GetProcessMemoryInfo(process, &memory_counters, sizeof(memory_counters))) {
+        usage.peak_memory_bytes = memory_counters.PeakPagefileUsage;
+        usage.page_faults = memory_counters.PageFaultCount;
+      }
+
+      IO_COUNTERS io_counters;
+      if (GetProcessIoCounters(process, &io_counters)) {
+        usage.read_bytes = io_counters.ReadTransferCount;
+        usage.write_bytes = io_counters.WriteTransferCount;
+      }
+      return usage;
+    }
+#else
+    // getrusage() reports I/O in blocks of 512 bytes and the peak resident set size in kilobytes
+    static ResourceUsage GetResourceUsage() {
+      ResourceUsage usage;
+      struct rusage rusage;
+      if (getrusage(RUSAGE_SELF, &rusage) == 0) {
+        usage.user_time_us = static_cast<uint64_t>(rusage.ru_utime.tv_sec) * 1000000 + rusage.ru_utime.tv_usec;
+        usage.kernel_time_us = static_cast<uint64_t>(rusage.ru_stime.tv_sec) * 1000000 + rusage.ru_stime.tv_usec;
+        usage.peak_memory_bytes = static_cast<uint64_t>(rusage.ru_maxrss) * 1024;
+        usage.page_faults = static_cast<uint64_t>(rusage.ru_minflt) + rusage.ru_majflt;
+        usage.read_bytes = static_cast<uint64_t>(rusage.ru_inblock) * 512;
+        usage.write_bytes = static_cast<uint64_t>(rusage.ru_oublock) * 512;
+      }
+      return usage;
+    }
+#endif
+
+    static std::string GetFullName(const ::testing::TestInfo& test_info) {
+      return std::string(test_info.test_case_name()) + "." + test_info.name();
+    }
+
+    static uint8_t GetOutcome(const ::testing::TestResult& result) {
+#ifdef GTEST_SKIP
+      if (result.Skipped())
+        return 2;
+#endif
+      return result.Failed() ? 1 : 0;
+    }
+
+    static void AppendInt(std::string& buffer, uint64_t value, int nrOfBytes) {
+      for (int i = 0; i < nrOfBytes; i++)
+        buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+
+    static void AppendString(std::string& buffer, const std::string& value) {
+      AppendInt(buffer, value.size(), 4);
+      buffer.append(value);
+    }
+
+    // records are flushed immediately such that the adapter can identify the test which has crashed the executable
+    void WriteRecord(uint8_t type, const std::string& payload) {
+      std::string header;
+      AppendInt(header, payload.size(), 4);
+      header.push_back(static_cast<char>(type));
+
+      fwrite(header.data(), 1, header.size(), stream_);
+      fwrite(payload.data(), 1, payload.size(), stream_);
+      fflush(stream_);
+    }
+
+    FILE* stream_;
+    std::chrono::steady_clock::time_point start_;
+    ResourceUsage start_usage_;
+  };
+
+  inline std::string GetEventStreamName() {
+#ifdef _MSC_VER
+    char* value = nullptr;
+    size_t length = 0;
+    std::string name = _dupenv_s(&value, &length, GTA_EVENT_STREAM_ENV_VAR) == 0 && value != nullptr ? value : "";
+    free(value);
+    return name;
+#else
+    const char* value = std::getenv(GTA_EVENT_STREAM_ENV_VAR);
+    return value != nullptr ? value : "";
+#endif
+  }
+
+  inline void InstallEventListener() {
+    std::string name = GetEventStreamName();
+    if (name.empty())
+      return;
+
+    FILE* stream = nullptr;
+#ifdef _MSC_VER
+    // unlike fopen_s(), allows the adapter to read the stream while the tests are running
+    stream = _fsopen(name.c_str(), "wb", _SH_DENYNO);
+#else
+    stream = fopen(name.c_str(), "wb");
+#endif
+    if (stream == nullptr)
+      return;
+
+    // the listener is owned (and thus deleted) by Google Test
+    ::testing::UnitTest::GetInstance()->listeners().Append(new EventStreamListener(stream));
+  }
+
+}
+
+
+#define GTA_EVENT_LISTENER_MAIN() \
+  int main(int argc, char** argv) { \
+    ::testing::InitGoogleTest(&argc, argv); \
+    gta::InstallEventListener(); \
+    return RUN_ALL_TESTS(); \
+  }
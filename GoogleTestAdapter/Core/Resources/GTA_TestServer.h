@@ -0,0 +1,84 @@
+#pragma once
+
+#include "gtest\gtest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+/*
+ * Test server for the Google Test Adapter (option "Use test server").
+ *
+ * Replace your main() function by GTA_TEST_SERVER_MAIN(), or call gta::RunTestsOrTestServer(argc, argv)
+ * from it. If started normally, the executable behaves exactly like a Google Test executable. If started by
+ * the adapter with environment variable GTA_TEST_SERVER=1, it keeps running and reads one test filter per line
+ * from stdin (an empty line runs all tests). After running the tests of a filter, it prints a line
+ * 'GTA_TEST_SERVER_BATCH_FINISHED:<result of RUN_ALL_TESTS()>' to stdout and to stderr (such that the adapter
+ * can attribute the output of both streams to the right batch). It terminates at the end of stdin or if it
+ * reads a line 'GTA_TEST_SERVER_EXIT'.
+ *
+ * Caveats: Google Test documents RUN_ALL_TESTS() as to be called only once, while the test server calls it once
+ * per filter. This relies on RUN_ALL_TESTS() clearing the previous results and re-applying the filter on every
+ * call (just like it does for every iteration of --gtest_repeat), which is the case since Google Test 1.8; the
+ * server therefore refuses to compile with older versions (which lack --gtest_flagfile). Even so, nothing but
+ * the test results is reset between filters: global test environments are set up and torn down for every
+ * filter, listeners receive the events of every filter, static and global state of your tests (including
+ * suites' static members) is kept, and code following RUN_ALL_TESTS() in your main() is not executed per
+ * filter. Only use the test server for tests which do not depend on a fresh process.
+ */
+
+#define GTA_TEST_SERVER_ENV_VAR "GTA_TEST_SERVER"
+#define GTA_TEST_SERVER_BATCH_FINISHED "GTA_TEST_SERVER_BATCH_FINISHED:"
+#define GTA_TEST_SERVER_EXIT "GTA_TEST_SERVER_EXIT"
+
+
+namespace gta {
+
+  inline bool IsTestServerRequested() {
+#ifdef _MSC_VER
+    char* value = nullptr;
+    size_t length = 0;
+    bool requested = _dupenv_s(&value, &length, GTA_TEST_SERVER_ENV_VAR) == 0 && value != nullptr && std::string(value) == "1";
+    free(value);
+    return requested;
+#else
+    const char* value = std::getenv(GTA_TEST_SERVER_ENV_VAR);
+    return value != nullptr && std::string(value) == "1";
+#endif
+  }
+
+  inline int RunTestServer() {
+    // repeated calls of RUN_ALL_TESTS() require Google Test 1.8 or later (see above), which introduced this flag
+    static_cast<void>(::testing::GTEST_FLAG(flagfile));
+
+    int result = 0;
+    std::string filter;
+    while (std::getline(std::cin, filter)) {
+      if (!filter.empty() && filter[filter.size() - 1] == '\r')
+        filter.erase(filter.size() - 1);
+      if (filter == GTA_TEST_SERVER_EXIT)
+        break;
+
+      ::testing::GTEST_FLAG(filter) = filter.empty() ? "*" : filter;
+      result = RUN_ALL_TESTS();
+
+      fflush(stdout);
+      std::cout << GTA_TEST_SERVER_BATCH_FINISHED << result << std::endl;
+      std::cerr << GTA_TEST_SERVER_BATCH_FINISHED << result << std::endl;
+    }
+    return result;
+  }
+
+  inline int RunTestsOrTestServer(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return IsTestServerRequested() ? RunTestServer() : RUN_ALL_TESTS();
+  }
+
+}
+
+
+#define GTA_TEST_SERVER_MAIN() \
+  int main(int argc, char** argv) { \
+    return gta::RunTestsOrTestServer(argc, argv); \
+  }
@@ -16,14 +16,30 @@ namespace GoogleTestAdapter.Runners
             public IList<TestCase> TestCases { get; }
             public string CommandLine { get; }
 
-            internal Args(IList<TestCase> testCases, string commandLine)
+            /// <summary>
+            /// The flag file referenced by the command line, null if none is used.
+            /// </summary>
+            public string FlagFile { get; }
+
+            /// <summary>
+            /// The content the flag file has to be written with before the command line is executed.
+            /// </summary>
+            public string FlagFileContent { get; }
+
+            internal Args(IList<TestCase> testCases, string commandLine, string flagFile = null, string flagFileContent = null)
             {
                 TestCases = testCases ?? new List<TestCase>();
                 CommandLine = commandLine ?? "";
+                FlagFile = flagFile;
+                FlagFileContent = flagFileContent;
             }
         }
 
-        // TODO change to new MaxCommandLength asa only ProcessExecutor is used (32768, see https://msdn.microsoft.com/en-us/library/windows/desktop/ms682425%28v=vs.85%29.aspx?f=255&MSPPError=-2147217396)
+        /// <summary>
+        /// The maximum length of cmd.exe's command lines, which is also used for command lines started with CreateProcess()
+        /// (which would allow 32767 characters) since they are passed on to debuggers and remote agents. Longer filters are
+        /// passed via --gtest_flagfile if the executable supports that option.
+        /// </summary>
         public const int MaxCommandLength = 8191;
         private const string _suiteDelimiter = ".*:";
         private readonly int _lengthOfExecutableString;
@@ -31,19 +47,98 @@ namespace GoogleTestAdapter.Runners
         private readonly string _resultXmlFile;
         private readonly SettingsWrapper _settings;
         private readonly string _userParameters;
+        private readonly IList<TestCase> _allTestCasesOfExecutable;
+        private readonly string _flagFile;
 
         public CommandLineGenerator(IEnumerable<TestCase> testCasesToRun,
             int lengthOfExecutableString, string userParameters, string resultXmlFile,
             SettingsWrapper settings)
+            : this(testCasesToRun, lengthOfExecutableString, userParameters, resultXmlFile, settings, null)
+        {
+        }
+
+        /// <param name="allTestCasesOfExecutable">All (discovered) tests of the executable. If provided, filters are
+        /// synthesized such that they select exactly the tests to run (see <see cref="TestFilterSynthesizer"/>).</param>
+        public CommandLineGenerator(IEnumerable<TestCase> testCasesToRun,
+            int lengthOfExecutableString, string userParameters, string resultXmlFile,
+            SettingsWrapper settings, IEnumerable<TestCase> allTestCasesOfExecutable)
+            : this(testCasesToRun, lengthOfExecutableString, userParameters, resultXmlFile, settings, allTestCasesOfExecutable, null)
+        {
+        }
+
+        /// <param name="flagFile">If provided, filters which do not fit into a single command line are passed to the executable
+        /// with --gtest_flagfile in this file, which has to be written by the caller (see <see cref="Args.FlagFileContent"/>).
+        /// Must only be used if the executable supports that option.</param>
+        public CommandLineGenerator(IEnumerable<TestCase> testCasesToRun,
+            int lengthOfExecutableString, string userParameters, string resultXmlFile,
+            SettingsWrapper settings, IEnumerable<TestCase> allTestCasesOfExecutable, string flagFile)
         {
             _lengthOfExecutableString = lengthOfExecutableString;
             _testCasesToRun = testCasesToRun.ToList();
+            _allTestCasesOfExecutable = allTestCasesOfExecutable?.Where(tc => !tc.IsExitCodeTestCase).ToList();
+            _flagFile = flagFile;
             _resultXmlFile = resultXmlFile;
             _settings = settings;
             _userParameters = userParameters ?? throw new ArgumentNullException(nameof(userParameters));
         }
 
         public IEnumerable<Args> GetCommandLines()
+        {
+            string baseCommandLine = GetBaseCommandLine();
+            var commandLines = new List<Args>();
+            commandLines.AddRange(GetFinalCommandLines(baseCommandLine));
+            if (commandLines.Count > 1 && _flagFile != null)
+            {
+                string filter = GetFilterForTestCasesToRun();
+                return GetArgsWithFlagFile(_testCasesToRun, baseCommandLine, filter, GetAdditionalUserParameter()).Yield();
+            }
+            return commandLines;
+        }
+
+        /// <summary>
+        /// Returns a single command line running the tests of the executable, e.g. for running one shard
+        /// of a natively sharded executable. A filter is only added if it can be synthesized and fits into
+        /// the command line; otherwise, all tests of the executable are run. The exit code test is not part
+        /// of the returned test cases.
+        /// </summary>
+        public Args GetCommandLineForShard()
+        {
+            List<TestCase> testCases = _testCasesToRun.Where(tc => !tc.IsExitCodeTestCase).ToList();
+            string baseCommandLine = GetBaseCommandLine();
+            string userParam = GetAdditionalUserParameter();
+
+            if (testCases.Count > 0 && !AllTestCasesOfExecutableAreRun(testCases))
+            {
+                Args args = GetArgsWithSynthesizedFilter(baseCommandLine, userParam, testCases);
+                if (args != null)
+                    return args;
+            }
+
+            return new Args(testCases, baseCommandLine + userParam);
+        }
+
+        /// <summary>
+        /// Returns the command line for starting a test server, i.e., all options but the filter.
+        /// </summary>
+        public string GetCommandLineForTestServer()
+        {
+            return GetBaseCommandLine() + GetAdditionalUserParameter();
+        }
+
+        /// <summary>
+        /// Returns the filter selecting all tests to run as the command line of the returned args. The filter
+        /// is meant to be passed to a test server and is thus not subject to the maximum command line length.
+        /// </summary>
+        public Args GetTestServerRequest()
+        {
+            List<TestCase> testCases = _testCasesToRun.Where(tc => !tc.IsExitCodeTestCase).ToList();
+            if (testCases.Count == 0 || AllTestCasesOfExecutableAreRun(testCases))
+                return new Args(testCases, "");
+
+            return new Args(testCases, SynthesizeFilter(testCases) ?? GetFilterForTestCasesToRun());
+        }
+
+        private string GetBaseCommandLine()
         {
             string baseCommandLine = GetOutputpathParameter();
             baseCommandLine += GetCatchExceptionsParameter();
@@ -51,10 +146,7 @@ namespace GoogleTestAdapter.Runners
             baseCommandLine += GetAlsoRunDisabledTestsParameter();
             baseCommandLine += GetShuffleTestsParameter();
             baseCommandLine += GetTestsRepetitionsParameter();
-
-            var commandLines = new List<Args>();
-            commandLines.AddRange(GetFinalCommandLines(baseCommandLine));
-            return commandLines;
+            return baseCommandLine;
         }
 
         private IEnumerable<Args> GetFinalCommandLines(string baseCommandLine)
@@ -72,12 +164,19 @@ namespace GoogleTestAdapter.Runners
 
             var commandLines = new List<Args>();
             string userParam = GetAdditionalUserParameter();
-            if (AllTestCasesOfExecutableAreRun())
+            if (AllTestCasesOfExecutableAreRun(_testCasesToRun))
             {
                 commandLines.Add(new Args(_testCasesToRun, baseCommandLine + userParam));
                 return commandLines;
             }
 
+            Args argsWithSynthesizedFilter = GetArgsWithSynthesizedFilter(baseCommandLine, userParam, _testCasesToRun);
+            if (argsWithSynthesizedFilter != null)
+            {
+                commandLines.Add(argsWithSynthesizedFilter);
+                return commandLines;
+            }
+
             List<string> suitesRunningAllTests = GetSuitesRunningAllTests();
             int maxSuiteLength = MaxCommandLength - _lengthOfExecutableString - userParam.Length - 1;
 
@@ -125,6 +224,47 @@ namespace GoogleTestAdapter.Runners
             return commandLines;
         }
 
+        /// <summary>
+        /// Returns null if all tests of the executable are not known, or if the synthesized filter does not fit into a single command line.
+        /// </summary>
+        private Args GetArgsWithSynthesizedFilter(string baseCommandLine, string userParam, IList<TestCase> testCases)
+        {
+            string filter = SynthesizeFilter(testCases);
+            if (filter == null)
+                return null;
+
+            string commandLine = baseCommandLine + GoogleTestConstants.FilterOption + filter + userParam;
+            if (commandLine.Length + _lengthOfExecutableString + 1 <= MaxCommandLength)
+                return new Args(testCases, commandLine);
+
+            return _flagFile != null ? GetArgsWithFlagFile(testCases, baseCommandLine, filter, userParam) : null;
+        }
+
+        private string SynthesizeFilter(IList<TestCase> testCases)
+        {
+            if (_allTestCasesOfExecutable == null)
+                return null;
+
+            return new TestFilterSynthesizer(_allTestCasesOfExecutable.Select(tc => tc.FullyQualifiedName))
+                .SynthesizeFilter(testCases.Select(tc => tc.FullyQualifiedName));
+        }
+
+        /// <summary>
+        /// Passes the filter in the flag file, such that its length is not restricted by the maximum command line length.
+        /// </summary>
+        private Args GetArgsWithFlagFile(IList<TestCase> testCases, string baseCommandLine, string filter, string userParam)
+        {
+            return new Args(testCases, baseCommandLine + GoogleTestConstants.GetFlagFileOption(_flagFile) + userParam,
+                _flagFile, GoogleTestConstants.FilterOption.TrimStart() + filter + Environment.NewLine);
+        }
+
+        private string GetFilterForTestCasesToRun()
+        {
+            List<string> suitesRunningAllTests = GetSuitesRunningAllTests();
+            IEnumerable<string> testNames = GetTestCasesNotRunBySuite(suitesRunningAllTests).Select(tc => tc.FullyQualifiedName);
+            return string.Join(":", suitesRunningAllTests.Select(suite => suite + ".*").Concat(testNames));
+        }
+
         private Args CreateDummyCommandLineArgs(string baseCommandLine, TestCase exitCodeTest)
         {
             string commandLine = baseCommandLine;
@@ -254,18 +394,18 @@ namespace GoogleTestAdapter.Runners
             return string.Join(_suiteDelimiter, suitesRunningAllTests).AppendIfNotEmpty(_suiteDelimiter);
         }
 
-        private bool AllTestCasesOfExecutableAreRun()
+        private bool AllTestCasesOfExecutableAreRun(IList<TestCase> testCases)
         {
-            if (!_testCasesToRun.Any())
+            if (!testCases.Any())
                 return true;
 
-            TestCaseMetaDataProperty metaData = _testCasesToRun.First().Properties
+            TestCaseMetaDataProperty metaData = testCases.First().Properties
                 .OfType<TestCaseMetaDataProperty>()
                 .SingleOrDefault();
             if (metaData == null)
-                throw new Exception($"Test does not have meta data: {_testCasesToRun.First()}");
+                throw new Exception($"Test does not have meta data: {testCases.First()}");
 
-            return _testCasesToRun.Count == metaData.NrOfTestCasesInExecutable;
+            return testCases.Count == metaData.NrOfTestCasesInExecutable;
         }
 
         private List<TestCase> GetTestCasesNotRunBySuite(List<string> suitesRunningAllTests)
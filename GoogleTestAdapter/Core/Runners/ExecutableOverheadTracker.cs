@@ -0,0 +1,116 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Text.RegularExpressions;
+using GoogleTestAdapter.Scheduling;
+
+namespace GoogleTestAdapter.Runners
+{
+    /// <summary>
+    /// Measures the overhead of a test executable from its console output: the time until the first test suite
+    /// starts, the time from the end of the last test until the process exits, and the time of every suite which
+    /// is not spent in its tests (as printed by Google Test in the '[----------] N tests from Suite (T ms total)' lines).
+    /// </summary>
+    public class ExecutableOverheadTracker
+    {
+        private static readonly Regex SuiteRegex = new Regex(@"^\[----------\] \d+ tests? from ([^ ,]+)(?:, where .*?)?(?: \((\d+) ms total\))?$");
+        // test end markers might be preceded by test output not terminated by a newline
+        private static readonly Regex TestEndRegex = new Regex(@"\[ *(?:OK|FAILED|SKIPPED) *\] ([^ ,]+).* \((\d+) ms\)$");
+
+        private readonly object _lock = new object();
+        private readonly IDictionary<string, int> _testDurationsOfSuites = new Dictionary<string, int>();
+        private readonly IDictionary<string, int> _suiteDurations = new Dictionary<string, int>();
+
+        private DateTime _processStart;
+        private DateTime? _firstSuiteStart;
+        private DateTime? _lastTestEnd;
+
+        public void Start()
+        {
+            Start(DateTime.UtcNow);
+        }
+
+        public void Start(DateTime now)
+        {
+            _processStart = now;
+        }
+
+        public void ReportLine(string line)
+        {
+            ReportLine(line, DateTime.UtcNow);
+        }
+
+        public void ReportLine(string line, DateTime now)
+        {
+            if (line == null)
+                return;
+
+            lock (_lock)
+            {
+                Match suiteMatch = SuiteRegex.Match(line);
+                if (suiteMatch.Success)
+                {
+                    if (_firstSuiteStart == null)
+                        _firstSuiteStart = now;
+
+                    if (suiteMatch.Groups[2].Success)
+                    {
+                        string suite = suiteMatch.Groups[1].Value;
+                        _testDurationsOfSuites.TryGetValue(suite, out int testDurations);
+                        _suiteDurations[suite] = Math.Max(0, int.Parse(suiteMatch.Groups[2].Value) - testDurations);
+                    }
+                    return;
+                }
+
+                Match testEndMatch = TestEndRegex.Match(line);
+                if (testEndMatch.Success)
+                {
+                    _lastTestEnd = now;
+
+                    string test = testEndMatch.Groups[1].Value;
+                    int suiteEnd = test.LastIndexOf('.');
+                    if (suiteEnd > 0)
+                    {
+                        string suite = test.Substring(0, suiteEnd);
+                        _testDurationsOfSuites.TryGetValue(suite, out int testDurations);
+                        _testDurationsOfSuites[suite] = testDurations + int.Parse(testEndMatch.Groups[2].Value);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Returns the overhead of the executable, which is supposed to have exited just now, or null if no test has been run.
+        /// </summary>
+        public ExecutableOverhead Stop()
+        {
+            return Stop(DateTime.UtcNow);
+        }
+
+        public ExecutableOverhead Stop(DateTime now)
+        {
+            lock (_lock)
+            {
+                if (_firstSuiteStart == null || _lastTestEnd == null)
+                    return null;
+
+                var overhead = new ExecutableOverhead
+                {
+                    StartupDuration = GetMilliseconds(_firstSuiteStart.Value - _processStart),
+                    ShutdownDuration = GetMilliseconds(now - _lastTestEnd.Value)
+                };
+                foreach (KeyValuePair<string, int> suiteDuration in _suiteDurations)
+                {
+                    overhead.SuiteDurations.Add(suiteDuration);
+                }
+                return overhead;
+            }
+        }
+
+        private static int GetMilliseconds(TimeSpan timeSpan)
+        {
+            return Math.Max(0, (int)Math.Round(timeSpan.TotalMilliseconds));
+        }
+
+    }
+
+}
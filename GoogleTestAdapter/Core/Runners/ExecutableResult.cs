@@ -1,5 +1,6 @@
 ﻿using System;
 using System.Collections.Generic;
+using GoogleTestAdapter.Model;
 
 namespace GoogleTestAdapter.Runners
 {
@@ -9,8 +10,9 @@ namespace GoogleTestAdapter.Runners
         public int ExitCode { get; }
         public IReadOnlyList<string> ExitCodeOutput { get; }
         public bool ExitCodeSkip { get; }
+        public ResourceUsage ResourceUsage { get; }
 
-        public ExecutableResult(string executable, int exitCode = 0, IList<string> exitCodeOutput = null, bool exitCodeSkip = false)
+        public ExecutableResult(string executable, int exitCode = 0, IList<string> exitCodeOutput = null, bool exitCodeSkip = false, ResourceUsage resourceUsage = null)
         {
             if (string.IsNullOrWhiteSpace(executable))
             {
@@ -21,6 +23,7 @@ namespace GoogleTestAdapter.Runners
             ExitCode = exitCode;
             ExitCodeOutput = (IReadOnlyList<string>) (exitCodeOutput ?? new List<string>());
             ExitCodeSkip = exitCodeSkip;
+            ResourceUsage = resourceUsage;
         }
     }
 }
\ No newline at end of file
@@ -1,12 +1,15 @@
 ﻿// This file has been modified by Microsoft on 6/2017.
 
+using System;
 using System.Collections.Generic;
 using System.Linq;
+using System.Net;
 using System.Threading;
 using GoogleTestAdapter.Common;
 using GoogleTestAdapter.Scheduling;
 using GoogleTestAdapter.Model;
 using GoogleTestAdapter.Framework;
+using GoogleTestAdapter.ProcessExecution;
 using GoogleTestAdapter.ProcessExecution.Contracts;
 using GoogleTestAdapter.Settings;
 
@@ -19,14 +22,26 @@ namespace GoogleTestAdapter.Runners
         private readonly SettingsWrapper _settings;
         private readonly List<ITestRunner> _testRunners = new List<ITestRunner>();
         private readonly SchedulingAnalyzer _schedulingAnalyzer;
+        private readonly IDictionary<string, List<TestCase>> _allTestCasesOfExecutables;
+
+        private AdaptiveConcurrencyController _concurrencyController;
+        private MemoryAdmissionController _memoryAdmission;
+        private ResourceLockManager _resourceLocks;
 
 
         public ParallelTestRunner(ITestFrameworkReporter reporter, ILogger logger, SettingsWrapper settings, SchedulingAnalyzer schedulingAnalyzer)
+            : this(reporter, logger, settings, schedulingAnalyzer, null)
+        {
+        }
+
+        public ParallelTestRunner(ITestFrameworkReporter reporter, ILogger logger, SettingsWrapper settings, SchedulingAnalyzer schedulingAnalyzer,
+            IDictionary<string, List<TestCase>> allTestCasesOfExecutables)
         {
             _frameworkReporter = reporter;
             _logger = logger;
             _settings = settings;
             _schedulingAnalyzer = schedulingAnalyzer;
+            _allTestCasesOfExecutables = allTestCasesOfExecutables;
         }
 
 
@@ -44,6 +59,57 @@ namespace GoogleTestAdapter.Runners
             {
                 thread.Join();
             }
+            _concurrencyController?.Dispose();
+            _memoryAdmission?.Dispose();
+
+            // ReSharper disable once InconsistentlySynchronizedField
+            foreach (var result in _testRunners.SelectMany(r => r.ExecutableResults))
+            {
+                ExecutableResults.Add(result);
+            }
+        }
+
+        /// <summary>
+        /// Runs tests while they are still being discovered: addTestCases is invoked with an action which adds tests to
+        /// be run (e.g. the tests of an executable as soon as its discovery has completed), and the tests are executed
+        /// by nrOfThreads threads as soon as they have been added. Returns when addTestCases has returned and all
+        /// added tests have been executed.
+        /// </summary>
+        public void RunTests(Action<Action<IList<TestCase>>> addTestCases, int nrOfThreads, bool isBeingDebugged,
+            IDebuggedProcessExecutorFactory processExecutorFactory)
+        {
+            var queue = new WorkStealingTestQueue(nrOfThreads);
+            var threads = new List<Thread>();
+            lock (this)
+            {
+                // constrained tests might be among the tests yet to be discovered
+                _resourceLocks = new ResourceLockManager();
+                _logger.LogInfo("Executing tests on " + nrOfThreads + " threads while discovering tests");
+                _concurrencyController = CreateConcurrencyController(nrOfThreads);
+                _memoryAdmission = CreateMemoryAdmission(nrOfThreads);
+                IList<CpuSet> cpuSets = CreateCpuSets(nrOfThreads);
+
+                for (int threadId = 0; threadId < nrOfThreads; threadId++)
+                {
+                    var runner = new PreparingTestRunner(threadId, _frameworkReporter, _logger, _settings.Clone(), _schedulingAnalyzer, CreateExecutionContext(queue, null, cpuSets?[threadId]));
+                    StartThread(runner, new TestCase[0], threads, threadId + 1, isBeingDebugged, processExecutorFactory);
+                }
+            }
+
+            try
+            {
+                addTestCases(testCases => queue.Add(testCases, ReadTestDurations(testCases as TestCase[] ?? testCases.ToArray())));
+            }
+            finally
+            {
+                queue.CompleteAdding();
+                foreach (Thread thread in threads)
+                {
+                    thread.Join();
+                }
+                _concurrencyController?.Dispose();
+                _memoryAdmission?.Dispose();
+            }
 
             // ReSharper disable once InconsistentlySynchronizedField
             foreach (var result in _testRunners.SelectMany(r => r.ExecutableResults))
@@ -62,6 +128,8 @@ namespace GoogleTestAdapter.Runners
                 {
                     runner.Cancel();
                 }
+                _concurrencyController?.Dispose();
+                _memoryAdmission?.Dispose();
             }
         }
 
@@ -69,53 +137,277 @@ namespace GoogleTestAdapter.Runners
         private void RunTests(IEnumerable<TestCase> testCasesToRun, List<Thread> threads, bool isBeingDebugged, IDebuggedProcessExecutorFactory processExecutorFactory)
         {
             TestCase[] testCasesToRunAsArray = testCasesToRun as TestCase[] ?? testCasesToRun.ToArray();
+            IDictionary<TestCase, int> durations = ReadTestDurations(testCasesToRunAsArray);
+            if (testCasesToRunAsArray.Any(ResourceLockManager.IsConstrained))
+                _resourceLocks = new ResourceLockManager();
 
-            ITestsSplitter splitter = GetTestsSplitter(testCasesToRunAsArray);
-            List<List<TestCase>> splittedTestCasesToRun = splitter.SplitTestcases();
+            var planner = new TestShardPlanner(testCasesToRunAsArray, _settings);
+            List<List<TestShard>> testShardsOfThreads = AssignTestShardsToThreads(planner.ShardedExecutables);
+            if (planner.ShardedExecutables.Count > 0)
+            {
+                var remainingTestCases = new HashSet<TestCase>(planner.RemainingTestCases);
+                testCasesToRunAsArray = planner.RemainingTestCases.ToArray();
+                durations = durations?
+                    .Where(kvp => remainingTestCases.Contains(kvp.Key))
+                    .ToDictionary(kvp => kvp.Key, kvp => kvp.Value);
+            }
 
-            _logger.LogInfo("Executing tests on " + splittedTestCasesToRun.Count + " threads");
+            IList<DnsEndPoint> remoteAgents = GetRemoteAgents(out string remoteAgentSecret);
+            if (remoteAgents.Count > 0)
+            {
+                RunTestsOnRemoteAgents(testCasesToRunAsArray, durations, testShardsOfThreads, remoteAgents, remoteAgentSecret, threads, isBeingDebugged, processExecutorFactory);
+                return;
+            }
+
+            if (_settings.WorkStealingTestExecution)
+            {
+                RunTestsWithWorkStealing(testCasesToRunAsArray, durations, testShardsOfThreads, threads, isBeingDebugged, processExecutorFactory);
+                return;
+            }
+
+            List<List<TestCase>> splittedTestCasesToRun = testCasesToRunAsArray.Length > 0
+                ? GetTestsSplitter(testCasesToRunAsArray, durations).SplitTestcases()
+                : new List<List<TestCase>>();
+            int nrOfThreads = Math.Max(splittedTestCasesToRun.Count, testShardsOfThreads.Count);
+
+            _logger.LogInfo("Executing tests on " + nrOfThreads + " threads");
             _logger.DebugInfo("Note that no test output will be shown on the test console when executing tests concurrently!");
+            _concurrencyController = CreateConcurrencyController(nrOfThreads);
+            _memoryAdmission = CreateMemoryAdmission(nrOfThreads);
+            IList<CpuSet> cpuSets = CreateCpuSets(nrOfThreads);
 
-            int threadId = 0;
-            foreach (List<TestCase> testcases in splittedTestCasesToRun)
+            for (int threadId = 0; threadId < nrOfThreads; threadId++)
+            {
+                List<TestCase> testcases = threadId < splittedTestCasesToRun.Count ? splittedTestCasesToRun[threadId] : new List<TestCase>();
+                List<TestShard> testShards = threadId < testShardsOfThreads.Count ? testShardsOfThreads[threadId] : null;
+                var runner = new PreparingTestRunner(threadId, _frameworkReporter, _logger, _settings.Clone(), _schedulingAnalyzer, CreateExecutionContext(null, testShards, cpuSets?[threadId]));
+                StartThread(runner, testcases, threads, threadId + 1, isBeingDebugged, processExecutorFactory);
+            }
+        }
+
+        private void RunTestsWithWorkStealing(TestCase[] testCasesToRun, IDictionary<TestCase, int> durations, List<List<TestShard>> testShardsOfThreads, 
+            List<Thread> threads, bool isBeingDebugged, IDebuggedProcessExecutorFactory processExecutorFactory)
+        {
+            var queue = new WorkStealingTestQueue(testCasesToRun, _settings.MaxNrOfThreads, durations);
+            int nrOfThreads = Math.Max(queue.NrOfThreads, testShardsOfThreads.Count);
+
+            _logger.LogInfo("Executing tests on " + nrOfThreads + " threads (work stealing)");
+            _logger.DebugInfo("Note that no test output will be shown on the test console when executing tests concurrently!");
+            _concurrencyController = CreateConcurrencyController(nrOfThreads);
+            _memoryAdmission = CreateMemoryAdmission(nrOfThreads);
+            IList<CpuSet> cpuSets = CreateCpuSets(nrOfThreads);
+
+            for (int threadId = 0; threadId < nrOfThreads; threadId++)
+            {
+                WorkStealingTestQueue queueOfThread = threadId < queue.NrOfThreads ? queue : null;
+                List<TestShard> testShards = threadId < testShardsOfThreads.Count ? testShardsOfThreads[threadId] : null;
+                var runner = new PreparingTestRunner(threadId, _frameworkReporter, _logger, _settings.Clone(), _schedulingAnalyzer, CreateExecutionContext(queueOfThread, testShards, cpuSets?[threadId]));
+                StartThread(runner, new TestCase[0], threads, threadId + 1, isBeingDebugged, processExecutorFactory);
+            }
+        }
+
+        /// <summary>
+        /// Each remote agent is served by a thread of its own which takes its tests from the shared queue; the local
+        /// machine's load is not relevant, so no concurrency controller is used. Shards are assigned to the agents round robin.
+        /// </summary>
+        private void RunTestsOnRemoteAgents(TestCase[] testCasesToRun, IDictionary<TestCase, int> durations, List<List<TestShard>> testShardsOfThreads,
+            IList<DnsEndPoint> remoteAgents, string remoteAgentSecret, List<Thread> threads, bool isBeingDebugged, IDebuggedProcessExecutorFactory processExecutorFactory)
+        {
+            var queue = new WorkStealingTestQueue(testCasesToRun, remoteAgents.Count, durations);
+            int nrOfThreads = Math.Max(queue.NrOfThreads, testShardsOfThreads.Count);
+
+            _logger.LogInfo($"Executing tests on {remoteAgents.Count} remote agents");
+            for (int threadId = 0; threadId < nrOfThreads; threadId++)
+            {
+                DnsEndPoint remoteAgent = remoteAgents[threadId % remoteAgents.Count];
+                _logger.DebugInfo($"Thread {threadId} executes tests on remote agent {remoteAgent.Host}:{remoteAgent.Port}");
+
+                WorkStealingTestQueue queueOfThread = threadId < queue.NrOfThreads ? queue : null;
+                List<TestShard> testShards = threadId < testShardsOfThreads.Count ? testShardsOfThreads[threadId] : null;
+                var runner = new PreparingTestRunner(threadId, _frameworkReporter, _logger, _settings.Clone(), _schedulingAnalyzer, new TestExecutionContext
+                {
+                    Queue = queueOfThread,
+                    TestShards = testShards,
+                    AllTestCasesOfExecutables = _allTestCasesOfExecutables,
+                    ResourceLocks = _resourceLocks
+                });
+                StartThread(runner, new TestCase[0], threads, threadId + 1, isBeingDebugged, new RemoteProcessExecutorFactory(remoteAgent, remoteAgentSecret, processExecutorFactory));
+            }
+        }
+
+        private IList<DnsEndPoint> GetRemoteAgents(out string secret)
+        {
+            secret = Environment.GetEnvironmentVariable(RemoteAgentProtocol.SecretEnvironmentVariable);
+            try
+            {
+                IList<DnsEndPoint> remoteAgents = RemoteAgentProtocol.ParseEndpoints(_settings.RemoteAgents);
+                if (remoteAgents.Count > 0 && string.IsNullOrEmpty(secret))
+                {
+                    _logger.LogError($"Environment variable {RemoteAgentProtocol.SecretEnvironmentVariable} must contain the secret shared with the remote agents - executing tests locally (option '{SettingsWrapper.OptionRemoteAgents}')");
+                    return new List<DnsEndPoint>();
+                }
+                return remoteAgents;
+            }
+            catch (FormatException e)
             {
-                var runner = new PreparingTestRunner(threadId++, _frameworkReporter, _logger, _settings.Clone(), _schedulingAnalyzer);
-                _testRunners.Add(runner);
+                _logger.LogError($"{e.Message} - executing tests locally (option '{SettingsWrapper.OptionRemoteAgents}')");
+                return new List<DnsEndPoint>();
+            }
+        }
+
+        private AdaptiveConcurrencyController CreateConcurrencyController(int nrOfThreads)
+        {
+            if (!_settings.AdaptiveConcurrency || nrOfThreads < 2)
+                return null;
+
+            try
+            {
+                var controller = new AdaptiveConcurrencyController(1, nrOfThreads, new PerformanceCounterMachineLoadSampler(), _logger);
+                controller.Start();
+                return controller;
+            }
+            catch (Exception e)
+            {
+                _logger.LogWarning($"Could not sample machine load, running tests without adaptive concurrency: {e.Message}");
+                return null;
+            }
+        }
+
+        private MemoryAdmissionController CreateMemoryAdmission(int nrOfThreads)
+        {
+            if (_settings.MemoryBudgetInMb <= 0 || nrOfThreads < 2)
+                return null;
+
+            _logger.DebugInfo($"Memory budget: starting test processes only if their predicted peak memory usage stays within {_settings.MemoryBudgetInMb}MB");
+            return new MemoryAdmissionController(_settings.MemoryBudgetInMb * 1024L * 1024L, _logger);
+        }
 
-                var thread = new Thread(
-                    () => runner.RunTests(testcases, isBeingDebugged, processExecutorFactory)){ Name = $"GTA Testrunner {threadId}" };
-                threads.Add(thread);
+        /// <summary>
+        /// Each thread gets a CPU set of its own; null if tests are not to be pinned to CPUs
+        /// </summary>
+        private IList<CpuSet> CreateCpuSets(int nrOfThreads)
+        {
+            if (!_settings.PinTestThreadsToCpus)
+                return null;
 
-                thread.Start();
+            IList<NumaNode> numaNodes = CpuSetPlanner.GetNumaNodes(_logger);
+            _logger.DebugInfo($"Processor topology: {string.Join("; ", numaNodes)}");
+            IList<CpuSet> cpuSets = new CpuSetPlanner(numaNodes).CreateCpuSets(nrOfThreads);
+            for (int threadId = 0; threadId < cpuSets.Count; threadId++)
+            {
+                _logger.DebugInfo($"Tests of thread {threadId} are pinned to processors {cpuSets[threadId]} (NUMA nodes {CpuSet.FormatNumbers(cpuSets[threadId].NumaNodes)})");
             }
+            return cpuSets.Count == nrOfThreads ? cpuSets : null;
         }
 
-        private ITestsSplitter GetTestsSplitter(TestCase[] testCasesToRun)
+        private TestExecutionContext CreateExecutionContext(WorkStealingTestQueue queue, IList<TestShard> testShards, CpuSet cpuSet)
+        {
+            return new TestExecutionContext
+            {
+                Queue = queue,
+                TestShards = testShards,
+                AllTestCasesOfExecutables = _allTestCasesOfExecutables,
+                ConcurrencyController = _concurrencyController,
+                MemoryAdmission = _memoryAdmission,
+                ResourceLocks = _resourceLocks,
+                CpuSet = cpuSet
+            };
+        }
+
+        /// <summary>
+        /// The shards of each executable are assigned to consecutive threads, continuing where the previous executable's
+        /// shards ended. Thus, if several executables are sharded, their first shards do not all end up on the first thread.
+        /// </summary>
+        private List<List<TestShard>> AssignTestShardsToThreads(IList<ShardedExecutable> shardedExecutables)
+        {
+            var testShardsOfThreads = new List<List<TestShard>>();
+            if (shardedExecutables.Count == 0)
+                return testShardsOfThreads;
+
+            int nrOfThreads = _settings.MaxNrOfThreads;
+            for (int i = 0; i < nrOfThreads; i++)
+            {
+                testShardsOfThreads.Add(new List<TestShard>());
+            }
+
+            int threadId = 0;
+            foreach (ShardedExecutable shardedExecutable in shardedExecutables)
+            {
+                _logger.DebugInfo($"Executing '{shardedExecutable.Executable}' in {shardedExecutable.NrOfShards} shards");
+                foreach (TestShard testShard in shardedExecutable.Shards)
+                {
+                    testShardsOfThreads[threadId].Add(testShard);
+                    threadId = (threadId + 1) % nrOfThreads;
+                }
+            }
+
+            return testShardsOfThreads.Where(shards => shards.Count > 0).ToList();
+        }
+
+        private void StartThread(ITestRunner runner, IEnumerable<TestCase> testcases, List<Thread> threads, int threadNr, bool isBeingDebugged, IDebuggedProcessExecutorFactory processExecutorFactory)
+        {
+            _testRunners.Add(runner);
+
+            var thread = new Thread(
+                () => runner.RunTests(testcases, isBeingDebugged, processExecutorFactory)){ Name = $"GTA Testrunner {threadNr}" };
+            threads.Add(thread);
+
+            thread.Start();
+        }
+
+        private IDictionary<TestCase, int> ReadTestDurations(TestCase[] testCasesToRun)
         {
-            IDictionary<TestCase, int> durations = null;
             try
             {
                 var serializer = new TestDurationSerializer();
-                durations = serializer.ReadTestDurations(testCasesToRun);
+                IDictionary<TestCase, int> durations = serializer.ReadTestDurations(testCasesToRun);
                 foreach (KeyValuePair<TestCase, int> duration in durations)
                 {
                     if (!_schedulingAnalyzer.AddExpectedDuration(duration.Key, duration.Value))
                         _logger.DebugWarning("TestCase already in analyzer: " + duration.Key.FullyQualifiedName);
                 }
+                return durations;
             }
             catch (InvalidTestDurationsException e)
             {
                 _logger.LogWarning($"Could not read test durations: {e.Message}");
+                return null;
             }
+        }
 
+        private IDictionary<string, ExecutableOverhead> ReadExecutableOverheads(TestCase[] testCasesToRun)
+        {
+            try
+            {
+                return new TestDurationSerializer().ReadExecutableOverheads(testCasesToRun.Select(tc => tc.Source));
+            }
+            catch (InvalidTestDurationsException e)
+            {
+                _logger.LogWarning($"Could not read executable overheads: {e.Message}");
+                return null;
+            }
+        }
+
+        private ITestsSplitter GetTestsSplitter(TestCase[] testCasesToRun, IDictionary<TestCase, int> durations)
+        {
             ITestsSplitter splitter;
-            if (durations == null || durations.Count < testCasesToRun.Length)
+            if (_settings.ExecutableAffinitySplitting)
+            {
+                splitter = new ExecutableAffinityTestsSplitter(testCasesToRun, durations, _settings, ReadExecutableOverheads(testCasesToRun));
+                _logger.DebugInfo("Using splitter based on executables and test durations");
+            }
+            else if (durations == null || durations.Count == 0)
             {
                 splitter = new NumberBasedTestsSplitter(testCasesToRun, _settings);
                 _logger.DebugInfo("Using splitter based on number of tests");
             }
             else
             {
+                if (durations.Count < testCasesToRun.Length)
+                {
+                    _logger.DebugInfo($"Estimating durations of {testCasesToRun.Length - durations.Count} tests which have not been run yet");
+                    durations = new TestDurationEstimator(durations).GetDurations(testCasesToRun);
+                }
                 splitter = new DurationBasedTestsSplitter(durations, _settings);
                 _logger.DebugInfo("Using splitter based on test durations");
             }
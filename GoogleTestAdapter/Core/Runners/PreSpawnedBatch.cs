@@ -0,0 +1,133 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Threading.Tasks;
+using GoogleTestAdapter.Common;
+using GoogleTestAdapter.ProcessExecution;
+using GoogleTestAdapter.Scheduling;
+using GoogleTestAdapter.TestResults;
+
+namespace GoogleTestAdapter.Runners
+{
+    /// <summary>
+    /// The output files and the (suspended) process created in advance for a batch of tests, such that the process
+    /// can be resumed as soon as the batch is run. Files which have not been used and processes which have not been
+    /// resumed are cleaned up on disposal.
+    /// </summary>
+    public sealed class PreSpawnedBatch : IDisposable
+    {
+        private readonly string _resultXmlFile;
+        private readonly string _flagFile;
+        private readonly string _eventStreamFile;
+        private readonly TestOutputFiles _outputFiles;
+        private readonly ILogger _logger;
+        private readonly string _threadName;
+
+        private Task<PreSpawningProcessExecutor> _processExecutor;
+        private bool _areFilesUsed;
+
+        public PreSpawnedBatch(string executable, string resultXmlFile, string flagFile, string eventStreamFile,
+            TestOutputFiles outputFiles, ILogger logger, string threadName)
+        {
+            Executable = executable;
+            _resultXmlFile = resultXmlFile;
+            _flagFile = flagFile;
+            _eventStreamFile = eventStreamFile;
+            _outputFiles = outputFiles;
+            _logger = logger;
+            _threadName = threadName;
+        }
+
+        public string Executable { get; }
+
+        /// <summary>
+        /// Creates the process on a background thread.
+        /// </summary>
+        public void PreSpawn(string parameters, string workingDir, string pathExtension, IDictionary<string, string> environmentVariables,
+            bool printTestOutput, CpuSet cpuSet)
+        {
+            _processExecutor = Task.Run(() =>
+            {
+                var executor = new PreSpawningProcessExecutor(printTestOutput, _logger) { CpuSet = cpuSet };
+                try
+                {
+                    executor.PreSpawn(Executable, parameters, workingDir, pathExtension, environmentVariables);
+                    return executor;
+                }
+                catch (Exception)
+                {
+                    executor.Dispose();
+                    throw;
+                }
+            });
+        }
+
+        /// <summary>
+        /// Hands out the output files the pre-spawned process has been created with (once), and points the event stream
+        /// environment variable to the batch's event stream file.
+        /// </summary>
+        public bool TryUseFiles(string executable, IDictionary<string, string> environmentVariables,
+            out string resultXmlFile, out string flagFile, out string eventStreamFile)
+        {
+            resultXmlFile = flagFile = eventStreamFile = null;
+            if (executable != Executable || _areFilesUsed)
+                return false;
+
+            _areFilesUsed = true;
+            resultXmlFile = _resultXmlFile;
+            flagFile = _flagFile;
+            eventStreamFile = _eventStreamFile;
+            if (eventStreamFile != null)
+                environmentVariables[EventStreamTestResultParser.EnvironmentVariable] = eventStreamFile;
+            return true;
+        }
+
+        /// <summary>
+        /// Returns the executor of the pre-spawned process if it has been created for exactly the given command; a process
+        /// created for another command is terminated. Returns null if process creation has failed or the process has already been taken.
+        /// </summary>
+        public PreSpawningProcessExecutor TakeProcessExecutor(string executable, string parameters, string workingDir, string pathExtension,
+            IDictionary<string, string> environmentVariables)
+        {
+            if (executable != Executable)
+                return null;
+
+            PreSpawningProcessExecutor executor = TakeProcessExecutor();
+            if (executor == null || executor.IsPreSpawnedFor(executable, parameters, workingDir, pathExtension, environmentVariables))
+                return executor;
+
+            _logger.DebugInfo($"{_threadName}Pre-spawned process of executable {executable} does not match the actual command, terminating it");
+            executor.Dispose();
+            return null;
+        }
+
+        public void Dispose()
+        {
+            TakeProcessExecutor()?.Dispose();
+            if (!_areFilesUsed)
+            {
+                _outputFiles.DeleteResultXmlFile(_resultXmlFile);
+                _outputFiles.DeleteFlagFile(_flagFile);
+                _outputFiles.DeleteEventStreamFile(_eventStreamFile);
+                _areFilesUsed = true;
+            }
+        }
+
+        /// <summary>
+        /// Waits until the process has been created
+        /// </summary>
+        private PreSpawningProcessExecutor TakeProcessExecutor()
+        {
+            Task<PreSpawningProcessExecutor> processExecutor = _processExecutor;
+            _processExecutor = null;
+            try
+            {
+                return processExecutor?.Result;
+            }
+            catch (AggregateException e)
+            {
+                _logger.DebugWarning($"{_threadName}Could not pre-spawn process of executable {Executable}: {e.InnerException?.Message ?? e.Message}");
+                return null;
+            }
+        }
+    }
+}
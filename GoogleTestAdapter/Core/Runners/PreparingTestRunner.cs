@@ -6,6 +6,7 @@ using GoogleTestAdapter.Common;
 using GoogleTestAdapter.Helpers;
 using GoogleTestAdapter.Model;
 using GoogleTestAdapter.Framework;
+using GoogleTestAdapter.ProcessExecution;
 using GoogleTestAdapter.ProcessExecution.Contracts;
 using GoogleTestAdapter.Scheduling;
 using GoogleTestAdapter.Settings;
@@ -20,12 +21,22 @@ namespace GoogleTestAdapter.Runners
         private readonly ILogger _logger;
         private readonly SettingsWrapper _settings;
         private readonly ITestRunner _innerTestRunner;
+        private readonly SequentialTestRunner _sequentialTestRunner;
+        private readonly IList<TestShard> _testShards;
         private readonly int _threadId;
         private readonly string _threadName;
         private readonly string _testDirectory;
+        private readonly CpuSet _cpuSet;
 
 
         public PreparingTestRunner(int threadId, ITestFrameworkReporter reporter, ILogger logger, SettingsWrapper settings, SchedulingAnalyzer schedulingAnalyzer)
+            : this(threadId, reporter, logger, settings, schedulingAnalyzer, null)
+        {
+        }
+
+        /// <param name="context">The work and the shared facilities of the thread; may be null</param>
+        public PreparingTestRunner(int threadId, ITestFrameworkReporter reporter, ILogger logger, SettingsWrapper settings, SchedulingAnalyzer schedulingAnalyzer,
+            TestExecutionContext context)
         {
             _logger = logger;
             _settings = settings;
@@ -33,7 +44,14 @@ namespace GoogleTestAdapter.Runners
             _threadName = string.IsNullOrEmpty(threadName) ? "" : $"{threadName} ";
             _threadId = Math.Max(0, threadId);
             _testDirectory = Utils.GetTempDirectory();
-            _innerTestRunner = new SequentialTestRunner(_threadName, _threadId, _testDirectory, reporter, _logger, _settings, schedulingAnalyzer);
+            _testShards = context?.TestShards ?? new List<TestShard>();
+            _cpuSet = context?.CpuSet;
+            _sequentialTestRunner = new SequentialTestRunner(_threadName, _threadId, _testDirectory, reporter, _logger, _settings, schedulingAnalyzer, context);
+            _innerTestRunner = _sequentialTestRunner;
+            if (context?.Queue != null)
+            {
+                _innerTestRunner = new WorkStealingTestRunner(_threadId, _threadName, context.Queue, _innerTestRunner, _logger);
+            }
         }
 
         public PreparingTestRunner(ITestFrameworkReporter reporter,
@@ -48,14 +66,19 @@ namespace GoogleTestAdapter.Runners
             try
             {
                 Stopwatch stopwatch = Stopwatch.StartNew();
+                // remote agents only execute test executables, so the batches are always run on the local machine
+                IProcessExecutorFactory batchExecutorFactory = (processExecutorFactory as RemoteProcessExecutorFactory)?.LocalFactory ?? processExecutorFactory;
 
-                string batch = _settings.GetBatchForTestSetup(_testDirectory, _threadId);
-                SafeRunBatch(TestSetup, _settings.SolutionDir, batch, processExecutorFactory);
+                string batch = _settings.GetBatchForTestSetup(_testDirectory, _threadId, _cpuSet);
+                SafeRunBatch(TestSetup, _settings.SolutionDir, batch, batchExecutorFactory);
 
+                if (_testShards.Count > 0)
+                    _sequentialTestRunner.RunTestShards(_testShards, isBeingDebugged, processExecutorFactory);
                 _innerTestRunner.RunTests(testCasesToRun, isBeingDebugged, processExecutorFactory);
+                _sequentialTestRunner.StopTestServers();
 
-                batch = _settings.GetBatchForTestTeardown(_testDirectory, _threadId);
-                SafeRunBatch(TestTeardown, _settings.SolutionDir, batch, processExecutorFactory);
+                batch = _settings.GetBatchForTestTeardown(_testDirectory, _threadId, _cpuSet);
+                SafeRunBatch(TestTeardown, _settings.SolutionDir, batch, batchExecutorFactory);
 
                 stopwatch.Stop();
                 _logger.DebugInfo($"{_threadName}Execution took {stopwatch.Elapsed}");
@@ -1,10 +1,12 @@
 ﻿// This file has been modified by Microsoft on 6/2017.
 
 using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.Diagnostics;
 using System.IO;
 using System.Linq;
+using System.Text;
 using GoogleTestAdapter.Common;
 using GoogleTestAdapter.Helpers;
 using GoogleTestAdapter.Scheduling;
@@ -19,6 +21,8 @@ namespace GoogleTestAdapter.Runners
 {
     public class SequentialTestRunner : ITestRunner
     {
+        private static readonly ConcurrentDictionary<string, bool> MarkersOfExecutables = new ConcurrentDictionary<string, bool>();
+
         private bool _canceled;
 
         private readonly string _threadName;
@@ -28,10 +32,27 @@ namespace GoogleTestAdapter.Runners
         private readonly ILogger _logger;
         private readonly SettingsWrapper _settings;
         private readonly SchedulingAnalyzer _schedulingAnalyzer;
+        private readonly IDictionary<string, List<TestCase>> _allTestCasesOfExecutables;
+        private readonly AdaptiveConcurrencyController _concurrencyController;
+        private readonly MemoryAdmissionController _memoryAdmission;
+        private readonly ResourceLockManager _resourceLocks;
+        private readonly CpuSet _cpuSet;
+        private readonly TestOutputFiles _outputFiles;
+
+        private readonly IDictionary<string, TestServer> _testServers = new Dictionary<string, TestServer>();
 
         private IProcessExecutor _processExecutor;
+        private List<TestResult> _resultsToBeCached;
+        private PreSpawnedBatch _preSpawnedBatch;
 
         public SequentialTestRunner(string threadName, int threadId, string testDir, ITestFrameworkReporter reporter, ILogger logger, SettingsWrapper settings, SchedulingAnalyzer schedulingAnalyzer)
+            : this(threadName, threadId, testDir, reporter, logger, settings, schedulingAnalyzer, null)
+        {
+        }
+
+        /// <param name="context">The shared facilities of the thread; queue and test shards are not used. May be null.</param>
+        public SequentialTestRunner(string threadName, int threadId, string testDir, ITestFrameworkReporter reporter, ILogger logger, SettingsWrapper settings, SchedulingAnalyzer schedulingAnalyzer,
+            TestExecutionContext context)
         {
             _threadName = threadName;
             _threadId = threadId;
@@ -40,33 +61,94 @@ namespace GoogleTestAdapter.Runners
             _logger = logger;
             _settings = settings;
             _schedulingAnalyzer = schedulingAnalyzer;
+            _allTestCasesOfExecutables = context?.AllTestCasesOfExecutables;
+            _concurrencyController = context?.ConcurrencyController;
+            _memoryAdmission = context?.MemoryAdmission;
+            _resourceLocks = context?.ResourceLocks;
+            _cpuSet = context?.CpuSet;
+            _outputFiles = new TestOutputFiles(settings, logger, threadName);
         }
 
 
         public void RunTests(IEnumerable<TestCase> testCasesToRun, bool isBeingDebugged, IDebuggedProcessExecutorFactory processExecutorFactory)
         {
-            IDictionary<string, List<TestCase>> groupedTestCases = testCasesToRun.GroupByExecutable();
-            foreach (string executable in groupedTestCases.Keys)
+            List<List<TestCase>> batches = _settings.PrioritizeFailedAndLongTests
+                ? GetPrioritizedBatches(testCasesToRun).ToList()
+                : testCasesToRun.GroupByExecutable().Values.ToList();
+            PreSpawnedBatch nextPreSpawnedBatch = null;
+            try
+            {
+                for (int i = 0; i < batches.Count && !_canceled; i++)
+                {
+                    _preSpawnedBatch = nextPreSpawnedBatch;
+                    // the next batch's process is created while this batch is running
+                    nextPreSpawnedBatch = i + 1 < batches.Count ? PreSpawnBatch(batches[i + 1], isBeingDebugged) : null;
+
+                    RunBatch(batches[i], isBeingDebugged, processExecutorFactory);
+
+                    _preSpawnedBatch?.Dispose();
+                    _preSpawnedBatch = null;
+                }
+            }
+            finally
+            {
+                _preSpawnedBatch?.Dispose();
+                _preSpawnedBatch = null;
+                nextPreSpawnedBatch?.Dispose();
+            }
+        }
+
+        private void RunBatch(List<TestCase> testCases, bool isBeingDebugged, IDebuggedProcessExecutorFactory processExecutorFactory)
+        {
+            string executable = testCases[0].Source;
+            _settings.ExecuteWithSettingsForExecutable(executable, _logger, () =>
+            {
+                string workingDir = _settings.GetWorkingDirForExecution(executable, _testDir, _threadId, _cpuSet);
+                string userParameters = _settings.GetUserParametersForExecution(executable, _testDir, _threadId, _cpuSet);
+                IDictionary<string, string> environmentVariables = GetEnvironmentVariablesForExecution(executable);
+
+                TestResultCache resultCache = GetResultCache(isBeingDebugged);
+                string cacheKey = resultCache?.ComputeKey(executable, _settings, GetExecutionMode(executable, isBeingDebugged));
+                if (cacheKey != null && TryReportCachedResults(executable, testCases, resultCache, cacheKey))
+                    return;
+
+                _resultsToBeCached = cacheKey != null ? new List<TestResult>() : null;
+                RunTestsFromExecutable(
+                    executable,
+                    workingDir,
+                    testCases,
+                    userParameters,
+                    environmentVariables,
+                    isBeingDebugged,
+                    processExecutorFactory);
+                if (cacheKey != null && !_canceled)
+                    resultCache.StoreResults(cacheKey, executable, _resultsToBeCached);
+                _resultsToBeCached = null;
+            });
+        }
+
+        /// <summary>
+        /// Runs the given shards of natively sharded executables. Each shard runs the complete executable
+        /// with GTEST_TOTAL_SHARDS and GTEST_SHARD_INDEX set; once the last shard of an executable has finished,
+        /// results are created for those tests which have not been run by any of the shards.
+        /// </summary>
+        public void RunTestShards(IEnumerable<TestShard> testShards, bool isBeingDebugged, IDebuggedProcessExecutorFactory processExecutorFactory)
+        {
+            foreach (TestShard testShard in testShards)
             {
                 if (_canceled)
                     break;
 
+                string executable = testShard.Executable;
                 _settings.ExecuteWithSettingsForExecutable(executable, _logger, () =>
                 {
-                    string workingDir = _settings.GetWorkingDirForExecution(executable, _testDir, _threadId);
-                    string userParameters = _settings.GetUserParametersForExecution(executable, _testDir, _threadId);
-                    IDictionary<string, string> environmentVariables = _settings.GetEnvironmentVariablesForExecution(executable, _testDir, _threadId);
-
-                    RunTestsFromExecutable(
-                        executable,
-                        workingDir,
-                        groupedTestCases[executable],
-                        userParameters,
-                        environmentVariables,
-                        isBeingDebugged,
-                        processExecutorFactory);
-                });
+                    string workingDir = _settings.GetWorkingDirForExecution(executable, _testDir, _threadId, _cpuSet);
+                    string userParameters = _settings.GetUserParametersForExecution(executable, _testDir, _threadId, _cpuSet);
+                    IDictionary<string, string> environmentVariables = GetEnvironmentVariablesForExecution(executable);
+                    testShard.AddEnvironmentVariables(environmentVariables);
 
+                    RunTestShard(testShard, workingDir, userParameters, environmentVariables, isBeingDebugged, processExecutorFactory);
+                });
             }
         }
 
@@ -75,61 +157,502 @@ namespace GoogleTestAdapter.Runners
         public void Cancel()
         {
             _canceled = true;
-            if (_settings.KillProcessesOnCancel)
+            // fail-fast mode cancels execution on the first failure, which only saves time if running tests are killed
+            if (_settings.KillProcessesOnCancel || _settings.FailFast)
             {
                 _processExecutor?.Cancel();
+                lock (_testServers)
+                {
+                    foreach (TestServer testServer in _testServers.Values)
+                    {
+                        testServer.Cancel();
+                    }
+                }
             }
         }
 
+        /// <summary>
+        /// Shuts down all test servers which have been started by this runner.
+        /// </summary>
+        public void StopTestServers()
+        {
+            lock (_testServers)
+            {
+                foreach (TestServer testServer in _testServers.Values)
+                {
+                    StopTestServer(testServer);
+                }
+                _testServers.Clear();
+            }
+        }
+
+
+        private IDictionary<string, string> GetEnvironmentVariablesForExecution(string executable)
+        {
+            IDictionary<string, string> environmentVariables = _settings.GetEnvironmentVariablesForExecution(executable, _testDir, _threadId, _cpuSet);
+            _cpuSet?.AddEnvironmentVariables(environmentVariables);
+            return environmentVariables;
+        }
+
+        private void UpdateExecutableOverhead(string executable, ExecutableOverhead overhead)
+        {
+            if (overhead == null)
+                return;
+
+            _logger.DebugInfo($"{_threadName}Overhead of executable {executable}: startup {overhead.StartupDuration}ms, shutdown {overhead.ShutdownDuration}ms, "
+                + $"{overhead.SuiteDurations.Count} suites with {overhead.SuiteDurations.Values.Sum()}ms");
+            PostPersistence(() =>
+            {
+                try
+                {
+                    new TestDurationSerializer().UpdateExecutableOverhead(executable, overhead);
+                }
+                catch (Exception e)
+                {
+                    _logger.DebugWarning($"{_threadName}Could not store overhead of executable {executable}: {e.Message}");
+                }
+            });
+        }
+
+        private void UpdatePeakMemory(string executable, long peakMemoryInBytes)
+        {
+            if (peakMemoryInBytes <= 0)
+                return;
+
+            // the memory admission needs the new value right away, only storing it is deferred
+            if (_memoryAdmission != null)
+                peakMemoryInBytes = _memoryAdmission.ReportPeakMemory(executable, peakMemoryInBytes);
+            PostPersistence(() =>
+            {
+                try
+                {
+                    new TestDurationSerializer().UpdatePeakMemory(executable, peakMemoryInBytes);
+                }
+                catch (Exception e)
+                {
+                    _logger.DebugWarning($"{_threadName}Could not store peak memory of executable {executable}: {e.Message}");
+                }
+            });
+        }
+
+        private IEnumerable<List<TestCase>> GetPrioritizedBatches(IEnumerable<TestCase> testCasesToRun)
+        {
+            TestCase[] testCasesToRunAsArray = testCasesToRun as TestCase[] ?? testCasesToRun.ToArray();
+            IDictionary<TestCase, int> durations = null;
+            IEnumerable<TestCase> recentlyFailedTestCases = null;
+            try
+            {
+                var serializer = new TestDurationSerializer();
+                durations = serializer.ReadTestDurations(testCasesToRunAsArray);
+                recentlyFailedTestCases = serializer.ReadLastOutcomes(testCasesToRunAsArray)
+                    .Where(kvp => kvp.Value == TestOutcome.Failed)
+                    .Select(kvp => kvp.Key)
+                    .ToList();
+            }
+            catch (InvalidTestDurationsException e)
+            {
+                _logger.LogWarning($"{_threadName}Could not read test durations: {e.Message}");
+            }
+
+            List<List<TestCase>> batches = new TestPriorityPlanner(durations, recentlyFailedTestCases).GetBatches(testCasesToRunAsArray);
+            _logger.DebugInfo($"{_threadName}Running {batches.Count} prioritized batches, {recentlyFailedTestCases?.Count() ?? 0} tests have failed when they were run last");
+            return batches;
+        }
 
         // ReSharper disable once UnusedParameter.Local
         private void RunTestsFromExecutable(string executable, string workingDir,
             IEnumerable<TestCase> testCasesToRun, string userParameters, IDictionary<string, string> environmentVariables,
             bool isBeingDebugged, IDebuggedProcessExecutorFactory processExecutorFactory)
         {
+            IEnumerable<List<TestCase>> groupsOfTestCases = _resourceLocks != null
+                ? ResourceLockManager.GroupByLocks(testCasesToRun)
+                : new[] { testCasesToRun.ToList() };
+            foreach (List<TestCase> testCases in groupsOfTestCases)
+            {
+                if (_canceled)
+                    break;
+
+                if (_resourceLocks != null && ResourceLockManager.IsConstrained(testCases[0]))
+                    _logger.DebugInfo($"{_threadName}Running {testCases.Count} tests of executable {executable} with resource constraints {ResourceLockManager.GetLockKey(testCases[0])}");
+
+                if (UseTestServer(executable, isBeingDebugged))
+                    RunTestsOnTestServer(executable, workingDir, testCases, userParameters, environmentVariables);
+                else
+                    RunTestsInProcesses(executable, workingDir, testCases, userParameters, environmentVariables, isBeingDebugged, processExecutorFactory);
+            }
+        }
+
+        private void RunTestsInProcesses(string executable, string workingDir,
+            IEnumerable<TestCase> testCasesToRun, string userParameters, IDictionary<string, string> environmentVariables,
+            bool isBeingDebugged, IDebuggedProcessExecutorFactory processExecutorFactory)
+        {
+            string resultXmlFile, flagFile, eventStreamFile;
+            if (_preSpawnedBatch == null || !_preSpawnedBatch.TryUseFiles(executable, environmentVariables, out resultXmlFile, out flagFile, out eventStreamFile))
+            {
+                resultXmlFile = _outputFiles.CreateFile();
+                flagFile = SupportsFlagFile(executable) ? _outputFiles.CreateFile() : null;
+                eventStreamFile = CreateEventStreamFile(executable, environmentVariables);
+            }
+            var serializer = new TestDurationSerializer();
+            int remainingCrashBudget = isBeingDebugged ? 0 : _settings.CrashBudget;
+            bool restartAfterTimeout = !isBeingDebugged && HasTimeouts;
+
+            while (testCasesToRun != null)
+            {
+                var testCasesNotRun = new List<TestCase>();
+                var generator = new CommandLineGenerator(testCasesToRun, executable.Length, userParameters, resultXmlFile, _settings, GetAllTestCasesOfExecutable(executable), flagFile);
+                foreach (CommandLineGenerator.Args arguments in generator.GetCommandLines())
+                {
+                    if (_canceled)
+                    {
+                        break;
+                    }
+                    _outputFiles.DeleteEventStreamFile(eventStreamFile);
+                    var streamingParser = new StreamingStandardOutputTestResultParser(arguments.TestCases, _logger, _frameworkReporter);
+                    int nrOfTestCasesNotRun = testCasesNotRun.Count;
+                    var results = RunTests(executable, workingDir, isBeingDebugged, processExecutorFactory, arguments, environmentVariables, resultXmlFile, streamingParser,
+                        eventStreamFile: eventStreamFile, testCasesNotRun: remainingCrashBudget > 0 || restartAfterTimeout ? testCasesNotRun : null,
+                        restartAfterCrash: remainingCrashBudget > 0).ToArray();
+                    // restarts after timeouts do not consume the crash budget
+                    if (testCasesNotRun.Count > nrOfTestCasesNotRun && !results.Any(TestTimeoutWatchdog.IsTimeoutResult))
+                        remainingCrashBudget--;
+
+                    ReportTestResults(executable, results, serializer);
+                }
+
+                testCasesToRun = null;
+                if (testCasesNotRun.Count > 0 && !_canceled)
+                {
+                    _logger.LogInfo($"{_threadName}Restarting executable {executable} for {testCasesNotRun.Count} tests which have not been run due to a crash or timeout (remaining crash budget: {remainingCrashBudget})");
+                    testCasesToRun = testCasesNotRun;
+                }
+            }
+
+            _outputFiles.DeleteFlagFile(flagFile);
+            _outputFiles.DeleteEventStreamFile(eventStreamFile);
+        }
+
+        /// <summary>
+        /// Creates the process for the first command line of the given batch in suspended state (on a background thread), such
+        /// that it can be resumed as soon as the batch is run. Returns null if the batch's process can not be created in advance.
+        /// </summary>
+        private PreSpawnedBatch PreSpawnBatch(List<TestCase> testCases, bool isBeingDebugged)
+        {
+            string executable = testCases[0].Source;
+            PreSpawnedBatch preSpawnedBatch = null;
+            _settings.ExecuteWithSettingsForExecutable(executable, _logger, () =>
+            {
+                if (!_settings.PreSpawnTestProcesses
+                    || isBeingDebugged
+                    || !string.IsNullOrWhiteSpace(_settings.RemoteAgents)
+                    || UseTestServer(executable, false)
+                    || (_resourceLocks != null && ResourceLockManager.GroupByLocks(testCases).Count() > 1))
+                    return;
+
+                string workingDir = _settings.GetWorkingDirForExecution(executable, _testDir, _threadId, _cpuSet);
+                string userParameters = _settings.GetUserParametersForExecution(executable, _testDir, _threadId, _cpuSet);
+                IDictionary<string, string> environmentVariables = GetEnvironmentVariablesForExecution(executable);
+                string pathExtension = _settings.GetPathExtension(executable);
+                if (!string.IsNullOrEmpty(pathExtension) && environmentVariables.ContainsKey("PATH"))
+                    return;
+
+                string resultXmlFile = _outputFiles.CreateFile();
+                string flagFile = SupportsFlagFile(executable) ? _outputFiles.CreateFile() : null;
+                string eventStreamFile = CreateEventStreamFile(executable, environmentVariables);
+                preSpawnedBatch = new PreSpawnedBatch(executable, resultXmlFile, flagFile, eventStreamFile, _outputFiles, _logger, _threadName);
+                var generator = new CommandLineGenerator(testCases, executable.Length, userParameters, resultXmlFile, _settings, GetAllTestCasesOfExecutable(executable), flagFile);
+                CommandLineGenerator.Args arguments = generator.GetCommandLines().First();
+                _outputFiles.WriteFlagFile(arguments);
+                bool printTestOutput = _settings.PrintTestOutput && !_settings.ParallelTestExecution;
+                preSpawnedBatch.PreSpawn(arguments.CommandLine, workingDir, pathExtension, environmentVariables, printTestOutput, _cpuSet);
+            });
+            return preSpawnedBatch;
+        }
+
+        private IProcessExecutor CreateProcessExecutor(IProcessExecutorFactory processExecutorFactory, bool printTestOutput)
+        {
+            IProcessExecutor processExecutor = processExecutorFactory.CreateExecutor(printTestOutput, _logger);
+            if (processExecutor is DotNetProcessExecutor dotNetProcessExecutor)
+                dotNetProcessExecutor.CpuSet = _cpuSet;
+            return processExecutor;
+        }
+
+        private void RunTestsOnTestServer(string executable, string workingDir,
+            IEnumerable<TestCase> testCasesToRun, string userParameters, IDictionary<string, string> environmentVariables)
+        {
+            TestServer testServer = GetOrStartTestServer(executable, workingDir, testCasesToRun, userParameters, environmentVariables);
+            if (testServer == null)
+                return;
+
+            var generator = new CommandLineGenerator(testCasesToRun, executable.Length, userParameters, testServer.ResultXmlFile, _settings, GetAllTestCasesOfExecutable(executable));
+            CommandLineGenerator.Args arguments = generator.GetTestServerRequest();
+
+            _outputFiles.DeleteResultXmlFile(testServer.ResultXmlFile);
+            var streamingParser = new StreamingStandardOutputTestResultParser(arguments.TestCases, _logger, _frameworkReporter);
+            var results = RunTests(executable, workingDir, false, null, arguments, environmentVariables, testServer.ResultXmlFile, streamingParser, testServer).ToArray();
+
+            ReportTestResults(executable, results, new TestDurationSerializer());
+
+            if (!testServer.IsRunning)
+            {
+                lock (_testServers)
+                {
+                    _testServers.Remove(executable);
+                }
+                StopTestServer(testServer);
+            }
+        }
+
+        private TestServer GetOrStartTestServer(string executable, string workingDir,
+            IEnumerable<TestCase> testCasesToRun, string userParameters, IDictionary<string, string> environmentVariables)
+        {
+            lock (_testServers)
+            {
+                if (_testServers.TryGetValue(executable, out TestServer testServer))
+                    return testServer;
+            }
+
             string resultXmlFile = Path.GetTempFileName();
+            string parameters = new CommandLineGenerator(testCasesToRun, executable.Length, userParameters, resultXmlFile, _settings)
+                .GetCommandLineForTestServer();
+            try
+            {
+                var testServer = new TestServer(executable, parameters, workingDir, _settings.GetPathExtension(executable), environmentVariables, resultXmlFile, _logger);
+                lock (_testServers)
+                {
+                    _testServers.Add(executable, testServer);
+                }
+                return testServer;
+            }
+            catch (Exception e)
+            {
+                LogExecutionError(_logger, executable, workingDir, parameters, e, _threadName);
+                _outputFiles.DeleteResultXmlFile(resultXmlFile);
+                return null;
+            }
+        }
+
+        private void StopTestServer(TestServer testServer)
+        {
+            testServer.Dispose();
+            _outputFiles.DeleteResultXmlFile(testServer.ResultXmlFile);
+        }
+
+        private bool UseTestServer(string executable, bool isBeingDebugged)
+        {
+            return _settings.UseTestServer
+                   && !isBeingDebugged
+                   && string.IsNullOrWhiteSpace(_settings.RemoteAgents)
+                   && string.IsNullOrEmpty(_settings.ExitCodeTestCase)
+                   && ContainsMarker(executable, TestServer.BatchFinishedMarker);
+        }
+
+        private void RunTestShard(TestShard testShard, string workingDir, string userParameters, IDictionary<string, string> environmentVariables,
+            bool isBeingDebugged, IDebuggedProcessExecutorFactory processExecutorFactory)
+        {
+            string executable = testShard.Executable;
+            string resultXmlFile = _outputFiles.CreateFile();
+            string flagFile = SupportsFlagFile(executable) ? _outputFiles.CreateFile() : null;
+            string eventStreamFile = CreateEventStreamFile(executable, environmentVariables);
             var serializer = new TestDurationSerializer();
 
-            var generator = new CommandLineGenerator(testCasesToRun, executable.Length, userParameters, resultXmlFile, _settings);
-            foreach (CommandLineGenerator.Args arguments in generator.GetCommandLines())
+            var generator = new CommandLineGenerator(testShard.TestCases, executable.Length, userParameters, resultXmlFile, _settings, GetAllTestCasesOfExecutable(executable), flagFile);
+            CommandLineGenerator.Args arguments = generator.GetCommandLineForShard();
+            var streamingParser = new StreamingStandardOutputTestResultParser(arguments.TestCases, _logger, _frameworkReporter);
+
+            _logger.DebugInfo($"{_threadName}Running {testShard}");
+            TestResult[] results;
+            try
             {
-                if (_canceled)
+                List<string> consoleOutput;
+                EventStreamTestResultParser eventStreamParser = CreateEventStreamParser(arguments, eventStreamFile);
+                TestTimeoutWatchdog watchdog = CreateWatchdog(isBeingDebugged, null);
+                using (watchdog)
                 {
-                    break;
+                    consoleOutput = RunTestExecutable(executable, workingDir, arguments, environmentVariables, isBeingDebugged, processExecutorFactory, streamingParser,
+                        eventStreamParser: eventStreamParser, watchdog: watchdog);
                 }
-                var streamingParser = new StreamingStandardOutputTestResultParser(arguments.TestCases, _logger, _frameworkReporter);
-                var results = RunTests(executable, workingDir, isBeingDebugged, processExecutorFactory, arguments, environmentVariables, resultXmlFile, streamingParser).ToArray();
 
+                var remainingTestCases = arguments.TestCases
+                    .Except(streamingParser.TestResults.Select(tr => tr.TestCase));
+                var collectedResults = new TestResultCollector(_logger, _threadName, _settings)
+                    .CollectTestResults(remainingTestCases, executable, resultXmlFile, consoleOutput, streamingParser.CrashedTestCase, false, eventStreamParser);
+                RemoveResultOfKilledTest(collectedResults, streamingParser.CrashedTestCase);
+                AddTimeoutResult(collectedResults, GetTimedOutTestCase(arguments.TestCases, watchdog), watchdog);
+                results = collectedResults
+                    .OrderBy(tr => tr.TestCase.FullyQualifiedName)
+                    .ToArray();
+            }
+            catch (Exception e)
+            {
+                LogExecutionError(_logger, executable, workingDir, arguments.CommandLine, e, _threadName);
+                results = new TestResult[0];
+            }
+
+            ReportTestResults(executable, results, serializer);
+            _outputFiles.DeleteFlagFile(flagFile);
+            _outputFiles.DeleteEventStreamFile(eventStreamFile);
+
+            var testCasesWithResults = streamingParser.TestResults.Concat(results).Select(tr => tr.TestCase);
+            if (testShard.ShardedExecutable.FinishShard(testCasesWithResults, streamingParser.CrashedTestCase,
+                out IList<TestCase> testCasesWithoutResults, out TestCase crashedTestCase) && !_canceled)
+            {
+                var missingResults = new TestResultCollector(_logger, _threadName, _settings)
+                    .CreateResultsForMissingTests(testCasesWithoutResults, crashedTestCase)
+                    .ToArray();
+                ReportTestResults(executable, missingResults, serializer);
+            }
+        }
+
+        /// <summary>
+        /// Google Test supports --gtest_flagfile since version 1.8, whose help message contains the flag's full name; the
+        /// bare "flagfile" is also contained in executables linking gflags or abseil, even if their Google Test is older
+        /// </summary>
+        private bool SupportsFlagFile(string executable)
+        {
+            return ContainsMarker(executable, GoogleTestConstants.FlagFileMarker);
+        }
+
+        private bool UsesEventStream(string executable)
+        {
+            return string.IsNullOrEmpty(_settings.ExitCodeTestCase) && ContainsMarker(executable, EventStreamTestResultParser.EnvironmentVariable);
+        }
+
+        /// <summary>
+        /// Describes the decisions made by the runner (rather than by the settings) which influence the command line
+        /// and environment of the test processes, such that cached results are not reused if one of them changes.
+        /// </summary>
+        private string GetExecutionMode(string executable, bool isBeingDebugged)
+        {
+            return $"FlagFile={SupportsFlagFile(executable)};EventStream={UsesEventStream(executable)};TestServer={UseTestServer(executable, isBeingDebugged)}";
+        }
+
+        private bool ContainsMarker(string executable, string marker)
+        {
+            return MarkersOfExecutables.GetOrAdd($"{executable}|{File.GetLastWriteTimeUtc(executable).Ticks}|{marker}", _ =>
+            {
                 try
                 {
-                    Stopwatch stopwatch = Stopwatch.StartNew();
-                    _frameworkReporter.ReportTestsStarted(results.Select(tr => tr.TestCase));
-                    _frameworkReporter.ReportTestResults(results);
-                    stopwatch.Stop();
-                    if (results.Length > 0)
-                        _logger.DebugInfo($"{_threadName}Reported {results.Length} test results to VS, executable: '{executable}', duration: {stopwatch.Elapsed}");
+                    return Utils.BinaryFileContainsStrings(executable, Encoding.ASCII, marker.Yield());
                 }
-                catch (TestRunCanceledException e)
+                catch (Exception e)
                 {
-                    _logger.DebugInfo($"{_threadName}Execution has been canceled: {e.InnerException?.Message ?? e.Message}");
-                    Cancel();
+                    _logger.DebugWarning($"{_threadName}Could not check executable '{executable}' for '{marker}': {e.Message}");
+                    return false;
                 }
+            });
+        }
+
+        /// <summary>
+        /// If the executable has been built with the listener of GTA_EventListener.h, a file is created to which the
+        /// listener writes its event stream. Since the event stream does not contain the exit code test's output,
+        /// it is not used if an exit code test is configured.
+        /// </summary>
+        private string CreateEventStreamFile(string executable, IDictionary<string, string> environmentVariables)
+        {
+            if (!UsesEventStream(executable))
+                return null;
+
+            string eventStreamFile = _outputFiles.CreateFile();
+            environmentVariables[EventStreamTestResultParser.EnvironmentVariable] = eventStreamFile;
+            return eventStreamFile;
+        }
+
+        private EventStreamTestResultParser CreateEventStreamParser(CommandLineGenerator.Args arguments, string eventStreamFile)
+        {
+            return eventStreamFile != null
+                ? new EventStreamTestResultParser(arguments.TestCases, eventStreamFile, _logger)
+                : null;
+        }
+
+        private IEnumerable<TestCase> GetAllTestCasesOfExecutable(string executable)
+        {
+            if (_allTestCasesOfExecutables == null)
+                return null;
+
+            return _allTestCasesOfExecutables.TryGetValue(executable, out List<TestCase> allTestCases) ? allTestCases : null;
+        }
+
+        private TestResultCache GetResultCache(bool isBeingDebugged)
+        {
+            // exit code tests are reported from the executable results, which are not available for cached results
+            if (string.IsNullOrWhiteSpace(_settings.ResultCacheDirectory) || isBeingDebugged || !string.IsNullOrEmpty(_settings.ExitCodeTestCase))
+                return null;
+
+            return new TestResultCache(_settings.ResultCacheDirectory, _logger);
+        }
+
+        private bool TryReportCachedResults(string executable, List<TestCase> testCases, TestResultCache resultCache, string cacheKey)
+        {
+            IList<TestResult> cachedResults = resultCache.GetResults(cacheKey, testCases);
+            if (cachedResults == null)
+                return false;
+
+            _logger.DebugInfo($"{_threadName}Reporting cached results of {cachedResults.Count} tests, executable: '{executable}'");
+            ReportTestResults(executable, cachedResults.ToArray(), new TestDurationSerializer());
+            return true;
+        }
+
+        private void ReportTestResults(string executable, TestResult[] results, TestDurationSerializer serializer)
+        {
+            _resultsToBeCached?.AddRange(results);
+
+            try
+            {
+                Stopwatch stopwatch = Stopwatch.StartNew();
+                _frameworkReporter.ReportTestsStarted(results.Select(tr => tr.TestCase));
+                _frameworkReporter.ReportTestResults(results);
+                stopwatch.Stop();
+                if (results.Length > 0)
+                    _logger.DebugInfo($"{_threadName}Reported {results.Length} test results to VS, executable: '{executable}', duration: {stopwatch.Elapsed}");
+            }
+            catch (TestRunCanceledException e)
+            {
+                _logger.DebugInfo($"{_threadName}Execution has been canceled: {e.InnerException?.Message ?? e.Message}");
+                Cancel();
+            }
+
+            UpdateTestDurations(results, serializer);
+        }
 
+        /// <summary>
+        /// If results are reported asynchronously, durations are stored by the reporting thread, too
+        /// </summary>
+        private void UpdateTestDurations(IList<TestResult> results, TestDurationSerializer serializer)
+        {
+            Action updateTestDurations = () =>
+            {
                 serializer.UpdateTestDurations(results);
                 foreach (TestResult result in results)
                 {
                     if (!_schedulingAnalyzer.AddActualDuration(result.TestCase, (int)result.Duration.TotalMilliseconds))
-                        _logger.DebugWarning("TestCase already in analyzer: " + result.TestCase.FullyQualifiedName);
+                        _logger.DebugWarning($"{_threadName}TestCase already in analyzer: {result.TestCase.FullyQualifiedName}");
                 }
-            }
+            };
+
+            PostPersistence(updateTestDurations);
+        }
+
+        /// <summary>
+        /// Rewriting the durations files does not need to delay the next test process, so it is done by the
+        /// reporter's worker if results are reported asynchronously.
+        /// </summary>
+        private void PostPersistence(Action persist)
+        {
+            if (_frameworkReporter is AsyncTestFrameworkReporter asyncReporter)
+                asyncReporter.Post(persist);
+            else
+                persist();
         }
 
         private IEnumerable<TestResult> RunTests(string executable, string workingDir, bool isBeingDebugged,
-            IDebuggedProcessExecutorFactory processExecutorFactory, CommandLineGenerator.Args arguments, IDictionary<string, string> environmentVariables, string resultXmlFile, StreamingStandardOutputTestResultParser streamingParser)
+            IDebuggedProcessExecutorFactory processExecutorFactory, CommandLineGenerator.Args arguments, IDictionary<string, string> environmentVariables, string resultXmlFile, StreamingStandardOutputTestResultParser streamingParser,
+            TestServer testServer = null, string eventStreamFile = null, List<TestCase> testCasesNotRun = null, bool restartAfterCrash = false)
         {
             try
             {
-                return TryRunTests(executable, workingDir, isBeingDebugged, processExecutorFactory, arguments, environmentVariables, resultXmlFile, streamingParser);
+                return TryRunTests(executable, workingDir, isBeingDebugged, processExecutorFactory, arguments, environmentVariables, resultXmlFile, streamingParser, testServer, eventStreamFile,
+                    testCasesNotRun, restartAfterCrash);
             }
             catch (Exception e)
             {
@@ -138,6 +661,54 @@ namespace GoogleTestAdapter.Runners
             }
         }
 
+        private bool HasTimeouts => _settings.TestTimeoutInSeconds > 0 || _settings.ProcessTimeoutInSeconds > 0;
+
+        private TestTimeoutWatchdog CreateWatchdog(bool isBeingDebugged, TestServer testServer)
+        {
+            if (isBeingDebugged || !HasTimeouts)
+                return null;
+
+            return new TestTimeoutWatchdog(_settings.TestTimeoutInSeconds, _settings.ProcessTimeoutInSeconds, () =>
+            {
+                if (testServer != null)
+                    testServer.Cancel();
+                else
+                    _processExecutor?.Cancel();
+            }, _logger, _threadName);
+        }
+
+        private TestCase GetTimedOutTestCase(IEnumerable<TestCase> testCasesRun, TestTimeoutWatchdog watchdog)
+        {
+            return watchdog?.TimedOutTest == null
+                ? null
+                : testCasesRun.FirstOrDefault(tc => tc.FullyQualifiedName == watchdog.TimedOutTest);
+        }
+
+        /// <summary>
+        /// The timed out test might already have a result, e.g. a crash result from the event stream
+        /// or a result created for a test which has not been run
+        /// </summary>
+        private bool AddTimeoutResult(List<TestResult> testResults, TestCase timedOutTestCase, TestTimeoutWatchdog watchdog)
+        {
+            if (timedOutTestCase == null)
+                return false;
+
+            testResults.RemoveAll(tr => tr.TestCase == timedOutTestCase);
+            testResults.Add(StreamingStandardOutputTestResultParser.CreateFailedTestResult(timedOutTestCase, TimeSpan.FromSeconds(0),
+                TestTimeoutWatchdog.CreateTimeoutMessage(watchdog.TimeoutMessage), ""));
+            return true;
+        }
+
+        /// <summary>
+        /// If the executable has been killed because execution has been canceled, the test which was running at that
+        /// time has not crashed; it does not get a result such that it is reported as not run (if requested)
+        /// </summary>
+        private void RemoveResultOfKilledTest(List<TestResult> testResults, TestCase crashedTestCase)
+        {
+            if (_canceled && crashedTestCase != null)
+                testResults.RemoveAll(tr => tr.TestCase == crashedTestCase);
+        }
+
         public static void LogExecutionError(ILogger logger, string executable, string workingDir, string arguments, Exception exception, string threadName = "")
         {
             logger.LogError($"{threadName}Failed to run test executable '{executable}': {exception.Message}");
@@ -154,24 +725,47 @@ namespace GoogleTestAdapter.Runners
 
         private IEnumerable<TestResult> TryRunTests(string executable, string workingDir, bool isBeingDebugged,
             IDebuggedProcessExecutorFactory processExecutorFactory, CommandLineGenerator.Args arguments, IDictionary<string, string> environmentVariables, string resultXmlFile,
-            StreamingStandardOutputTestResultParser streamingParser)
+            StreamingStandardOutputTestResultParser streamingParser, TestServer testServer, string eventStreamFile, List<TestCase> testCasesNotRun, bool restartAfterCrash)
         {
-            var consoleOutput = 
-                RunTestExecutable(executable, workingDir, arguments, environmentVariables, isBeingDebugged, processExecutorFactory, streamingParser);
+            List<string> consoleOutput;
+            EventStreamTestResultParser eventStreamParser = CreateEventStreamParser(arguments, eventStreamFile);
+            TestTimeoutWatchdog watchdog = CreateWatchdog(isBeingDebugged, testServer);
+            using (watchdog)
+            {
+                consoleOutput =
+                    RunTestExecutable(executable, workingDir, arguments, environmentVariables, isBeingDebugged, processExecutorFactory, streamingParser, testServer, eventStreamParser, watchdog);
+            }
 
+            TestCase timedOutTestCase = GetTimedOutTestCase(arguments.TestCases, watchdog);
             var remainingTestCases =
                 arguments.TestCases
                     .Except(streamingParser.TestResults.Select(tr => tr.TestCase))
-                    .Where(tc => !tc.IsExitCodeTestCase);
-            var testResults = new TestResultCollector(_logger, _threadName, _settings)
-                .CollectTestResults(remainingTestCases, executable, resultXmlFile, consoleOutput, streamingParser.CrashedTestCase);
+                    .Where(tc => !tc.IsExitCodeTestCase)
+                    .ToList();
+            var collector = new TestResultCollector(_logger, _threadName, _settings);
+            var testResults = collector
+                .CollectTestResults(remainingTestCases, executable, resultXmlFile, consoleOutput, streamingParser.CrashedTestCase ?? timedOutTestCase, testCasesNotRun == null && !_canceled, eventStreamParser);
+            RemoveResultOfKilledTest(testResults, collector.CrashedTestCase);
+            bool hasTimedOut = AddTimeoutResult(testResults, timedOutTestCase, watchdog);
+
+            // if the executable has crashed or timed out, tests without results are run again (if requested by the caller)
+            if (testCasesNotRun != null && !_canceled)
+            {
+                var testCasesWithoutResults = remainingTestCases
+                    .Except(testResults.Select(tr => tr.TestCase))
+                    .ToList();
+                if (collector.CrashedTestCase != null && (restartAfterCrash || hasTimedOut))
+                    testCasesNotRun.AddRange(testCasesWithoutResults);
+                else
+                    testResults.AddRange(collector.CreateResultsForMissingTests(testCasesWithoutResults, collector.CrashedTestCase));
+            }
             testResults = testResults.OrderBy(tr => tr.TestCase.FullyQualifiedName).ToList();
 
             return testResults;
         }
 
         private List<string> RunTestExecutable(string executable, string workingDir, CommandLineGenerator.Args arguments, IDictionary<string, string> environmentVariables, bool isBeingDebugged, IDebuggedProcessExecutorFactory processExecutorFactory,
-            StreamingStandardOutputTestResultParser streamingParser)
+            StreamingStandardOutputTestResultParser streamingParser, TestServer testServer = null, EventStreamTestResultParser eventStreamParser = null, TestTimeoutWatchdog watchdog = null)
         {
             string pathExtension = _settings.GetPathExtension(executable);
             if (!string.IsNullOrEmpty(pathExtension))
@@ -187,9 +781,18 @@ namespace GoogleTestAdapter.Runners
             bool printTestOutput = _settings.PrintTestOutput &&
                                    !_settings.ParallelTestExecution &&
                                    isTestOutputAvailable;
+            // if results are taken from the event stream, the console output does not need to be parsed
+            bool parseTestOutput = isTestOutputAvailable && eventStreamParser == null;
+            // test servers are started only once, and debugging distorts timing
+            ExecutableOverheadTracker overheadTracker = testServer == null && !isBeingDebugged ? new ExecutableOverheadTracker() : null;
 
             void OnNewOutputLine(string line)
             {
+                watchdog?.ReportLine(line);
+                overheadTracker?.ReportLine(line);
+                if (!parseTestOutput)
+                    return;
+
                 try
                 {
                     if (!_canceled) streamingParser.ReportLine(line);
@@ -201,30 +804,86 @@ namespace GoogleTestAdapter.Runners
                 }
             }
 
-            _processExecutor = isBeingDebugged
-                ? _settings.DebuggerKind == DebuggerKind.VsTestFramework
-                    ? processExecutorFactory.CreateFrameworkDebuggingExecutor(printTestOutput, _logger)
-                    : processExecutorFactory.CreateNativeDebuggingExecutor(
-                        _settings.DebuggerKind == DebuggerKind.Native ? DebuggerEngine.Native : DebuggerEngine.ManagedAndNative, 
-                        printTestOutput, _logger)
-                : processExecutorFactory.CreateExecutor(printTestOutput, _logger);
-            int exitCode = _processExecutor.ExecuteCommandBlocking(
-                executable, arguments.CommandLine, workingDir, pathExtension, environmentVariables,
-                isTestOutputAvailable ? (Action<string>) OnNewOutputLine : null);
-            streamingParser.Flush();
+            // results from the event stream are reported as the listener writes them, and are then treated like
+            // results parsed from the console output (i.e., the caller collects results only for the other tests)
+            void OnNewEventStreamResult(TestResult testResult)
+            {
+                try
+                {
+                    if (_canceled)
+                        return;
+                    _frameworkReporter.ReportTestResults(testResult.Yield());
+                    streamingParser.TestResults.Add(testResult);
+                }
+                catch (TestRunCanceledException e)
+                {
+                    _logger.DebugInfo($"{_threadName}Execution has been canceled: {e.InnerException?.Message ?? e.Message}");
+                    Cancel();
+                }
+            }
+
+            _outputFiles.WriteFlagFile(arguments);
 
+            int exitCode;
+            // the memory admission is acquired first such that no resource locks are held while waiting for memory
+            // (other executables' tests might need them meanwhile); the concurrency permit is acquired last such that
+            // it is not held while waiting for the locks or for memory
+            using (testServer == null ? _memoryAdmission?.Acquire(executable, _threadName) : null)
+            using (_resourceLocks?.Acquire(arguments.TestCases))
+            using (_concurrencyController?.Acquire())
+            using (var eventStreamTail = eventStreamParser != null ? new EventStreamTail(eventStreamParser, OnNewEventStreamResult, _logger) : null)
+            {
+                watchdog?.Start();
+                eventStreamTail?.Start();
+                if (testServer != null)
+                {
+                    exitCode = testServer.RunBatch(arguments.CommandLine, line =>
+                    {
+                        OnNewOutputLine(line);
+                        if (printTestOutput)
+                            _logger.LogInfo(line);
+                    });
+                }
+                else
+                {
+                    _processExecutor = isBeingDebugged
+                        ? _settings.DebuggerKind == DebuggerKind.VsTestFramework
+                            ? processExecutorFactory.CreateFrameworkDebuggingExecutor(printTestOutput, _logger)
+                            : processExecutorFactory.CreateNativeDebuggingExecutor(
+                                _settings.DebuggerKind == DebuggerKind.Native ? DebuggerEngine.Native : DebuggerEngine.ManagedAndNative, 
+                                printTestOutput, _logger)
+                        : (IProcessExecutor)_preSpawnedBatch?.TakeProcessExecutor(executable, arguments.CommandLine, workingDir, pathExtension, environmentVariables)
+                          ?? CreateProcessExecutor(processExecutorFactory, printTestOutput);
+                    overheadTracker?.Start();
+                    exitCode = _processExecutor.ExecuteCommandBlocking(
+                        executable, arguments.CommandLine, workingDir, pathExtension, environmentVariables,
+                        isTestOutputAvailable ? (Action<string>) OnNewOutputLine : null);
+                }
+                eventStreamTail?.Stop();
+            }
+            // the result of a timed out test is created by the caller, a killed test does not get a result
+            if (watchdog?.TimedOutTest == null && !_canceled)
+                streamingParser.Flush();
+
+            if (watchdog?.HasTimedOut != true && !_canceled)
+                UpdateExecutableOverhead(executable, overheadTracker?.Stop());
+
+            // test servers run several batches, so their resource usage can not be attributed to a single batch
+            ResourceUsage resourceUsage = testServer == null
+                ? (_processExecutor as DotNetProcessExecutor)?.ResourceUsage ?? (_processExecutor as PreSpawningProcessExecutor)?.ResourceUsage
+                : null;
+            if (resourceUsage != null)
+            {
+                _logger.DebugInfo($"{_threadName}Resource usage of executable {executable}: {resourceUsage}");
+                UpdatePeakMemory(executable, resourceUsage.PeakMemoryInBytes);
+            }
             ExecutableResults.Add(new ExecutableResult(executable, exitCode, streamingParser.ExitCodeOutput,
-                streamingParser.ExitCodeSkip));
+                streamingParser.ExitCodeSkip, resourceUsage));
 
             var consoleOutput = new List<string>();
-            new TestDurationSerializer().UpdateTestDurations(streamingParser.TestResults);
             _logger.DebugInfo(
                 $"{_threadName}Reported {streamingParser.TestResults.Count} test results to VS during test execution, executable: '{executable}'");
-            foreach (TestResult result in streamingParser.TestResults)
-            {
-                if (!_schedulingAnalyzer.AddActualDuration(result.TestCase, (int) result.Duration.TotalMilliseconds))
-                    _logger.DebugWarning($"{_threadName}TestCase already in analyzer: {result.TestCase.FullyQualifiedName}");
-            }
+            UpdateTestDurations(streamingParser.TestResults.ToList(), new TestDurationSerializer());
             return consoleOutput;
         }
     }
@@ -0,0 +1,33 @@
+﻿using System.Collections.Generic;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.Scheduling;
+
+namespace GoogleTestAdapter.Runners
+{
+    /// <summary>
+    /// The work and the shared facilities of a test execution thread. All properties are optional, i.e. may be null.
+    /// </summary>
+    public class TestExecutionContext
+    {
+        /// <summary>Tests to be taken by the thread in addition to the tests passed to RunTests().</summary>
+        public WorkStealingTestQueue Queue { get; set; }
+
+        /// <summary>Shards of natively sharded executables, run before the actual tests.</summary>
+        public IList<TestShard> TestShards { get; set; }
+
+        /// <summary>All (discovered) tests, grouped by executable; used for synthesizing short test filters.</summary>
+        public IDictionary<string, List<TestCase>> AllTestCasesOfExecutables { get; set; }
+
+        /// <summary>Limits the number of test processes running concurrently on all threads.</summary>
+        public AdaptiveConcurrencyController ConcurrencyController { get; set; }
+
+        /// <summary>Keeps the predicted memory usage of the test processes running on all threads within a budget.</summary>
+        public MemoryAdmissionController MemoryAdmission { get; set; }
+
+        /// <summary>Prevents tests sharing a resource from running concurrently on different threads.</summary>
+        public ResourceLockManager ResourceLocks { get; set; }
+
+        /// <summary>Logical processors the test processes of the thread are pinned to.</summary>
+        public CpuSet CpuSet { get; set; }
+    }
+}
@@ -0,0 +1,256 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+
+namespace GoogleTestAdapter.Runners
+{
+    /// <summary>
+    /// Computes a short --gtest_filter which selects exactly a given set of tests out of all tests of an
+    /// executable. Test names are arranged in a prefix tree; each subtree can be covered by a positive pattern
+    /// (e.g. 'Instance/Suite.*' or 'Suite.Test*'), excluded by a negative pattern, or be split further down to
+    /// single test names. The cheapest combination is picked, and the result is verified against all known tests.
+    /// </summary>
+    public class TestFilterSynthesizer
+    {
+        private class Node
+        {
+            internal int Lo;
+            internal int Hi;
+            internal int PrefixLength;
+            internal bool HasTerminal;
+            internal readonly List<Node> Children = new List<Node>();
+            internal int NrOfSelected;
+
+            internal int CostToInclude;
+            internal bool IncludeByPattern;
+            internal int CostToExclude;
+            internal bool ExcludeByPattern;
+            internal int CostToExcludeChildren;
+        }
+
+        private static readonly char[] Wildcards = { '*', '?' };
+
+        private readonly string[] _allTestNames;
+
+        public TestFilterSynthesizer(IEnumerable<string> allTestNames)
+        {
+            _allTestNames = allTestNames.Distinct().OrderBy(n => n, StringComparer.Ordinal).ToArray();
+        }
+
+        /// <summary>
+        /// Returns a filter matching exactly the selected tests (without the --gtest_filter= option), or null
+        /// if no such filter could be computed (e.g. because a selected test is not known).
+        /// </summary>
+        public string SynthesizeFilter(IEnumerable<string> selectedTestNames)
+        {
+            var selected = new HashSet<string>(selectedTestNames);
+            if (selected.Count == 0 || !selected.All(name => Array.BinarySearch(_allTestNames, name, StringComparer.Ordinal) >= 0))
+                return null;
+
+            Node root = CreateNode(0, _allTestNames.Length, 0, selected);
+            ComputeCosts(root);
+
+            var positivePatterns = new List<string>();
+            var negativePatterns = new List<string>();
+            CollectIncludePatterns(root, positivePatterns, negativePatterns);
+
+            string filter = string.Join(":", positivePatterns);
+            if (negativePatterns.Count > 0)
+                filter += "-" + string.Join(":", negativePatterns);
+
+            Func<string, bool> matcher = CreateMatcher(filter);
+            return _allTestNames.All(name => matcher(name) == selected.Contains(name)) ? filter : null;
+        }
+
+        /// <summary>
+        /// Returns true if Google Test would run the given test with the given filter.
+        /// </summary>
+        public static bool Matches(string filter, string testName)
+        {
+            return CreateMatcher(filter)(testName);
+        }
+
+        private static Func<string, bool> CreateMatcher(string filter)
+        {
+            int indexOfDash = filter.IndexOf('-');
+            string positivePart = indexOfDash < 0 ? filter : filter.Substring(0, indexOfDash);
+            string negativePart = indexOfDash < 0 ? "" : filter.Substring(indexOfDash + 1);
+            if (positivePart.Length == 0)
+                positivePart = "*";
+
+            Func<string, bool> matchesPositivePattern = CreatePatternsMatcher(positivePart);
+            Func<string, bool> matchesNegativePattern = CreatePatternsMatcher(negativePart);
+            return name => matchesPositivePattern(name) && !matchesNegativePattern(name);
+        }
+
+        /// <summary>
+        /// Patterns without wildcards are looked up in a set, all others are matched one by one
+        /// </summary>
+        private static Func<string, bool> CreatePatternsMatcher(string patterns)
+        {
+            string[] patternsAsArray = patterns.Length > 0 ? patterns.Split(':') : new string[0];
+            var names = new HashSet<string>(patternsAsArray.Where(p => p.IndexOfAny(Wildcards) < 0));
+            string[] wildcardPatterns = patternsAsArray.Where(p => p.IndexOfAny(Wildcards) >= 0).ToArray();
+            return name => names.Contains(name) || wildcardPatterns.Any(pattern => MatchesPattern(pattern, 0, name, 0));
+        }
+
+        private static bool MatchesPattern(string pattern, int patternIndex, string name, int nameIndex)
+        {
+            while (patternIndex < pattern.Length)
+            {
+                char c = pattern[patternIndex];
+                if (c == '*')
+                {
+                    for (int i = nameIndex; i <= name.Length; i++)
+                    {
+                        if (MatchesPattern(pattern, patternIndex + 1, name, i))
+                            return true;
+                    }
+                    return false;
+                }
+                if (nameIndex >= name.Length || (c != '?' && c != name[nameIndex]))
+                    return false;
+                patternIndex++;
+                nameIndex++;
+            }
+            return nameIndex == name.Length;
+        }
+
+        /// <summary>
+        /// The node contains all names in [lo, hi), which share (at least) the first prefixLength characters
+        /// </summary>
+        private Node CreateNode(int lo, int hi, int prefixLength, ISet<string> selected)
+        {
+            var node = new Node { Lo = lo, Hi = hi, PrefixLength = prefixLength };
+            int commonPrefixLength = GetCommonPrefixLength(_allTestNames[lo], _allTestNames[hi - 1]);
+
+            int childLo = lo;
+            if (_allTestNames[lo].Length == commonPrefixLength)
+            {
+                node.HasTerminal = true;
+                if (selected.Contains(_allTestNames[lo]))
+                    node.NrOfSelected++;
+                childLo++;
+            }
+
+            while (childLo < hi)
+            {
+                char c = _allTestNames[childLo][commonPrefixLength];
+                int childHi = childLo + 1;
+                while (childHi < hi && _allTestNames[childHi][commonPrefixLength] == c)
+                    childHi++;
+
+                Node child = CreateNode(childLo, childHi, commonPrefixLength + 1, selected);
+                node.Children.Add(child);
+                node.NrOfSelected += child.NrOfSelected;
+                childLo = childHi;
+            }
+
+            return node;
+        }
+
+        /// <summary>
+        /// Each pattern costs its length plus one separator
+        /// </summary>
+        private void ComputeCosts(Node node)
+        {
+            foreach (Node child in node.Children)
+            {
+                ComputeCosts(child);
+            }
+
+            int nrOfTests = node.Hi - node.Lo;
+            int terminalCost = node.HasTerminal ? _allTestNames[node.Lo].Length + 1 : 0;
+            bool terminalIsSelected = node.HasTerminal && node.NrOfSelected - node.Children.Sum(c => c.NrOfSelected) == 1;
+            int patternCost = node.PrefixLength + 2;
+
+            node.CostToExcludeChildren = node.Children.Sum(c => c.CostToExclude) + (node.HasTerminal && !terminalIsSelected ? terminalCost : 0);
+            if (node.NrOfSelected == nrOfTests)
+            {
+                node.CostToExclude = 0;
+            }
+            else if (node.NrOfSelected == 0 && patternCost < node.CostToExcludeChildren)
+            {
+                node.CostToExclude = patternCost;
+                node.ExcludeByPattern = true;
+            }
+            else
+            {
+                node.CostToExclude = node.CostToExcludeChildren;
+            }
+
+            int costToIncludeChildren = node.Children.Sum(c => c.CostToInclude) + (terminalIsSelected ? terminalCost : 0);
+            int costToIncludeByPattern = patternCost + node.CostToExcludeChildren;
+            if (node.NrOfSelected == 0)
+            {
+                node.CostToInclude = 0;
+            }
+            else if (costToIncludeByPattern < costToIncludeChildren)
+            {
+                node.CostToInclude = costToIncludeByPattern;
+                node.IncludeByPattern = true;
+            }
+            else
+            {
+                node.CostToInclude = costToIncludeChildren;
+            }
+        }
+
+        private void CollectIncludePatterns(Node node, List<string> positivePatterns, List<string> negativePatterns)
+        {
+            if (node.NrOfSelected == 0)
+                return;
+
+            if (node.IncludeByPattern)
+            {
+                positivePatterns.Add(GetPattern(node));
+                CollectExcludePatternsOfChildren(node, negativePatterns);
+                return;
+            }
+
+            if (node.HasTerminal && node.NrOfSelected > node.Children.Sum(c => c.NrOfSelected))
+                positivePatterns.Add(_allTestNames[node.Lo]);
+            foreach (Node child in node.Children)
+            {
+                CollectIncludePatterns(child, positivePatterns, negativePatterns);
+            }
+        }
+
+        private void CollectExcludePatterns(Node node, List<string> negativePatterns)
+        {
+            if (node.NrOfSelected == node.Hi - node.Lo)
+                return;
+
+            if (node.ExcludeByPattern)
+                negativePatterns.Add(GetPattern(node));
+            else
+                CollectExcludePatternsOfChildren(node, negativePatterns);
+        }
+
+        private void CollectExcludePatternsOfChildren(Node node, List<string> negativePatterns)
+        {
+            if (node.HasTerminal && node.NrOfSelected == node.Children.Sum(c => c.NrOfSelected))
+                negativePatterns.Add(_allTestNames[node.Lo]);
+            foreach (Node child in node.Children)
+            {
+                CollectExcludePatterns(child, negativePatterns);
+            }
+        }
+
+        private string GetPattern(Node node)
+        {
+            return new StringBuilder(_allTestNames[node.Lo], 0, node.PrefixLength, node.PrefixLength + 1).Append('*').ToString();
+        }
+
+        private static int GetCommonPrefixLength(string first, string last)
+        {
+            int length = 0;
+            while (length < first.Length && length < last.Length && first[length] == last[length])
+                length++;
+            return length;
+        }
+
+    }
+
+}
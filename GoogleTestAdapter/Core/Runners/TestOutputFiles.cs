@@ -0,0 +1,73 @@
+﻿using System;
+using System.IO;
+using GoogleTestAdapter.Common;
+using GoogleTestAdapter.Settings;
+
+namespace GoogleTestAdapter.Runners
+{
+    /// <summary>
+    /// Creates and deletes the files written by the test executables (result xml, flag and event stream files).
+    /// </summary>
+    public class TestOutputFiles
+    {
+        private readonly SettingsWrapper _settings;
+        private readonly ILogger _logger;
+        private readonly string _threadName;
+
+        public TestOutputFiles(SettingsWrapper settings, ILogger logger, string threadName)
+        {
+            _settings = settings;
+            _logger = logger;
+            _threadName = threadName;
+        }
+
+        /// <summary>
+        /// Creates an empty file to be written by the test executable. If tests are executed by remote agents,
+        /// the file is created in the configured output directory, which is accessible by the agents.
+        /// </summary>
+        public string CreateFile()
+        {
+            if (string.IsNullOrWhiteSpace(_settings.RemoteAgents) || string.IsNullOrWhiteSpace(_settings.RemoteOutputDirectory))
+                return Path.GetTempFileName();
+
+            string outputFile = Path.Combine(_settings.RemoteOutputDirectory, Path.GetRandomFileName());
+            File.WriteAllBytes(outputFile, new byte[0]);
+            return outputFile;
+        }
+
+        public void WriteFlagFile(CommandLineGenerator.Args arguments)
+        {
+            if (arguments.FlagFile != null)
+                File.WriteAllText(arguments.FlagFile, arguments.FlagFileContent);
+        }
+
+        public void DeleteResultXmlFile(string resultXmlFile)
+        {
+            DeleteFile(resultXmlFile, "result xml file");
+        }
+
+        public void DeleteFlagFile(string flagFile)
+        {
+            if (flagFile != null)
+                DeleteFile(flagFile, "flag file");
+        }
+
+        public void DeleteEventStreamFile(string eventStreamFile)
+        {
+            if (eventStreamFile != null)
+                DeleteFile(eventStreamFile, "event stream file");
+        }
+
+        private void DeleteFile(string file, string fileType)
+        {
+            try
+            {
+                File.Delete(file);
+            }
+            catch (Exception e)
+            {
+                _logger.DebugWarning($"{_threadName}Could not delete {fileType} '{file}': {e.Message}");
+            }
+        }
+    }
+}
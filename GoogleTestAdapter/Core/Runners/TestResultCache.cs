@@ -0,0 +1,252 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Security.Cryptography;
+using System.Text;
+using System.Xml.Serialization;
+using GoogleTestAdapter.Common;
+using GoogleTestAdapter.DiaResolver;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.Settings;
+
+namespace GoogleTestAdapter.Runners
+{
+    [Serializable]
+    [XmlRoot]
+    public class GtaCachedTestResults
+    {
+        public string Executable { get; set; }
+        public List<CachedTestResult> TestResults { get; set; } = new List<CachedTestResult>();
+    }
+
+    [Serializable]
+    public class CachedTestResult
+    {
+        [XmlAttribute]
+        public string Test { get; set; }
+
+        /// <summary>
+        /// Duration in ms
+        /// </summary>
+        [XmlAttribute]
+        public int Duration { get; set; }
+    }
+
+    /// <summary>
+    /// Caches the results of passed tests in a directory. Results are stored under a key which is computed from the
+    /// contents of the test executable and of the DLLs it imports (directly or indirectly) which are located next to
+    /// the executable or in the path extension, from the settings which determine the command line and environment
+    /// of the test process, and from the way the runner executes the tests (e.g. with a flag file or event stream).
+    /// Since the key changes whenever one of these inputs changes, cached results are never outdated; they are used
+    /// only if all tests to be run from an executable have passed before.
+    /// </summary>
+    public class TestResultCache
+    {
+        private const string FileEnding = ".gta.cachedresults";
+
+        private static readonly XmlSerializer Serializer = new XmlSerializer(typeof(GtaCachedTestResults));
+        private static readonly object Lock = new object();
+        private static readonly ConcurrentDictionary<string, string> FileHashes = new ConcurrentDictionary<string, string>();
+
+        private readonly string _directory;
+        private readonly ILogger _logger;
+
+        public TestResultCache(string directory, ILogger logger)
+        {
+            _directory = directory;
+            _logger = logger;
+        }
+
+        /// <summary>
+        /// Must be called within SettingsWrapper.ExecuteWithSettingsForExecutable(). Returns null if the key
+        /// can not be computed (e.g. because the executable can not be read).
+        /// </summary>
+        /// <param name="executionMode">Describes how the runner executes the tests beyond the settings, e.g. whether
+        /// a flag file or an event stream is used</param>
+        public string ComputeKey(string executable, SettingsWrapper settings, string executionMode = "")
+        {
+            try
+            {
+                var inputs = new StringBuilder();
+                inputs.AppendLine($"Executable={GetFileHash(executable)}");
+                AppendImports(inputs, executable, executable, settings.GetPathExtension(executable),
+                    new HashSet<string>(StringComparer.OrdinalIgnoreCase));
+                inputs.AppendLine($"ExecutionMode={executionMode}");
+                inputs.AppendLine($"WorkingDir={settings.WorkingDir}");
+                inputs.AppendLine($"PathExtension={settings.PathExtension}");
+                inputs.AppendLine($"EnvironmentVariables={settings.EnvironmentVariables}");
+                inputs.AppendLine($"AdditionalTestExecutionParam={settings.AdditionalTestExecutionParam}");
+                inputs.AppendLine($"CatchExceptions={settings.CatchExceptions}");
+                inputs.AppendLine($"BreakOnFailure={settings.BreakOnFailure}");
+                inputs.AppendLine($"RunDisabledTests={settings.RunDisabledTests}");
+                inputs.AppendLine($"NrOfTestRepetitions={settings.NrOfTestRepetitions}");
+                inputs.AppendLine($"ShuffleTests={settings.ShuffleTests}");
+                inputs.AppendLine($"ShuffleTestsSeed={settings.ShuffleTestsSeed}");
+
+                return ComputeHash(Encoding.UTF8.GetBytes(inputs.ToString()));
+            }
+            catch (Exception e)
+            {
+                _logger.DebugWarning($"Could not compute result cache key of executable {executable}: {e.Message}");
+                return null;
+            }
+        }
+
+        /// <summary>
+        /// Returns cached results for the given tests if all of them have passed with the given key, null otherwise.
+        /// </summary>
+        public IList<TestResult> GetResults(string key, ICollection<TestCase> testCases)
+        {
+            GtaCachedTestResults cachedResults = Load(key);
+            if (cachedResults == null)
+                return null;
+
+            var durations = new Dictionary<string, int>();
+            foreach (CachedTestResult cachedResult in cachedResults.TestResults)
+            {
+                durations[cachedResult.Test] = cachedResult.Duration;
+            }
+            if (!testCases.All(tc => durations.ContainsKey(tc.FullyQualifiedName)))
+                return null;
+
+            return testCases
+                .Select(tc => new TestResult(tc)
+                {
+                    ComputerName = Environment.MachineName,
+                    DisplayName = tc.DisplayName,
+                    Outcome = TestOutcome.Passed,
+                    Duration = TimeSpan.FromMilliseconds(durations[tc.FullyQualifiedName]),
+                    IsCached = true
+                })
+                .ToList();
+        }
+
+        /// <summary>
+        /// Adds passed tests to the results cached under the given key, and removes all other tests.
+        /// </summary>
+        public void StoreResults(string key, string executable, IEnumerable<TestResult> testResults)
+        {
+            try
+            {
+                lock (Lock)
+                {
+                    GtaCachedTestResults cachedResults = Load(key) ?? new GtaCachedTestResults { Executable = executable };
+                    var resultsByTest = cachedResults.TestResults.ToDictionary(tr => tr.Test);
+                    foreach (TestResult testResult in testResults.Where(tr => !tr.IsCached))
+                    {
+                        if (testResult.Outcome == TestOutcome.Passed)
+                            resultsByTest[testResult.TestCase.FullyQualifiedName] = new CachedTestResult
+                            {
+                                Test = testResult.TestCase.FullyQualifiedName,
+                                Duration = (int)testResult.Duration.TotalMilliseconds
+                            };
+                        else
+                            resultsByTest.Remove(testResult.TestCase.FullyQualifiedName);
+                    }
+                    cachedResults.TestResults = resultsByTest.Values.OrderBy(tr => tr.Test).ToList();
+
+                    Directory.CreateDirectory(_directory);
+                    using (var fileStream = new FileStream(GetCacheFile(key), FileMode.Create))
+                    {
+                        Serializer.Serialize(fileStream, cachedResults);
+                    }
+                }
+            }
+            catch (Exception e)
+            {
+                _logger.DebugWarning($"Could not store cached results of executable {executable}: {e.Message}");
+            }
+        }
+
+
+        private GtaCachedTestResults Load(string key)
+        {
+            string cacheFile = GetCacheFile(key);
+            try
+            {
+                lock (Lock)
+                {
+                    if (!File.Exists(cacheFile))
+                        return null;
+
+                    using (var fileStream = new FileStream(cacheFile, FileMode.Open, FileAccess.Read))
+                    {
+                        return (GtaCachedTestResults)Serializer.Deserialize(fileStream);
+                    }
+                }
+            }
+            catch (Exception e)
+            {
+                _logger.DebugWarning($"Could not read cached results from file {cacheFile}: {e.Message}");
+                return null;
+            }
+        }
+
+        private string GetCacheFile(string key)
+        {
+            return Path.Combine(_directory, key + FileEnding);
+        }
+
+        /// <summary>
+        /// DLLs which are not shipped with the tests (e.g. system DLLs) are considered part of the environment, so
+        /// only the imports of shipped DLLs are followed
+        /// </summary>
+        private void AppendImports(StringBuilder inputs, string file, string executable, string pathExtension, ISet<string> visitedImports)
+        {
+            foreach (string import in PeParser.ParseImports(file, _logger).OrderBy(i => i, StringComparer.OrdinalIgnoreCase))
+            {
+                if (!visitedImports.Add(import))
+                    continue;
+
+                string importedFile = FindImportedFile(import, executable, pathExtension);
+                inputs.AppendLine($"Import {import}={(importedFile != null ? GetFileHash(importedFile) : "")}");
+                if (importedFile != null)
+                    AppendImports(inputs, importedFile, executable, pathExtension, visitedImports);
+            }
+        }
+
+        private static string FindImportedFile(string import, string executable, string pathExtension)
+        {
+            IEnumerable<string> directories = new[] { Path.GetDirectoryName(executable) }
+                .Concat((pathExtension ?? "").Split(new[] { ';' }, StringSplitOptions.RemoveEmptyEntries));
+            return directories
+                .Select(d => Path.Combine(d, import))
+                .FirstOrDefault(File.Exists);
+        }
+
+        /// <summary>
+        /// Hashes are remembered as long as the file does not change, such that executables and
+        /// DLLs are read only once even if their tests are run in many batches
+        /// </summary>
+        private static string GetFileHash(string file)
+        {
+            var fileInfo = new FileInfo(file);
+            string fileKey = $"{fileInfo.FullName}|{fileInfo.LastWriteTimeUtc.Ticks}|{fileInfo.Length}";
+            return FileHashes.GetOrAdd(fileKey, _ =>
+            {
+                using (var stream = File.OpenRead(file))
+                using (var sha = SHA256.Create())
+                {
+                    return ToHexString(sha.ComputeHash(stream));
+                }
+            });
+        }
+
+        private static string ComputeHash(byte[] bytes)
+        {
+            using (var sha = SHA256.Create())
+            {
+                return ToHexString(sha.ComputeHash(bytes));
+            }
+        }
+
+        private static string ToHexString(byte[] bytes)
+        {
+            return BitConverter.ToString(bytes).Replace("-", "").ToLowerInvariant();
+        }
+
+    }
+
+}
@@ -28,11 +28,24 @@ namespace GoogleTestAdapter.Runners
             _settings = settings;
         }
 
-        public List<TestResult> CollectTestResults(IEnumerable<TestCase> testCasesRun, string testExecutable, string resultXmlFile, List<string> consoleOutput, TestCase crashedTestCase)
+        /// <summary>
+        /// The test which has crashed the executable, as determined by the last call of CollectTestResults().
+        /// </summary>
+        public TestCase CrashedTestCase { get; private set; }
+
+        public List<TestResult> CollectTestResults(IEnumerable<TestCase> testCasesRun, string testExecutable, string resultXmlFile, List<string> consoleOutput, TestCase crashedTestCase,
+            bool createResultsForMissingTests = true, EventStreamTestResultParser eventStreamParser = null)
         {
             var testResults = new List<TestResult>();
             TestCase[] arrTestCasesRun = testCasesRun as TestCase[] ?? testCasesRun.ToArray();
 
+            if (eventStreamParser != null)
+            {
+                TestCase crashedTestCaseOfEventStream = CollectResultsFromEventStream(arrTestCasesRun, eventStreamParser, testResults);
+                if (crashedTestCase == null)
+                    crashedTestCase = crashedTestCaseOfEventStream;
+            }
+
             if (testResults.Count < arrTestCasesRun.Length)
                 CollectResultsFromXmlFile(arrTestCasesRun, testExecutable, resultXmlFile, testResults);
 
@@ -40,24 +53,49 @@ namespace GoogleTestAdapter.Runners
             if (testResults.Count < arrTestCasesRun.Length)
                 CollectResultsFromConsoleOutput(consoleParser, testResults);
 
-            if (testResults.Count < arrTestCasesRun.Length)
-            {
-                if (crashedTestCase == null)
-                    crashedTestCase = consoleParser.CrashedTestCase;
+            if (crashedTestCase == null)
+                crashedTestCase = consoleParser.CrashedTestCase;
+            CrashedTestCase = crashedTestCase;
 
+            if (createResultsForMissingTests && testResults.Count < arrTestCasesRun.Length)
+            {
                 var remainingTestCases = arrTestCasesRun
-                    .Where(tc => !testResults.Exists(tr => tr.TestCase.FullyQualifiedName == tc.FullyQualifiedName))
-                    .ToArray();
+                    .Where(tc => !testResults.Exists(tr => tr.TestCase.FullyQualifiedName == tc.FullyQualifiedName));
 
-                if (crashedTestCase != null)
-                    CreateMissingResults(remainingTestCases, crashedTestCase, testResults);
-                else
-                    ReportSuspiciousTestCases(remainingTestCases, testResults);
+                testResults.AddRange(CreateResultsForMissingTests(remainingTestCases, crashedTestCase));
             }
 
             return testResults;
         }
 
+        public List<TestResult> CreateResultsForMissingTests(IEnumerable<TestCase> missingTestCases, TestCase crashedTestCase)
+        {
+            var testResults = new List<TestResult>();
+            TestCase[] arrMissingTestCases = missingTestCases as TestCase[] ?? missingTestCases.ToArray();
+            if (arrMissingTestCases.Length == 0)
+                return testResults;
+
+            if (crashedTestCase != null)
+                CreateMissingResults(arrMissingTestCases, crashedTestCase, testResults);
+            else
+                ReportSuspiciousTestCases(arrMissingTestCases, testResults);
+
+            return testResults;
+        }
+
+        private TestCase CollectResultsFromEventStream(TestCase[] testCasesRun, EventStreamTestResultParser eventStreamParser, List<TestResult> testResults)
+        {
+            // results which have already been reported during test execution are not returned again by the parser
+            List<TestResult> eventStreamResults = eventStreamParser.GetTestResults()
+                .Where(tr => testCasesRun.Contains(tr.TestCase))
+                .ToList();
+            testResults.AddRange(eventStreamResults);
+            if (eventStreamResults.Count > 0)
+                _logger.DebugInfo($"{_threadName}Collected {eventStreamResults.Count} test results from event stream");
+
+            return eventStreamParser.CrashedTestCase;
+        }
+
         private void CollectResultsFromXmlFile(TestCase[] testCasesRun, string testExecutable, string resultXmlFile, List<TestResult> testResults)
         {
             var xmlParser = new XmlTestResultParser(testCasesRun, testExecutable, resultXmlFile, _logger);
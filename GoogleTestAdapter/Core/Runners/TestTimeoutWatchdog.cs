@@ -0,0 +1,134 @@
+﻿using System;
+using System.Threading;
+using GoogleTestAdapter.Common;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.TestResults;
+
+namespace GoogleTestAdapter.Runners
+{
+    /// <summary>
+    /// Watches a running test executable and invokes the given timeout action (which is supposed to kill the
+    /// executable) if the currently running test has not finished within the test timeout (measured from its
+    /// '[ RUN      ]' line), or if the executable has not finished within the process timeout. A timeout of
+    /// zero seconds disables the respective check.
+    /// </summary>
+    public class TestTimeoutWatchdog : IDisposable
+    {
+        public const string TimeoutText = "!! This test has TIMED OUT !!";
+
+        private const int CheckIntervalInMs = 1000;
+
+        private readonly object _lock = new object();
+        private readonly TimeSpan _testTimeout;
+        private readonly TimeSpan _processTimeout;
+        private readonly Action _onTimeout;
+        private readonly ILogger _logger;
+        private readonly string _threadName;
+
+        private DateTime _processStart = DateTime.UtcNow;
+        private string _currentTest;
+        private DateTime _currentTestStart;
+        private Timer _timer;
+
+        public TestTimeoutWatchdog(int testTimeoutInSeconds, int processTimeoutInSeconds, Action onTimeout, ILogger logger, string threadName = "")
+        {
+            _testTimeout = TimeSpan.FromSeconds(testTimeoutInSeconds);
+            _processTimeout = TimeSpan.FromSeconds(processTimeoutInSeconds);
+            _onTimeout = onTimeout;
+            _logger = logger;
+            _threadName = threadName;
+        }
+
+        public bool HasTimedOut { get; private set; }
+
+        /// <summary>
+        /// Full name of the test which was running when the timeout occured; null if no timeout has occured
+        /// or no test was running at that time.
+        /// </summary>
+        public string TimedOutTest { get; private set; }
+
+        public string TimeoutMessage { get; private set; }
+
+        public static string CreateTimeoutMessage(string reason)
+        {
+            return $"{TimeoutText}\n{reason}";
+        }
+
+        public static bool IsTimeoutResult(TestResult testResult)
+        {
+            return testResult.ErrorMessage != null && testResult.ErrorMessage.StartsWith(TimeoutText);
+        }
+
+        public void Start()
+        {
+            _processStart = DateTime.UtcNow;
+            _timer = new Timer(_ => CheckTimeouts(DateTime.UtcNow), null, CheckIntervalInMs, CheckIntervalInMs);
+        }
+
+        public void ReportLine(string line)
+        {
+            if (line == null)
+                return;
+
+            lock (_lock)
+            {
+                if (StreamingStandardOutputTestResultParser.IsRunLine(line))
+                {
+                    _currentTest = StreamingStandardOutputTestResultParser.GetTestNameOfRunLine(line);
+                    _currentTestStart = DateTime.UtcNow;
+                }
+                else if (StreamingStandardOutputTestResultParser.ContainsTestEndMarker(line))
+                {
+                    _currentTest = null;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Invokes the timeout action (at most once) if a timeout has occured at the given point in time.
+        /// </summary>
+        public bool CheckTimeouts(DateTime now)
+        {
+            lock (_lock)
+            {
+                if (HasTimedOut)
+                    return true;
+
+                if (_testTimeout > TimeSpan.Zero && _currentTest != null && now - _currentTestStart >= _testTimeout)
+                {
+                    TimeoutMessage = $"Test {_currentTest} did not finish within the test timeout of {_testTimeout.TotalSeconds}s";
+                }
+                else if (_processTimeout > TimeSpan.Zero && now - _processStart >= _processTimeout)
+                {
+                    TimeoutMessage = $"Test executable did not finish within the process timeout of {_processTimeout.TotalSeconds}s"
+                        + (_currentTest != null ? $" while running test {_currentTest}" : "");
+                }
+                else
+                {
+                    return false;
+                }
+
+                HasTimedOut = true;
+                TimedOutTest = _currentTest;
+            }
+
+            _logger.LogWarning($"{_threadName}{TimeoutMessage} - killing test executable");
+            try
+            {
+                _onTimeout();
+            }
+            catch (Exception e)
+            {
+                _logger.LogError($"{_threadName}Could not kill timed out test executable: {e.Message}");
+            }
+            return true;
+        }
+
+        public void Dispose()
+        {
+            _timer?.Dispose();
+        }
+
+    }
+
+}
@@ -0,0 +1,55 @@
+﻿using System.Collections.Generic;
+using GoogleTestAdapter.Common;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.ProcessExecution.Contracts;
+using GoogleTestAdapter.Scheduling;
+
+namespace GoogleTestAdapter.Runners
+{
+    /// <summary>
+    /// Runs the tests of one thread of a parallel test run: repeatedly takes a chunk of tests from the
+    /// shared queue and passes it to the inner runner, until the queue has no work left.
+    /// </summary>
+    public class WorkStealingTestRunner : ITestRunner
+    {
+        private readonly int _threadId;
+        private readonly string _threadName;
+        private readonly WorkStealingTestQueue _queue;
+        private readonly ITestRunner _innerTestRunner;
+        private readonly ILogger _logger;
+
+        public WorkStealingTestRunner(int threadId, string threadName, WorkStealingTestQueue queue, ITestRunner innerTestRunner, ILogger logger)
+        {
+            _threadId = threadId;
+            _threadName = threadName;
+            _queue = queue;
+            _innerTestRunner = innerTestRunner;
+            _logger = logger;
+        }
+
+        /// <summary>
+        /// The tests to be run are taken from the queue; testCasesToRun is ignored.
+        /// </summary>
+        public void RunTests(IEnumerable<TestCase> testCasesToRun, bool isBeingDebugged,
+            IDebuggedProcessExecutorFactory processExecutorFactory)
+        {
+            int nrOfChunks = 0;
+            while (_queue.TryTake(_threadId, out List<TestCase> chunk))
+            {
+                nrOfChunks++;
+                _innerTestRunner.RunTests(chunk, isBeingDebugged, processExecutorFactory);
+            }
+            _logger.DebugInfo($"{_threadName}Executed {nrOfChunks} chunks of tests");
+        }
+
+        public IList<ExecutableResult> ExecutableResults => _innerTestRunner.ExecutableResults;
+
+        public void Cancel()
+        {
+            _queue.Cancel();
+            _innerTestRunner.Cancel();
+        }
+
+    }
+
+}
@@ -0,0 +1,174 @@
+﻿using System;
+using System.Threading;
+using GoogleTestAdapter.Common;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    /// <summary>
+    /// Limits the number of concurrently running test processes. The limit starts at the number of processors and
+    /// is adapted to the machine's load, which is sampled periodically: it is lowered if the machine is overloaded
+    /// (high CPU utilization, long run queue, or little available memory), and raised if the machine has spare
+    /// capacity while test processes are waiting to be started (e.g. because tests are I/O-bound).
+    /// </summary>
+    public class AdaptiveConcurrencyController : IDisposable
+    {
+        public const int DefaultSamplingIntervalInMs = 2000;
+
+        public const float HighCpuUtilization = 95;
+        public const float LowCpuUtilization = 75;
+        public const float HighRunQueueLengthPerProcessor = 2;
+        public const float LowRunQueueLengthPerProcessor = 1;
+        public const float LowAvailableMemoryInMb = 1024;
+
+        private class Permit : IDisposable
+        {
+            private readonly AdaptiveConcurrencyController _controller;
+            private int _isReleased;
+
+            internal Permit(AdaptiveConcurrencyController controller)
+            {
+                _controller = controller;
+            }
+
+            public void Dispose()
+            {
+                if (Interlocked.Exchange(ref _isReleased, 1) == 0)
+                    _controller.Release();
+            }
+        }
+
+        private readonly object _lock = new object();
+        private readonly int _minLimit;
+        private readonly int _maxLimit;
+        private readonly int _nrOfProcessors;
+        private readonly IMachineLoadSampler _sampler;
+        private readonly ILogger _logger;
+
+        private Timer _timer;
+        private int _nrOfRunningProcesses;
+        private int _nrOfWaitingProcesses;
+        private bool _isDisposed;
+
+        public AdaptiveConcurrencyController(int minLimit, int maxLimit, IMachineLoadSampler sampler, ILogger logger)
+            : this(minLimit, maxLimit, Environment.ProcessorCount, sampler, logger)
+        {
+        }
+
+        public AdaptiveConcurrencyController(int minLimit, int maxLimit, int nrOfProcessors, IMachineLoadSampler sampler, ILogger logger)
+        {
+            if (minLimit < 1 || maxLimit < minLimit)
+                throw new ArgumentOutOfRangeException(nameof(maxLimit), $"Invalid bounds: {minLimit}..{maxLimit}");
+
+            _minLimit = minLimit;
+            _maxLimit = maxLimit;
+            _nrOfProcessors = Math.Max(1, nrOfProcessors);
+            _sampler = sampler;
+            _logger = logger;
+            Limit = Math.Max(minLimit, Math.Min(maxLimit, _nrOfProcessors));
+        }
+
+        public int Limit { get; private set; }
+
+        public void Start(int samplingIntervalInMs = DefaultSamplingIntervalInMs)
+        {
+            _logger.DebugInfo($"Adaptive concurrency: running between {_minLimit} and {_maxLimit} test processes concurrently, starting with {Limit}");
+            _timer = new Timer(_ => SampleAndAdjust(), null, samplingIntervalInMs, samplingIntervalInMs);
+        }
+
+        /// <summary>
+        /// Blocks until another test process may be started. The returned permit must be disposed as soon as the
+        /// process has finished.
+        /// </summary>
+        public IDisposable Acquire()
+        {
+            lock (_lock)
+            {
+                _nrOfWaitingProcesses++;
+                while (!_isDisposed && _nrOfRunningProcesses >= Limit)
+                {
+                    Monitor.Wait(_lock);
+                }
+                _nrOfWaitingProcesses--;
+                _nrOfRunningProcesses++;
+            }
+            return new Permit(this);
+        }
+
+        public void Adjust(MachineLoad load)
+        {
+            lock (_lock)
+            {
+                float runQueueLengthPerProcessor = load.RunQueueLength / _nrOfProcessors;
+                int newLimit = Limit;
+                string reason;
+                if (load.AvailableMemoryInMb < LowAvailableMemoryInMb)
+                {
+                    newLimit--;
+                    reason = "low memory";
+                }
+                else if (load.CpuUtilization >= HighCpuUtilization || runQueueLengthPerProcessor >= HighRunQueueLengthPerProcessor)
+                {
+                    newLimit--;
+                    reason = "machine is overloaded";
+                }
+                else if (_nrOfWaitingProcesses > 0 && load.CpuUtilization < LowCpuUtilization && runQueueLengthPerProcessor < LowRunQueueLengthPerProcessor)
+                {
+                    newLimit++;
+                    reason = "spare capacity and waiting test processes";
+                }
+                else
+                {
+                    _logger.VerboseInfo($"Adaptive concurrency: {load}, keeping {Limit} concurrent test processes");
+                    return;
+                }
+
+                newLimit = Math.Max(_minLimit, Math.Min(_maxLimit, newLimit));
+                if (newLimit == Limit)
+                    return;
+
+                _logger.DebugInfo($"Adaptive concurrency: {load}, {reason} - changing number of concurrent test processes from {Limit} to {newLimit}");
+                Limit = newLimit;
+                Monitor.PulseAll(_lock);
+            }
+        }
+
+        public void Dispose()
+        {
+            _timer?.Dispose();
+            lock (_lock)
+            {
+                _isDisposed = true;
+                Monitor.PulseAll(_lock);
+            }
+            _sampler.Dispose();
+        }
+
+        private void Release()
+        {
+            lock (_lock)
+            {
+                _nrOfRunningProcesses--;
+                Monitor.PulseAll(_lock);
+            }
+        }
+
+        private void SampleAndAdjust()
+        {
+            try
+            {
+                lock (_lock)
+                {
+                    if (_isDisposed)
+                        return;
+                }
+                Adjust(_sampler.Sample());
+            }
+            catch (Exception e)
+            {
+                _logger.DebugWarning($"Adaptive concurrency: could not sample machine load: {e.Message}");
+            }
+        }
+
+    }
+
+}
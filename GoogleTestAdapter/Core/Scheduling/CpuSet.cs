@@ -0,0 +1,63 @@
+﻿using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    /// <summary>
+    /// The logical processors the test processes of a thread are pinned to.
+    /// </summary>
+    public class CpuSet
+    {
+        public const string CpuSetEnvironmentVariable = "GTA_CPU_SET";
+        public const string CpuCountEnvironmentVariable = "GTA_CPU_COUNT";
+        public const string NumaNodesEnvironmentVariable = "GTA_NUMA_NODES";
+
+        /// <summary>Logical processors within the processor group of the current process</summary>
+        public IList<int> Processors { get; }
+
+        public IList<int> NumaNodes { get; }
+
+        public CpuSet(IEnumerable<int> processors, IEnumerable<int> numaNodes)
+        {
+            Processors = processors.Distinct().OrderBy(p => p).ToList();
+            NumaNodes = numaNodes.Distinct().OrderBy(n => n).ToList();
+        }
+
+        public ulong AffinityMask => Processors
+            .Where(p => p < 64)
+            .Aggregate(0UL, (mask, p) => mask | (1UL << p));
+
+        public void AddEnvironmentVariables(IDictionary<string, string> environmentVariables)
+        {
+            environmentVariables[CpuSetEnvironmentVariable] = ToString();
+            environmentVariables[CpuCountEnvironmentVariable] = Processors.Count.ToString();
+            environmentVariables[NumaNodesEnvironmentVariable] = FormatNumbers(NumaNodes);
+        }
+
+        /// <summary>
+        /// Returns the processors as a list of ranges, e.g. "0-3,8,10-11".
+        /// </summary>
+        public override string ToString()
+        {
+            return FormatNumbers(Processors);
+        }
+
+        public static string FormatNumbers(IList<int> numbers)
+        {
+            var result = new StringBuilder();
+            for (int i = 0; i < numbers.Count; i++)
+            {
+                int start = numbers[i];
+                while (i + 1 < numbers.Count && numbers[i + 1] == numbers[i] + 1)
+                    i++;
+
+                if (result.Length > 0)
+                    result.Append(',');
+                result.Append(start == numbers[i] ? $"{start}" : $"{start}-{numbers[i]}");
+            }
+            return result.ToString();
+        }
+    }
+
+}
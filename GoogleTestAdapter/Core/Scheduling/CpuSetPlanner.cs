@@ -0,0 +1,190 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using System.Runtime.InteropServices;
+using GoogleTestAdapter.Common;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    /// <summary>
+    /// Partitions the logical processors of the machine into disjoint CPU sets, one for each test thread. A CPU set
+    /// does not span NUMA nodes unless there are fewer threads than nodes; the threads are distributed among the
+    /// nodes proportionally to the nodes' sizes. If there are more threads than processors, each thread gets a
+    /// single processor, which is then shared by several threads.
+    /// </summary>
+    public class CpuSetPlanner
+    {
+        private readonly IList<NumaNode> _numaNodes;
+
+        public CpuSetPlanner(IList<NumaNode> numaNodes)
+        {
+            _numaNodes = numaNodes.Where(n => n.Processors.Count > 0).ToList();
+        }
+
+        public IList<CpuSet> CreateCpuSets(int nrOfThreads)
+        {
+            var cpuSets = new List<CpuSet>();
+            if (nrOfThreads <= 0 || _numaNodes.Count == 0)
+                return cpuSets;
+
+            if (nrOfThreads <= _numaNodes.Count)
+            {
+                for (int thread = 0; thread < nrOfThreads; thread++)
+                {
+                    List<NumaNode> nodesOfThread = _numaNodes.Where((n, i) => i % nrOfThreads == thread).ToList();
+                    cpuSets.Add(new CpuSet(nodesOfThread.SelectMany(n => n.Processors), nodesOfThread.Select(n => n.Number)));
+                }
+                return cpuSets;
+            }
+
+            int nrOfProcessors = _numaNodes.Sum(n => n.Processors.Count);
+            if (nrOfThreads > nrOfProcessors)
+            {
+                var processors = _numaNodes.SelectMany(n => n.Processors.Select(p => new { Processor = p, Node = n.Number })).ToList();
+                for (int thread = 0; thread < nrOfThreads; thread++)
+                {
+                    var processor = processors[thread % processors.Count];
+                    cpuSets.Add(new CpuSet(new[] { processor.Processor }, new[] { processor.Node }));
+                }
+                return cpuSets;
+            }
+
+            int[] nrOfThreadsOfNodes = DistributeThreads(nrOfThreads);
+            for (int i = 0; i < _numaNodes.Count; i++)
+            {
+                NumaNode node = _numaNodes[i];
+                int nrOfThreadsOfNode = nrOfThreadsOfNodes[i];
+                int start = 0;
+                for (int thread = 0; thread < nrOfThreadsOfNode; thread++)
+                {
+                    int size = node.Processors.Count / nrOfThreadsOfNode + (thread < node.Processors.Count % nrOfThreadsOfNode ? 1 : 0);
+                    cpuSets.Add(new CpuSet(node.Processors.Skip(start).Take(size), new[] { node.Number }));
+                    start += size;
+                }
+            }
+            return cpuSets;
+        }
+
+        // each node gets one thread; the remaining threads are assigned one by one to the node with the most processors per thread
+        private int[] DistributeThreads(int nrOfThreads)
+        {
+            int[] nrOfThreadsOfNodes = _numaNodes.Select(n => 1).ToArray();
+            for (int remaining = nrOfThreads - _numaNodes.Count; remaining > 0; remaining--)
+            {
+                int node = Enumerable.Range(0, _numaNodes.Count)
+                    .Where(i => nrOfThreadsOfNodes[i] < _numaNodes[i].Processors.Count)
+                    .OrderByDescending(i => (double)_numaNodes[i].Processors.Count / (nrOfThreadsOfNodes[i] + 1))
+                    .ThenBy(i => i)
+                    .First();
+                nrOfThreadsOfNodes[node]++;
+            }
+            return nrOfThreadsOfNodes;
+        }
+
+        /// <summary>
+        /// Returns the NUMA nodes of the processor group of the current process, restricted to the processors the
+        /// process may run on. Falls back to a single node if the topology can not be determined.
+        /// </summary>
+        public static IList<NumaNode> GetNumaNodes(ILogger logger)
+        {
+            ulong processAffinity = (ulong)Process.GetCurrentProcess().ProcessorAffinity.ToInt64();
+            try
+            {
+                if (NativeMethods.GetThreadGroupAffinity(NativeMethods.GetCurrentThread(), out NativeMethods.GROUP_AFFINITY groupAffinity))
+                {
+                    IList<NumaNode> numaNodes = NativeMethods.GetNumaNodes(groupAffinity.Group, processAffinity);
+                    if (numaNodes.Any(n => n.Processors.Count > 0))
+                        return numaNodes;
+                }
+                logger.DebugWarning($"Could not determine NUMA nodes, error code: {Marshal.GetLastWin32Error()}");
+            }
+            catch (Exception e)
+            {
+                logger.DebugWarning($"Could not determine NUMA nodes: {e.Message}");
+            }
+
+            return new List<NumaNode> { new NumaNode(0, GetProcessors(processAffinity)) };
+        }
+
+        private static IEnumerable<int> GetProcessors(ulong affinityMask)
+        {
+            return Enumerable.Range(0, 64).Where(p => (affinityMask & (1UL << p)) != 0);
+        }
+
+        // ReSharper disable InconsistentNaming, FieldCanBeMadeReadOnly.Local, MemberCanBePrivate.Local
+        private static class NativeMethods
+        {
+            private const int RelationNumaNode = 1;
+            private const int ERROR_INSUFFICIENT_BUFFER = 122;
+
+            // offsets within SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX with a NUMA_NODE_RELATIONSHIP
+            private const int OffsetOfSize = 4;
+            private const int OffsetOfNodeNumber = 8;
+            private const int OffsetOfGroupCount = 30;
+            private const int OffsetOfGroupMasks = 32;
+
+            [StructLayout(LayoutKind.Sequential)]
+            internal struct GROUP_AFFINITY
+            {
+                public UIntPtr Mask;
+                public ushort Group;
+                public ushort Reserved0;
+                public ushort Reserved1;
+                public ushort Reserved2;
+            }
+
+            [DllImport("kernel32.dll")]
+            internal static extern IntPtr GetCurrentThread();
+
+            [DllImport("kernel32.dll", SetLastError = true)]
+            [return: MarshalAs(UnmanagedType.Bool)]
+            internal static extern bool GetThreadGroupAffinity(IntPtr thread, out GROUP_AFFINITY groupAffinity);
+
+            [DllImport("kernel32.dll", SetLastError = true)]
+            [return: MarshalAs(UnmanagedType.Bool)]
+            private static extern bool GetLogicalProcessorInformationEx(int relationshipType, IntPtr buffer, ref int returnedLength);
+
+            internal static IList<NumaNode> GetNumaNodes(ushort group, ulong affinityMask)
+            {
+                int length = 0;
+                if (GetLogicalProcessorInformationEx(RelationNumaNode, IntPtr.Zero, ref length) || Marshal.GetLastWin32Error() != ERROR_INSUFFICIENT_BUFFER)
+                    return new List<NumaNode>();
+
+                IntPtr buffer = Marshal.AllocHGlobal(length);
+                try
+                {
+                    if (!GetLogicalProcessorInformationEx(RelationNumaNode, buffer, ref length))
+                        return new List<NumaNode>();
+
+                    var numaNodes = new List<NumaNode>();
+                    int groupAffinitySize = Marshal.SizeOf(typeof(GROUP_AFFINITY));
+                    for (int offset = 0; offset < length; offset += Marshal.ReadInt32(buffer, offset + OffsetOfSize))
+                    {
+                        int nodeNumber = Marshal.ReadInt32(buffer, offset + OffsetOfNodeNumber);
+                        // systems before Windows 10 Build 20348 report a single group and set GroupCount to 0
+                        int groupCount = Math.Max(1, (int)(ushort)Marshal.ReadInt16(buffer, offset + OffsetOfGroupCount));
+
+                        var processors = new List<int>();
+                        for (int i = 0; i < groupCount; i++)
+                        {
+                            var groupMask = (GROUP_AFFINITY)Marshal.PtrToStructure(
+                                IntPtr.Add(buffer, offset + OffsetOfGroupMasks + i * groupAffinitySize), typeof(GROUP_AFFINITY));
+                            if (groupMask.Group == group)
+                                processors.AddRange(GetProcessors(groupMask.Mask.ToUInt64() & affinityMask));
+                        }
+                        numaNodes.Add(new NumaNode(nodeNumber, processors));
+                    }
+                    return numaNodes.OrderBy(n => n.Number).ToList();
+                }
+                finally
+                {
+                    Marshal.FreeHGlobal(buffer);
+                }
+            }
+        }
+        // ReSharper restore InconsistentNaming, FieldCanBeMadeReadOnly.Local, MemberCanBePrivate.Local
+
+    }
+
+}
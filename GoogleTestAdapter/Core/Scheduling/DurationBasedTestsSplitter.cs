@@ -1,5 +1,6 @@
 ﻿// This file has been modified by Microsoft on 6/2017.
 
+using System;
 using System.Collections.Generic;
 using System.Linq;
 using GoogleTestAdapter.Model;
@@ -29,53 +30,41 @@ namespace GoogleTestAdapter.Scheduling
             int targetDuration = _overallDuration / nrOfThreadsToUse;
 
             var splitTestcases = new List<List<TestCase>>();
+            var durationsOfLists = new List<int>();
             var currentList = new List<TestCase>();
             int currentDuration = 0;
-            while (sortedTestcases.Count > 0 && splitTestcases.Count < nrOfThreadsToUse)
+            int nextTestcase = 0;
+            while (nextTestcase < sortedTestcases.Count && splitTestcases.Count < nrOfThreadsToUse)
             {
                 do
                 {
-                    TestCase testcase = sortedTestcases[0];
+                    TestCase testcase = sortedTestcases[nextTestcase++];
 
-                    sortedTestcases.RemoveAt(0);
                     currentList.Add(testcase);
                     currentDuration += _testcaseDurations[testcase];
-                } while (sortedTestcases.Count > 0 && currentDuration <= targetDuration - _testcaseDurations[sortedTestcases[0]]);
+                } while (nextTestcase < sortedTestcases.Count && currentDuration <= targetDuration - _testcaseDurations[sortedTestcases[nextTestcase]]);
 
                 splitTestcases.Add(currentList);
+                durationsOfLists.Add(currentDuration);
                 currentList = new List<TestCase>();
                 currentDuration = 0;
             }
 
-            while (sortedTestcases.Count > 0)
+            // longest processing time first: each remaining test goes to the list with the shortest duration so far;
+            // the set of (duration, index) pairs serves as min-heap, ties are resolved in favor of the lower index
+            var listsByDuration = new SortedSet<Tuple<int, int>>(durationsOfLists.Select((duration, index) => Tuple.Create(duration, index)));
+            for (; nextTestcase < sortedTestcases.Count; nextTestcase++)
             {
-                // TODO performance
-                int index = GetIndexOfListWithShortestDuration(splitTestcases);
-                splitTestcases[index].Add(sortedTestcases[0]);
-                sortedTestcases.RemoveAt(0);
+                TestCase testcase = sortedTestcases[nextTestcase];
+                Tuple<int, int> shortestList = listsByDuration.Min;
+                listsByDuration.Remove(shortestList);
+                splitTestcases[shortestList.Item2].Add(testcase);
+                listsByDuration.Add(Tuple.Create(shortestList.Item1 + _testcaseDurations[testcase], shortestList.Item2));
             }
 
             return splitTestcases;
         }
 
-
-        private int GetIndexOfListWithShortestDuration(List<List<TestCase>> splitTestcases)
-        {
-            int index = 0;
-            int minDuration = int.MaxValue;
-            for (int i = 0; i < splitTestcases.Count; i++)
-            {
-                List<TestCase> testcases = splitTestcases[i];
-                int duration = testcases.Sum(tc => _testcaseDurations[tc]);
-                if (duration < minDuration)
-                {
-                    minDuration = duration;
-                    index = i;
-                }
-            }
-            return index;
-        }
-
     }
 
 }
\ No newline at end of file
@@ -0,0 +1,183 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.Settings;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    /// <summary>
+    /// Splits tests such that executables and suites are spread over as few threads as possible. Besides the
+    /// test durations, the costs of a thread include a startup cost for every executable it launches and a setup
+    /// cost for every suite it runs (SetUpTestSuite() is executed by every process running tests of a suite).
+    /// An executable is assigned to a single thread as a whole if its costs do not exceed the ideal makespan
+    /// (i.e., the overall costs divided by the number of threads); otherwise, it is split into its suites, and
+    /// suites which still exceed the ideal makespan are split into chunks of tests. The resulting pieces are
+    /// assigned longest first to the thread which results in the lowest load, taking into account that
+    /// executables and suites already run by a thread do not cause startup and setup costs again. If assigning
+    /// the executables as a whole results in a makespan which is not worse, splitting is omitted. Startup and
+    /// setup costs are taken from the measured overheads of the executables if available.
+    /// </summary>
+    public class ExecutableAffinityTestsSplitter : ITestsSplitter
+    {
+        public const int DefaultProcessStartupDuration = 100;
+        public const int DefaultSuiteSetupDuration = 0;
+
+        private readonly TestCase[] _testCasesToRun;
+        private readonly TestDurationEstimator _durationEstimator;
+        private readonly SettingsWrapper _settings;
+        private readonly IDictionary<string, ExecutableOverhead> _overheads;
+
+        /// <param name="durations">Known test durations in ms, may be null or incomplete.</param>
+        /// <param name="overheads">Known overheads by executable, may be null or incomplete.</param>
+        public ExecutableAffinityTestsSplitter(IEnumerable<TestCase> testCasesToRun, IDictionary<TestCase, int> durations, SettingsWrapper settings,
+            IDictionary<string, ExecutableOverhead> overheads = null)
+        {
+            _testCasesToRun = testCasesToRun as TestCase[] ?? testCasesToRun.ToArray();
+            _durationEstimator = new TestDurationEstimator(durations ?? new Dictionary<TestCase, int>());
+            _settings = settings;
+            _overheads = overheads ?? new Dictionary<string, ExecutableOverhead>();
+        }
+
+
+        public List<List<TestCase>> SplitTestcases()
+        {
+            int nrOfThreadsToUse = Math.Min(_settings.MaxNrOfThreads, _testCasesToRun.Length);
+            if (nrOfThreadsToUse == 0)
+                return new List<List<TestCase>>();
+
+            List<List<TestCase>> executables = _testCasesToRun
+                .GroupBy(tc => tc.Source)
+                .Select(g => g.ToList())
+                .ToList();
+            long overallCost = executables.Sum(GetCost);
+            long targetCost = (overallCost + nrOfThreadsToUse - 1) / nrOfThreadsToUse;
+
+            var pieces = new List<List<TestCase>>();
+            foreach (List<TestCase> executable in executables)
+            {
+                if (GetCost(executable) <= targetCost)
+                    pieces.Add(executable);
+                else
+                    pieces.AddRange(SplitExecutable(executable, targetCost));
+            }
+
+            // splitting pays off only if the additional process startups are outweighed by the better balance
+            List<ThreadLoad> threads = Assign(pieces, nrOfThreadsToUse);
+            if (pieces.Count > executables.Count)
+            {
+                List<ThreadLoad> threadsWithoutSplitting = Assign(executables, nrOfThreadsToUse);
+                if (threadsWithoutSplitting.Max(t => t.Cost) <= threads.Max(t => t.Cost))
+                    threads = threadsWithoutSplitting;
+            }
+
+            return threads
+                .Where(t => t.TestCases.Count > 0)
+                .Select(t => t.TestCases)
+                .ToList();
+        }
+
+
+        private List<ThreadLoad> Assign(List<List<TestCase>> pieces, int nrOfThreadsToUse)
+        {
+            var threads = new List<ThreadLoad>();
+            for (int i = 0; i < nrOfThreadsToUse; i++)
+            {
+                threads.Add(new ThreadLoad());
+            }
+
+            foreach (List<TestCase> piece in pieces.OrderByDescending(GetCost).ThenBy(p => p[0].Source))
+            {
+                ThreadLoad bestThread = threads
+                    .OrderBy(t => t.Cost + GetMarginalCost(piece, t))
+                    .ThenBy(t => GetMarginalCost(piece, t))
+                    .First();
+                bestThread.Add(piece, GetMarginalCost(piece, bestThread));
+            }
+
+            return threads;
+        }
+
+        private IEnumerable<List<TestCase>> SplitExecutable(List<TestCase> executable, long targetCost)
+        {
+            foreach (List<TestCase> suite in executable.GroupBy(TestDurationEstimator.GetSuiteKey).Select(g => g.ToList()))
+            {
+                if (GetCost(suite) <= targetCost)
+                {
+                    yield return suite;
+                    continue;
+                }
+
+                // each chunk is run by a process of its own (if not assigned to the same thread as other chunks)
+                var chunk = new List<TestCase>();
+                long overheadOfChunk = GetProcessCost(suite[0].Source) + GetSuiteCost(suite[0]);
+                long chunkCost = overheadOfChunk;
+                foreach (TestCase testCase in suite)
+                {
+                    int duration = _durationEstimator.GetDuration(testCase);
+                    if (chunk.Count > 0 && chunkCost + duration > targetCost)
+                    {
+                        yield return chunk;
+                        chunk = new List<TestCase>();
+                        chunkCost = overheadOfChunk;
+                    }
+                    chunk.Add(testCase);
+                    chunkCost += duration;
+                }
+                yield return chunk;
+            }
+        }
+
+        private long GetCost(List<TestCase> testCases)
+        {
+            return GetMarginalCost(testCases, new ThreadLoad());
+        }
+
+        private long GetMarginalCost(List<TestCase> testCases, ThreadLoad thread)
+        {
+            long processCosts = testCases
+                .Select(tc => tc.Source)
+                .Distinct()
+                .Where(s => !thread.Executables.Contains(s))
+                .Sum(GetProcessCost);
+            long suiteCosts = testCases
+                .GroupBy(TestDurationEstimator.GetSuiteKey)
+                .Where(g => !thread.Suites.Contains(g.Key))
+                .Sum(g => GetSuiteCost(g.First()));
+            return processCosts + suiteCosts + testCases.Sum(tc => (long)_durationEstimator.GetDuration(tc));
+        }
+
+        private long GetProcessCost(string executable)
+        {
+            return _overheads.TryGetValue(executable, out ExecutableOverhead overhead)
+                ? overhead.ProcessDuration
+                : DefaultProcessStartupDuration;
+        }
+
+        private long GetSuiteCost(TestCase testCase)
+        {
+            return _overheads.TryGetValue(testCase.Source, out ExecutableOverhead overhead)
+                   && overhead.SuiteDurations.TryGetValue(testCase.FullyQualifiedName.Split('.')[0], out int duration)
+                ? duration
+                : DefaultSuiteSetupDuration;
+        }
+
+        private class ThreadLoad
+        {
+            internal readonly List<TestCase> TestCases = new List<TestCase>();
+            internal readonly ISet<string> Executables = new HashSet<string>();
+            internal readonly ISet<string> Suites = new HashSet<string>();
+            internal long Cost;
+
+            internal void Add(List<TestCase> testCases, long marginalCost)
+            {
+                TestCases.AddRange(testCases);
+                Executables.UnionWith(testCases.Select(tc => tc.Source));
+                Suites.UnionWith(testCases.Select(TestDurationEstimator.GetSuiteKey));
+                Cost += marginalCost;
+            }
+        }
+
+    }
+
+}
@@ -0,0 +1,28 @@
+﻿using System.Collections.Generic;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    /// <summary>
+    /// Time spent by a test executable outside of its tests. All durations are in ms.
+    /// </summary>
+    public class ExecutableOverhead
+    {
+        /// <summary>
+        /// Time from process start until the first test suite starts (including global test environments' setup).
+        /// </summary>
+        public int StartupDuration { get; set; }
+
+        /// <summary>
+        /// Time from the end of the last test until process exit.
+        /// </summary>
+        public int ShutdownDuration { get; set; }
+
+        /// <summary>
+        /// Time spent in a test suite outside of its tests (e.g. by SetUpTestSuite() and TearDownTestSuite()), by suite name.
+        /// </summary>
+        public IDictionary<string, int> SuiteDurations { get; } = new Dictionary<string, int>();
+
+        public int ProcessDuration => StartupDuration + ShutdownDuration;
+    }
+
+}
@@ -0,0 +1,10 @@
+﻿using System;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    public interface IMachineLoadSampler : IDisposable
+    {
+        MachineLoad Sample();
+    }
+
+}
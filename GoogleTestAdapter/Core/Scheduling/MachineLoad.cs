@@ -0,0 +1,26 @@
+﻿namespace GoogleTestAdapter.Scheduling
+{
+    public class MachineLoad
+    {
+        /// <summary>Overall CPU utilization in percent (0..100)</summary>
+        public float CpuUtilization { get; }
+
+        /// <summary>Number of threads ready to run, but waiting for a processor</summary>
+        public float RunQueueLength { get; }
+
+        public float AvailableMemoryInMb { get; }
+
+        public MachineLoad(float cpuUtilization, float runQueueLength, float availableMemoryInMb)
+        {
+            CpuUtilization = cpuUtilization;
+            RunQueueLength = runQueueLength;
+            AvailableMemoryInMb = availableMemoryInMb;
+        }
+
+        public override string ToString()
+        {
+            return $"CPU {CpuUtilization:F0}%, run queue {RunQueueLength:F0}, available memory {AvailableMemoryInMb:F0}MB";
+        }
+    }
+
+}
@@ -0,0 +1,199 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading;
+using GoogleTestAdapter.Common;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    /// <summary>
+    /// Keeps the predicted memory usage of the concurrently running test processes within a budget. The memory
+    /// usage of a process is predicted from the peak committed memory of its executable (including child processes,
+    /// see ResourceUsage.PeakMemoryInBytes as measured by the job object): as measured earlier during the
+    /// current test run, or as stored with the test durations by a previous run. A process is only admitted if the
+    /// predictions of all admitted processes plus its own fit into the budget; processes of executables without
+    /// history are predicted to use no memory. A process is always admitted if no other process is running, even
+    /// if it exceeds the budget on its own.
+    /// Processes which fit may be admitted ahead of waiting ones, but only a limited number of times: once a waiting
+    /// process has been bypassed that often, later processes wait behind it (in FIFO order) until it has been admitted.
+    /// </summary>
+    public class MemoryAdmissionController : IDisposable
+    {
+        private class Admission : IDisposable
+        {
+            private readonly MemoryAdmissionController _controller;
+            private readonly long _predictedPeakMemory;
+            private int _isReleased;
+
+            internal Admission(MemoryAdmissionController controller, long predictedPeakMemory)
+            {
+                _controller = controller;
+                _predictedPeakMemory = predictedPeakMemory;
+            }
+
+            public void Dispose()
+            {
+                if (Interlocked.Exchange(ref _isReleased, 1) == 0)
+                    _controller.Release(_predictedPeakMemory);
+            }
+        }
+
+        private class Waiter
+        {
+            internal long Sequence;
+            internal long PredictedPeakMemory;
+            internal int NrOfBypasses;
+        }
+
+        public const int DefaultMaxNrOfBypasses = 8;
+
+        private readonly object _lock = new object();
+        private readonly LinkedList<Waiter> _waiters = new LinkedList<Waiter>();
+        private readonly int _maxNrOfBypasses;
+        private readonly IDictionary<string, long> _peakMemories = new Dictionary<string, long>(StringComparer.OrdinalIgnoreCase);
+        private readonly ISet<string> _executablesMeasuredInThisRun = new HashSet<string>(StringComparer.OrdinalIgnoreCase);
+        private readonly ILogger _logger;
+
+        private long _nextSequence;
+        private long _admittedMemory;
+        private int _nrOfAdmittedProcesses;
+        private bool _isDisposed;
+
+        public MemoryAdmissionController(long budgetInBytes, ILogger logger, int maxNrOfBypasses = DefaultMaxNrOfBypasses)
+        {
+            if (budgetInBytes <= 0)
+                throw new ArgumentOutOfRangeException(nameof(budgetInBytes), budgetInBytes, "Expected a number greater than 0.");
+            if (maxNrOfBypasses < 0)
+                throw new ArgumentOutOfRangeException(nameof(maxNrOfBypasses), maxNrOfBypasses, "Expected a non-negative number.");
+
+            BudgetInBytes = budgetInBytes;
+            _logger = logger;
+            _maxNrOfBypasses = maxNrOfBypasses;
+        }
+
+        public long BudgetInBytes { get; }
+
+        /// <summary>
+        /// Returns the predicted peak memory usage of a process of the given executable in bytes, 0 if unknown.
+        /// </summary>
+        public long GetPredictedPeakMemory(string executable)
+        {
+            lock (_lock)
+            {
+                if (_peakMemories.TryGetValue(executable, out long peakMemory))
+                    return peakMemory;
+            }
+
+            long storedPeakMemory = ReadStoredPeakMemory(executable);
+            lock (_lock)
+            {
+                if (!_peakMemories.ContainsKey(executable))
+                    _peakMemories[executable] = storedPeakMemory;
+                return _peakMemories[executable];
+            }
+        }
+
+        /// <summary>
+        /// Blocks until a process of the given executable may be started. The returned admission must be disposed
+        /// as soon as the process has finished.
+        /// </summary>
+        public IDisposable Acquire(string executable, string threadName = "")
+        {
+            long predictedPeakMemory = GetPredictedPeakMemory(executable);
+            lock (_lock)
+            {
+                var waiter = new Waiter { Sequence = _nextSequence++, PredictedPeakMemory = predictedPeakMemory };
+                if (!_isDisposed && !CanBeAdmitted(waiter))
+                {
+                    _logger.DebugInfo($"{threadName}Memory budget: waiting for {ToMb(predictedPeakMemory)}MB to start {executable}, "
+                        + $"{_nrOfAdmittedProcesses} processes with {ToMb(_admittedMemory)}MB of {ToMb(BudgetInBytes)}MB are running, {_waiters.Count} processes are waiting");
+                    LinkedListNode<Waiter> node = _waiters.AddLast(waiter);
+                    while (!_isDisposed && !CanBeAdmitted(waiter))
+                    {
+                        Monitor.Wait(_lock);
+                    }
+                    _waiters.Remove(node);
+                }
+                Admit(waiter);
+            }
+            return new Admission(this, predictedPeakMemory);
+        }
+
+        /// <summary>
+        /// Updates the prediction for the given executable with the peak memory usage of one of its processes.
+        /// Returns the highest peak memory usage of the executable's processes measured in this run, which is the
+        /// value to be stored for future runs.
+        /// </summary>
+        public long ReportPeakMemory(string executable, long peakMemoryInBytes)
+        {
+            lock (_lock)
+            {
+                if (_executablesMeasuredInThisRun.Add(executable) || !_peakMemories.TryGetValue(executable, out long peakMemory))
+                    peakMemory = 0;
+                _peakMemories[executable] = Math.Max(peakMemory, peakMemoryInBytes);
+                return _peakMemories[executable];
+            }
+        }
+
+        public void Dispose()
+        {
+            lock (_lock)
+            {
+                _isDisposed = true;
+                Monitor.PulseAll(_lock);
+            }
+        }
+
+        private bool CanBeAdmitted(Waiter waiter)
+        {
+            bool fits = _nrOfAdmittedProcesses == 0 || _admittedMemory + waiter.PredictedPeakMemory <= BudgetInBytes;
+            return fits && !_waiters.Any(w => w.Sequence < waiter.Sequence && w.NrOfBypasses >= _maxNrOfBypasses);
+        }
+
+        /// <summary>
+        /// Waiters which arrived earlier than the admitted process, but are still waiting, have been bypassed by it
+        /// </summary>
+        private void Admit(Waiter waiter)
+        {
+            foreach (Waiter bypassedWaiter in _waiters.Where(w => w.Sequence < waiter.Sequence))
+            {
+                bypassedWaiter.NrOfBypasses++;
+            }
+            _admittedMemory += waiter.PredictedPeakMemory;
+            _nrOfAdmittedProcesses++;
+            // waiters which have been blocked by this (starving) one might proceed now
+            Monitor.PulseAll(_lock);
+        }
+
+        private void Release(long predictedPeakMemory)
+        {
+            lock (_lock)
+            {
+                _admittedMemory -= predictedPeakMemory;
+                _nrOfAdmittedProcesses--;
+                Monitor.PulseAll(_lock);
+            }
+        }
+
+        private long ReadStoredPeakMemory(string executable)
+        {
+            try
+            {
+                return new TestDurationSerializer().ReadPeakMemories(new[] { executable })
+                    .TryGetValue(executable, out long peakMemory) ? peakMemory : 0;
+            }
+            catch (Exception e)
+            {
+                _logger.DebugWarning($"Memory budget: could not read peak memory of executable {executable}: {e.Message}");
+                return 0;
+            }
+        }
+
+        private static long ToMb(long bytes)
+        {
+            return bytes / (1024 * 1024);
+        }
+
+    }
+
+}
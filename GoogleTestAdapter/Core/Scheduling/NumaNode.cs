@@ -0,0 +1,25 @@
+﻿using System.Collections.Generic;
+using System.Linq;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    public class NumaNode
+    {
+        public int Number { get; }
+
+        /// <summary>Logical processors of the node (within the processor group of the current process)</summary>
+        public IList<int> Processors { get; }
+
+        public NumaNode(int number, IEnumerable<int> processors)
+        {
+            Number = number;
+            Processors = processors.OrderBy(p => p).ToList();
+        }
+
+        public override string ToString()
+        {
+            return $"NUMA node {Number}: processors {CpuSet.FormatNumbers(Processors)}";
+        }
+    }
+
+}
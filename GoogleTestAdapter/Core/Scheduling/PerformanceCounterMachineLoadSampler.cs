@@ -0,0 +1,31 @@
+﻿using System.Diagnostics;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    public class PerformanceCounterMachineLoadSampler : IMachineLoadSampler
+    {
+        private readonly PerformanceCounter _cpuCounter = new PerformanceCounter("Processor", "% Processor Time", "_Total");
+        private readonly PerformanceCounter _runQueueCounter = new PerformanceCounter("System", "Processor Queue Length");
+        private readonly PerformanceCounter _memoryCounter = new PerformanceCounter("Memory", "Available MBytes");
+
+        public PerformanceCounterMachineLoadSampler()
+        {
+            // the first value of a rate counter is always 0
+            _cpuCounter.NextValue();
+        }
+
+        public MachineLoad Sample()
+        {
+            return new MachineLoad(_cpuCounter.NextValue(), _runQueueCounter.NextValue(), _memoryCounter.NextValue());
+        }
+
+        public void Dispose()
+        {
+            _cpuCounter.Dispose();
+            _runQueueCounter.Dispose();
+            _memoryCounter.Dispose();
+        }
+
+    }
+
+}
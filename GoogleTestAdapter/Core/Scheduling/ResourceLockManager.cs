@@ -0,0 +1,140 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading;
+using GoogleTestAdapter.Model;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    /// <summary>
+    /// Prevents tests from running concurrently if they share a resource, as declared by traits (assigned via
+    /// TEST_TRAITS or the trait regexes): tests with trait Resource=&lt;name&gt; never run at the same time as other
+    /// tests holding the same resource, and tests with trait Exclusive=true only run if no other test process is running.
+    /// Each test process acquires the locks of all tests it is running before it is started.
+    /// </summary>
+    public class ResourceLockManager
+    {
+        public const string ResourceTrait = "Resource";
+        public const string ExclusiveTrait = "Exclusive";
+
+        private class Locks : IDisposable
+        {
+            private readonly ResourceLockManager _manager;
+            private readonly ISet<string> _resources;
+            private readonly bool _isExclusive;
+            private int _isReleased;
+
+            internal Locks(ResourceLockManager manager, ISet<string> resources, bool isExclusive)
+            {
+                _manager = manager;
+                _resources = resources;
+                _isExclusive = isExclusive;
+            }
+
+            public void Dispose()
+            {
+                if (Interlocked.Exchange(ref _isReleased, 1) == 0)
+                    _manager.Release(_resources, _isExclusive);
+            }
+        }
+
+        private readonly object _lock = new object();
+        private readonly ISet<string> _heldResources = new HashSet<string>(StringComparer.OrdinalIgnoreCase);
+        private int _nrOfRunningProcesses;
+        private int _nrOfWaitingExclusiveProcesses;
+        private bool _isExclusiveProcessRunning;
+
+        public static IEnumerable<string> GetResources(TestCase testCase)
+        {
+            return testCase.Traits
+                .Where(t => string.Equals(t.Name, ResourceTrait, StringComparison.OrdinalIgnoreCase))
+                .Select(t => t.Value?.Trim())
+                .Where(r => !string.IsNullOrEmpty(r));
+        }
+
+        public static bool IsExclusive(TestCase testCase)
+        {
+            return testCase.Traits.Any(t =>
+                string.Equals(t.Name, ExclusiveTrait, StringComparison.OrdinalIgnoreCase)
+                && string.Equals(t.Value?.Trim(), "true", StringComparison.OrdinalIgnoreCase));
+        }
+
+        public static bool IsConstrained(TestCase testCase)
+        {
+            return IsExclusive(testCase) || GetResources(testCase).Any();
+        }
+
+        /// <summary>
+        /// Tests of the same group require the same locks and can thus run in the same process; tests without
+        /// resource constraints form the first group. Running constrained tests in processes of their own avoids
+        /// holding locks (and thus blocking other threads) while unconstrained tests are running.
+        /// </summary>
+        public static IEnumerable<List<TestCase>> GroupByLocks(IEnumerable<TestCase> testCases)
+        {
+            return testCases
+                .GroupBy(GetLockKey)
+                .OrderBy(g => g.Key, StringComparer.Ordinal)
+                .Select(g => g.ToList());
+        }
+
+        public static string GetLockKey(TestCase testCase)
+        {
+            string resources = string.Join(",", GetResources(testCase)
+                .Select(r => r.ToLowerInvariant())
+                .Distinct()
+                .OrderBy(r => r, StringComparer.Ordinal));
+            return IsExclusive(testCase) ? $"{ExclusiveTrait}:{resources}" : resources;
+        }
+
+        /// <summary>
+        /// Blocks until a process running the given tests may be started. The returned locks must be disposed as
+        /// soon as the process has finished. Waiting exclusive tests take precedence over other tests such that
+        /// they are not starved.
+        /// </summary>
+        public IDisposable Acquire(IEnumerable<TestCase> testCases)
+        {
+            TestCase[] testCasesAsArray = testCases as TestCase[] ?? testCases.ToArray();
+            ISet<string> resources = new HashSet<string>(testCasesAsArray.SelectMany(GetResources), StringComparer.OrdinalIgnoreCase);
+            bool isExclusive = testCasesAsArray.Any(IsExclusive);
+
+            lock (_lock)
+            {
+                if (isExclusive)
+                {
+                    _nrOfWaitingExclusiveProcesses++;
+                    while (_nrOfRunningProcesses > 0)
+                    {
+                        Monitor.Wait(_lock);
+                    }
+                    _nrOfWaitingExclusiveProcesses--;
+                    _isExclusiveProcessRunning = true;
+                }
+                else
+                {
+                    while (_isExclusiveProcessRunning || _nrOfWaitingExclusiveProcesses > 0 || _heldResources.Overlaps(resources))
+                    {
+                        Monitor.Wait(_lock);
+                    }
+                }
+
+                _nrOfRunningProcesses++;
+                _heldResources.UnionWith(resources);
+            }
+            return new Locks(this, resources, isExclusive);
+        }
+
+        private void Release(ISet<string> resources, bool isExclusive)
+        {
+            lock (_lock)
+            {
+                _nrOfRunningProcesses--;
+                _heldResources.ExceptWith(resources);
+                if (isExclusive)
+                    _isExclusiveProcessRunning = false;
+                Monitor.PulseAll(_lock);
+            }
+        }
+
+    }
+
+}
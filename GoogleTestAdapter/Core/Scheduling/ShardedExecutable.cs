@@ -0,0 +1,72 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using GoogleTestAdapter.Model;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    /// <summary>
+    /// An executable which is run by means of Google Test's native sharding, i.e. by a number of processes
+    /// each of which runs the complete executable with GTEST_TOTAL_SHARDS and GTEST_SHARD_INDEX set. Since it is not known
+    /// in advance which test will be run by which shard, the results of all shards are collected here; tests without result
+    /// are determined as soon as the last shard has finished.
+    /// </summary>
+    public class ShardedExecutable
+    {
+        private readonly object _lock = new object();
+        private readonly ISet<TestCase> _testCasesWithResults = new HashSet<TestCase>();
+        private TestCase _crashedTestCase;
+        private int _nrOfFinishedShards;
+
+        public ShardedExecutable(string executable, IEnumerable<TestCase> testCases, int nrOfShards)
+        {
+            if (nrOfShards < 1)
+                throw new ArgumentOutOfRangeException(nameof(nrOfShards));
+
+            Executable = executable;
+            TestCases = testCases.ToList();
+            NrOfShards = nrOfShards;
+        }
+
+        public string Executable { get; }
+
+        /// <summary>
+        /// The selected tests of the executable (without the exit code test)
+        /// </summary>
+        public IList<TestCase> TestCases { get; }
+
+        public int NrOfShards { get; }
+
+        public IEnumerable<TestShard> Shards => Enumerable.Range(0, NrOfShards).Select(i => new TestShard(this, i));
+
+        /// <summary>
+        /// Records the tests for which the given shard has produced results. Returns true if this has been the last
+        /// shard to finish; in that case, the selected tests without result and the test which has crashed one of
+        /// the shards (if any) are returned.
+        /// </summary>
+        public bool FinishShard(IEnumerable<TestCase> testCasesWithResults, TestCase crashedTestCase,
+            out IList<TestCase> testCasesWithoutResults, out TestCase crashedTestCaseOfAnyShard)
+        {
+            lock (_lock)
+            {
+                _testCasesWithResults.UnionWith(testCasesWithResults);
+                if (_crashedTestCase == null)
+                    _crashedTestCase = crashedTestCase;
+
+                _nrOfFinishedShards++;
+                if (_nrOfFinishedShards < NrOfShards)
+                {
+                    testCasesWithoutResults = null;
+                    crashedTestCaseOfAnyShard = null;
+                    return false;
+                }
+
+                testCasesWithoutResults = TestCases.Where(tc => !_testCasesWithResults.Contains(tc)).ToList();
+                crashedTestCaseOfAnyShard = _crashedTestCase;
+                return true;
+            }
+        }
+
+    }
+
+}
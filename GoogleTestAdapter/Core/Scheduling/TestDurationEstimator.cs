@@ -0,0 +1,84 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using GoogleTestAdapter.Model;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    /// <summary>
+    /// Completes partially known test durations: a test without known duration is assumed to take as long as
+    /// the median known test of its suite, of its executable if no test of the suite is known, or of all tests
+    /// otherwise.
+    /// </summary>
+    public class TestDurationEstimator
+    {
+        private readonly IDictionary<TestCase, int> _knownDurations;
+
+        private readonly IDictionary<string, int> _suiteMedians;
+        private readonly IDictionary<string, int> _executableMedians;
+        private readonly int _overallMedian;
+
+        public TestDurationEstimator(IDictionary<TestCase, int> knownDurations)
+        {
+            _knownDurations = knownDurations;
+
+            _suiteMedians = knownDurations
+                .GroupBy(kvp => GetSuiteKey(kvp.Key))
+                .ToDictionary(g => g.Key, g => Median(g.Select(kvp => kvp.Value)));
+            _executableMedians = knownDurations
+                .GroupBy(kvp => kvp.Key.Source)
+                .ToDictionary(g => g.Key, g => Median(g.Select(kvp => kvp.Value)));
+            _overallMedian = knownDurations.Count > 0 ? Median(knownDurations.Values) : 1;
+        }
+
+        public IDictionary<TestCase, int> GetDurations(IEnumerable<TestCase> testCases)
+        {
+            var durations = new Dictionary<TestCase, int>();
+            foreach (TestCase testCase in testCases)
+            {
+                durations[testCase] = GetDuration(testCase);
+            }
+            return durations;
+        }
+
+        /// <summary>
+        /// Returns the (estimated) durations of the given tests, but at least 1, such that they can be used as
+        /// weights when distributing or ordering tests.
+        /// </summary>
+        public IDictionary<TestCase, int> GetWeights(IEnumerable<TestCase> testCases)
+        {
+            var weights = new Dictionary<TestCase, int>();
+            foreach (TestCase testCase in testCases)
+            {
+                weights[testCase] = Math.Max(1, GetDuration(testCase));
+            }
+            return weights;
+        }
+
+        public int GetDuration(TestCase testCase)
+        {
+            if (_knownDurations.TryGetValue(testCase, out int duration)
+                || _suiteMedians.TryGetValue(GetSuiteKey(testCase), out duration)
+                || _executableMedians.TryGetValue(testCase.Source, out duration))
+                return duration;
+
+            return _overallMedian;
+        }
+
+        internal static string GetSuiteKey(TestCase testCase)
+        {
+            return $"{testCase.Source}:{testCase.FullyQualifiedName.Split('.')[0]}";
+        }
+
+        private static int Median(IEnumerable<int> values)
+        {
+            List<int> sortedValues = values.OrderBy(v => v).ToList();
+            int middle = sortedValues.Count / 2;
+            return sortedValues.Count % 2 == 1
+                ? sortedValues[middle]
+                : (int)(((long)sortedValues[middle - 1] + sortedValues[middle]) / 2);
+        }
+
+    }
+
+}
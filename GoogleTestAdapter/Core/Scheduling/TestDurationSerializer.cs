@@ -24,12 +24,55 @@ namespace GoogleTestAdapter.Scheduling
     {
         public string Executable { get; set; }
         public List<TestDuration> TestDurations { get; set; } = new List<TestDuration>();
+
+        public ProcessOverhead ProcessOverhead { get; set; }
+
+        /// <summary>
+        /// Peak committed memory of the executable's processes in bytes
+        /// </summary>
+        public long ProcessPeakMemory { get; set; }
+        public bool ShouldSerializeProcessPeakMemory() { return ProcessPeakMemory != 0; }
+
+        public List<SuiteOverhead> SuiteOverheads { get; set; } = new List<SuiteOverhead>();
+        public bool ShouldSerializeSuiteOverheads() { return SuiteOverheads.Count > 0; }
+    }
+
+    /// <summary>
+    /// Durations in ms
+    /// </summary>
+    [Serializable]
+    public class ProcessOverhead
+    {
+        [XmlAttribute]
+        public int Startup { get; set; }
+
+        [XmlAttribute]
+        public int Shutdown { get; set; }
+    }
+
+    /// <summary>
+    /// Duration in ms
+    /// </summary>
+    [Serializable]
+    public struct SuiteOverhead
+    {
+        public SuiteOverhead(string suite, int duration) : this()
+        {
+            Suite = suite;
+            Duration = duration;
+        }
+
+        [XmlAttribute]
+        public string Suite { get; set; }
+
+        [XmlAttribute]
+        public int Duration { get; set; }
     }
 
     [Serializable]
     public struct TestDuration
     {
-        public TestDuration(string test, int duration)
+        public TestDuration(string test, int duration) : this()
         {
             Test = test;
             Duration = duration;
@@ -40,6 +83,65 @@ namespace GoogleTestAdapter.Scheduling
 
         [XmlAttribute]
         public int Duration { get; set; }
+
+        /// <summary>
+        /// User plus kernel time in ms
+        /// </summary>
+        [XmlAttribute]
+        public long CpuTime { get; set; }
+        public bool ShouldSerializeCpuTime() { return CpuTime != 0; }
+
+        /// <summary>
+        /// Peak memory in KB
+        /// </summary>
+        [XmlAttribute]
+        public long PeakMemory { get; set; }
+        public bool ShouldSerializePeakMemory() { return PeakMemory != 0; }
+
+        [XmlAttribute]
+        public long PageFaults { get; set; }
+        public bool ShouldSerializePageFaults() { return PageFaults != 0; }
+
+        [XmlAttribute]
+        public long ReadBytes { get; set; }
+        public bool ShouldSerializeReadBytes() { return ReadBytes != 0; }
+
+        [XmlAttribute]
+        public long WriteBytes { get; set; }
+        public bool ShouldSerializeWriteBytes() { return WriteBytes != 0; }
+
+        /// <summary>
+        /// Outcome of the last run, i.e. "Passed" or "Failed"
+        /// </summary>
+        [XmlAttribute]
+        public string Outcome { get; set; }
+        public bool ShouldSerializeOutcome() { return Outcome != null; }
+
+        internal bool HasResourceUsage => CpuTime != 0 || PeakMemory != 0 || PageFaults != 0 || ReadBytes != 0 || WriteBytes != 0;
+
+        internal void SetResourceUsage(ResourceUsage resourceUsage)
+        {
+            CpuTime = (long)Math.Ceiling(resourceUsage.CpuTime.TotalMilliseconds);
+            PeakMemory = resourceUsage.PeakMemoryInBytes / 1024;
+            PageFaults = resourceUsage.PageFaults;
+            ReadBytes = resourceUsage.ReadBytes;
+            WriteBytes = resourceUsage.WriteBytes;
+        }
+
+        /// <summary>
+        /// The split between user and kernel time is not persisted; CPU time is reported as user time
+        /// </summary>
+        internal ResourceUsage ToResourceUsage()
+        {
+            return new ResourceUsage
+            {
+                UserTime = TimeSpan.FromMilliseconds(CpuTime),
+                PeakMemoryInBytes = PeakMemory * 1024,
+                PageFaults = PageFaults,
+                ReadBytes = ReadBytes,
+                WriteBytes = WriteBytes
+            };
+        }
     }
 
 
@@ -72,6 +174,129 @@ namespace GoogleTestAdapter.Scheduling
             return durations;
         }
 
+        /// <summary>
+        /// Returns the resources consumed by the given tests when they were run last, as far as they have been measured.
+        /// </summary>
+        public IDictionary<TestCase, ResourceUsage> ReadResourceUsages(IEnumerable<TestCase> testcases)
+        {
+            var resourceUsages = new Dictionary<TestCase, ResourceUsage>();
+            foreach (KeyValuePair<string, List<TestCase>> executableAndTestCases in testcases.GroupByExecutable())
+            {
+                foreach (KeyValuePair<TestCase, TestDuration> testCaseAndDuration in ReadTestDurationEntries(executableAndTestCases.Key, executableAndTestCases.Value))
+                {
+                    if (testCaseAndDuration.Value.HasResourceUsage)
+                        resourceUsages.Add(testCaseAndDuration.Key, testCaseAndDuration.Value.ToResourceUsage());
+                }
+            }
+            return resourceUsages;
+        }
+
+        /// <summary>
+        /// Returns the outcomes (passed or failed) of the given tests when they were run last, as far as they are known.
+        /// </summary>
+        public IDictionary<TestCase, TestOutcome> ReadLastOutcomes(IEnumerable<TestCase> testcases)
+        {
+            var outcomes = new Dictionary<TestCase, TestOutcome>();
+            foreach (KeyValuePair<string, List<TestCase>> executableAndTestCases in testcases.GroupByExecutable())
+            {
+                foreach (KeyValuePair<TestCase, TestDuration> testCaseAndDuration in ReadTestDurationEntries(executableAndTestCases.Key, executableAndTestCases.Value))
+                {
+                    if (Enum.TryParse(testCaseAndDuration.Value.Outcome, out TestOutcome outcome))
+                        outcomes.Add(testCaseAndDuration.Key, outcome);
+                }
+            }
+            return outcomes;
+        }
+
+        /// <summary>
+        /// Returns the overheads of the given executables as measured when they were run last, as far as they are known.
+        /// </summary>
+        public IDictionary<string, ExecutableOverhead> ReadExecutableOverheads(IEnumerable<string> executables)
+        {
+            var overheads = new Dictionary<string, ExecutableOverhead>();
+            foreach (string executable in executables.Distinct())
+            {
+                string durationsFile = GetDurationsFile(executable);
+                if (!File.Exists(durationsFile))
+                    continue;
+
+                GtaTestDurations container;
+                lock (Lock)
+                {
+                    container = LoadTestDurations(durationsFile);
+                }
+                if (container.ProcessOverhead == null && container.SuiteOverheads.Count == 0)
+                    continue;
+
+                var overhead = new ExecutableOverhead
+                {
+                    StartupDuration = container.ProcessOverhead?.Startup ?? 0,
+                    ShutdownDuration = container.ProcessOverhead?.Shutdown ?? 0
+                };
+                foreach (SuiteOverhead suiteOverhead in container.SuiteOverheads)
+                {
+                    overhead.SuiteDurations[suiteOverhead.Suite] = suiteOverhead.Duration;
+                }
+                overheads.Add(executable, overhead);
+            }
+            return overheads;
+        }
+
+        /// <summary>
+        /// Replaces the process overhead of the given executable and the overheads of the suites contained in the given overhead.
+        /// </summary>
+        public void UpdateExecutableOverhead(string executable, ExecutableOverhead overhead)
+        {
+            lock (Lock)
+            {
+                GtaTestDurations container = LoadOrCreateTestDurations(executable);
+
+                container.ProcessOverhead = new ProcessOverhead { Startup = overhead.StartupDuration, Shutdown = overhead.ShutdownDuration };
+                IDictionary<string, SuiteOverhead> suiteOverheads = container.SuiteOverheads.ToDictionary(so => so.Suite, so => so);
+                foreach (KeyValuePair<string, int> suiteDuration in overhead.SuiteDurations)
+                {
+                    suiteOverheads[suiteDuration.Key] = new SuiteOverhead(suiteDuration.Key, suiteDuration.Value);
+                }
+                container.SuiteOverheads.Clear();
+                container.SuiteOverheads.AddRange(suiteOverheads.Values);
+
+                SaveTestDurations(container, GetDurationsFile(executable));
+            }
+        }
+
+        /// <summary>
+        /// Returns the peak memory usages in bytes of the processes of the given executables as measured when they were run last, as far as they are known.
+        /// </summary>
+        public IDictionary<string, long> ReadPeakMemories(IEnumerable<string> executables)
+        {
+            var peakMemories = new Dictionary<string, long>();
+            foreach (string executable in executables.Distinct())
+            {
+                string durationsFile = GetDurationsFile(executable);
+                if (!File.Exists(durationsFile))
+                    continue;
+
+                GtaTestDurations container;
+                lock (Lock)
+                {
+                    container = LoadTestDurations(durationsFile);
+                }
+                if (container.ProcessPeakMemory > 0)
+                    peakMemories.Add(executable, container.ProcessPeakMemory);
+            }
+            return peakMemories;
+        }
+
+        public void UpdatePeakMemory(string executable, long peakMemoryInBytes)
+        {
+            lock (Lock)
+            {
+                GtaTestDurations container = LoadOrCreateTestDurations(executable);
+                container.ProcessPeakMemory = peakMemoryInBytes;
+                SaveTestDurations(container, GetDurationsFile(executable));
+            }
+        }
+
         public void UpdateTestDurations(IEnumerable<TestResult> testResults)
         {
             IDictionary<string, List<TestResult>> groupedTestcases = GroupTestResultsByExecutable(testResults);
@@ -88,7 +313,12 @@ namespace GoogleTestAdapter.Scheduling
 
         private IDictionary<TestCase, int> ReadTestDurations(string executable, List<TestCase> testcases)
         {
-            var durations = new Dictionary<TestCase, int>();
+            return ReadTestDurationEntries(executable, testcases).ToDictionary(kvp => kvp.Key, kvp => kvp.Value.Duration);
+        }
+
+        private IDictionary<TestCase, TestDuration> ReadTestDurationEntries(string executable, List<TestCase> testcases)
+        {
+            var durations = new Dictionary<TestCase, TestDuration>();
             string durationsFile = GetDurationsFile(executable);
             if (!File.Exists(durationsFile))
             {
@@ -105,13 +335,38 @@ namespace GoogleTestAdapter.Scheduling
             foreach (TestCase testcase in testcases)
             {
                 if (durationsMap.TryGetValue(testcase.FullyQualifiedName, out var pair))
-                    durations.Add(testcase, pair.Duration);
+                    durations.Add(testcase, pair);
             }
 
             return durations;
         }
 
         private void UpdateTestDurations(string executable, List<TestResult> testresults)
+        {
+            string durationsFile = GetDurationsFile(executable);
+            GtaTestDurations container = LoadOrCreateTestDurations(executable);
+
+            IDictionary<string, TestDuration> durations = container.TestDurations.ToDictionary(x => x.Test, x => x);
+            foreach (TestResult testResult in 
+                testresults.Where(tr => tr.Outcome == TestOutcome.Passed || tr.Outcome == TestOutcome.Failed))
+            {
+                string testName = testResult.TestCase.FullyQualifiedName;
+                var testDuration = new TestDuration(testName, GetDuration(testResult)) { Outcome = testResult.Outcome.ToString() };
+                // results parsed from the console output do not carry resource usages - keep the known ones
+                if (testResult.ResourceUsage != null)
+                    testDuration.SetResourceUsage(testResult.ResourceUsage);
+                else if (durations.TryGetValue(testName, out TestDuration previousDuration) && previousDuration.HasResourceUsage)
+                    testDuration.SetResourceUsage(previousDuration.ToResourceUsage());
+                durations[testName] = testDuration;
+            }
+
+            container.TestDurations.Clear();
+            container.TestDurations.AddRange(durations.Values);
+
+            SaveTestDurations(container, durationsFile);
+        }
+
+        private GtaTestDurations LoadOrCreateTestDurations(string executable)
         {
             string durationsFile = GetDurationsFile(executable);
             GtaTestDurations container = null;
@@ -127,19 +382,7 @@ namespace GoogleTestAdapter.Scheduling
             if (container == null)
                 container = new GtaTestDurations();
             container.Executable = Path.GetFullPath(executable);
-
-            IDictionary<string, TestDuration> durations = container.TestDurations.ToDictionary(x => x.Test, x => x);
-            foreach (TestResult testResult in 
-                testresults.Where(tr => tr.Outcome == TestOutcome.Passed || tr.Outcome == TestOutcome.Failed))
-            {
-                durations[testResult.TestCase.FullyQualifiedName] =
-                    new TestDuration(testResult.TestCase.FullyQualifiedName, GetDuration(testResult));
-            }
-
-            container.TestDurations.Clear();
-            container.TestDurations.AddRange(durations.Values);
-
-            SaveTestDurations(container, durationsFile);
+            return container;
         }
 
         private GtaTestDurations LoadTestDurations(string durationsFile)
@@ -0,0 +1,47 @@
+﻿using System.Collections.Generic;
+using System.Linq;
+using GoogleTestAdapter.Model;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    /// <summary>
+    /// Orders tests such that failures are found as early as possible and long tests do not start last. Tests
+    /// are cut into batches, each of which contains tests of one executable only: the tests of an executable which
+    /// have failed when they were run last form a batch of their own. Batches of recently failed tests are run
+    /// first, the remaining batches longest-processing-time-first across all executables.
+    /// </summary>
+    public class TestPriorityPlanner
+    {
+        private readonly IDictionary<TestCase, int> _durations;
+        private readonly ISet<TestCase> _recentlyFailedTestCases;
+
+        public TestPriorityPlanner(IDictionary<TestCase, int> durations, IEnumerable<TestCase> recentlyFailedTestCases)
+        {
+            _durations = durations ?? new Dictionary<TestCase, int>();
+            _recentlyFailedTestCases = new HashSet<TestCase>(recentlyFailedTestCases ?? Enumerable.Empty<TestCase>());
+        }
+
+        public List<List<TestCase>> GetBatches(IEnumerable<TestCase> testCases)
+        {
+            TestCase[] testCasesAsArray = testCases as TestCase[] ?? testCases.ToArray();
+            IDictionary<TestCase, int> weights = new TestDurationEstimator(_durations).GetWeights(testCasesAsArray);
+
+            // within a batch, the order only matters if the batch needs to be split into several command lines
+            return testCasesAsArray
+                .GroupBy(tc => new { tc.Source, HasFailed = _recentlyFailedTestCases.Contains(tc) })
+                .Select(g => new
+                {
+                    g.Key.HasFailed,
+                    Weight = g.Sum(tc => (long)weights[tc]),
+                    TestCases = g.OrderByDescending(tc => weights[tc]).ThenBy(tc => tc.FullyQualifiedName).ToList()
+                })
+                .OrderByDescending(b => b.HasFailed)
+                .ThenByDescending(b => b.Weight)
+                .ThenBy(b => b.TestCases[0].Source)
+                .Select(b => b.TestCases)
+                .ToList();
+        }
+
+    }
+
+}
@@ -0,0 +1,36 @@
+﻿using System.Collections.Generic;
+using GoogleTestAdapter.Model;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    public class TestShard
+    {
+        public const string TotalShardsEnvVar = "GTEST_TOTAL_SHARDS";
+        public const string ShardIndexEnvVar = "GTEST_SHARD_INDEX";
+
+        public ShardedExecutable ShardedExecutable { get; }
+        public int ShardIndex { get; }
+
+        public TestShard(ShardedExecutable shardedExecutable, int shardIndex)
+        {
+            ShardedExecutable = shardedExecutable;
+            ShardIndex = shardIndex;
+        }
+
+        public string Executable => ShardedExecutable.Executable;
+        public IList<TestCase> TestCases => ShardedExecutable.TestCases;
+
+        public void AddEnvironmentVariables(IDictionary<string, string> environmentVariables)
+        {
+            environmentVariables[TotalShardsEnvVar] = ShardedExecutable.NrOfShards.ToString();
+            environmentVariables[ShardIndexEnvVar] = ShardIndex.ToString();
+        }
+
+        public override string ToString()
+        {
+            return $"{Executable} (shard {ShardIndex + 1} of {ShardedExecutable.NrOfShards})";
+        }
+
+    }
+
+}
@@ -0,0 +1,73 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using GoogleTestAdapter.Helpers;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.Settings;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    /// <summary>
+    /// Decides which executables are run by means of Google Test's native sharding: these are the executables
+    /// of which at least NativeShardingThreshold percent of the tests are to be run. Each such executable is
+    /// split into one shard per thread; all other tests remain to be distributed by the splitters. Executables
+    /// containing tests with resource constraints (see ResourceLockManager) are not sharded.
+    /// </summary>
+    public class TestShardPlanner
+    {
+        private readonly SettingsWrapper _settings;
+
+        public TestShardPlanner(IEnumerable<TestCase> testCasesToRun, SettingsWrapper settings)
+        {
+            _settings = settings;
+            Plan(testCasesToRun);
+        }
+
+        public IList<ShardedExecutable> ShardedExecutables { get; } = new List<ShardedExecutable>();
+
+        public IList<TestCase> RemainingTestCases { get; } = new List<TestCase>();
+
+        private void Plan(IEnumerable<TestCase> testCasesToRun)
+        {
+            foreach (KeyValuePair<string, List<TestCase>> executableAndTestCases in testCasesToRun.GroupByExecutable())
+            {
+                List<TestCase> testCases = executableAndTestCases.Value;
+                int nrOfShards = ComputeNrOfShards(testCases);
+                if (nrOfShards > 1)
+                {
+                    ShardedExecutables.Add(new ShardedExecutable(
+                        executableAndTestCases.Key, testCases.Where(tc => !tc.IsExitCodeTestCase), nrOfShards));
+                }
+                else
+                {
+                    foreach (TestCase testCase in testCases)
+                    {
+                        RemainingTestCases.Add(testCase);
+                    }
+                }
+            }
+        }
+
+        private int ComputeNrOfShards(List<TestCase> testCases)
+        {
+            int threshold = _settings.NativeShardingThreshold;
+            if (threshold <= 0 || testCases.Any(ResourceLockManager.IsConstrained))
+                return 0;
+
+            List<TestCase> testCasesWithoutExitCodeTest = testCases.Where(tc => !tc.IsExitCodeTestCase).ToList();
+            TestCaseMetaDataProperty metaData = testCasesWithoutExitCodeTest.FirstOrDefault()?.Properties
+                .OfType<TestCaseMetaDataProperty>()
+                .SingleOrDefault();
+            if (metaData == null || metaData.NrOfTestCasesInExecutable == 0)
+                return 0;
+
+            int nrOfTestCases = testCasesWithoutExitCodeTest.Count;
+            if (100L * nrOfTestCases < (long)threshold * metaData.NrOfTestCasesInExecutable)
+                return 0;
+
+            return Math.Min(_settings.MaxNrOfThreads, nrOfTestCases);
+        }
+
+    }
+
+}
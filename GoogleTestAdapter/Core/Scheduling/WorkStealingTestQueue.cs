@@ -0,0 +1,259 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading;
+using GoogleTestAdapter.Model;
+
+namespace GoogleTestAdapter.Scheduling
+{
+    /// <summary>
+    /// Distributes tests to a fixed number of threads. Each thread owns a deque of work items, each of
+    /// which contains tests of one executable only. A thread takes chunks of tests from the front of its own deque;
+    /// if that deque is empty, it steals from the back of the deque which has the most work left. Chunk sizes
+    /// shrink with the overall amount of remaining work (guided scheduling), such that the end of a test run is
+    /// balanced at the level of single tests. Tests can also be added while the queue is already being processed
+    /// (e.g. while further executables are still being discovered); threads then wait for more work until adding has completed.
+    /// </summary>
+    public class WorkStealingTestQueue
+    {
+        private class WorkItem
+        {
+            internal readonly List<TestCase> TestCases = new List<TestCase>();
+        }
+
+        private readonly object _lock = new object();
+        private readonly LinkedList<WorkItem>[] _deques;
+        private readonly int[] _remainingWeights;
+        private readonly IDictionary<TestCase, int> _weights = new Dictionary<TestCase, int>();
+        private int _remainingWeight;
+        private bool _addingCompleted;
+        private bool _canceled;
+
+        public WorkStealingTestQueue(IEnumerable<TestCase> testCases, int nrOfThreads, IDictionary<TestCase, int> durations = null)
+            : this(testCases as TestCase[] ?? testCases.ToArray(), nrOfThreads, durations, true)
+        {
+        }
+
+        /// <summary>
+        /// Creates an empty queue to which tests are added with Add() until CompleteAdding() is called.
+        /// </summary>
+        public WorkStealingTestQueue(int nrOfThreads)
+            : this(new TestCase[0], nrOfThreads, null, false)
+        {
+        }
+
+        private WorkStealingTestQueue(TestCase[] testCases, int nrOfThreads, IDictionary<TestCase, int> durations, bool addingCompleted)
+        {
+            if (nrOfThreads < 1)
+                throw new ArgumentOutOfRangeException(nameof(nrOfThreads));
+
+            NrOfThreads = addingCompleted ? Math.Max(1, Math.Min(nrOfThreads, testCases.Length)) : nrOfThreads;
+            _deques = new LinkedList<WorkItem>[NrOfThreads];
+            _remainingWeights = new int[NrOfThreads];
+            for (int i = 0; i < NrOfThreads; i++)
+            {
+                _deques[i] = new LinkedList<WorkItem>();
+            }
+            _addingCompleted = addingCompleted;
+
+            Seed(testCases, durations ?? new Dictionary<TestCase, int>());
+        }
+
+        public int NrOfThreads { get; }
+
+        /// <summary>
+        /// Returns the next chunk of tests to be executed by the given thread. All tests of a chunk belong
+        /// to the same executable. Blocks while there is no work left but adding has not completed yet.
+        /// Returns false if there is no work left or the queue has been canceled.
+        /// </summary>
+        public bool TryTake(int threadId, out List<TestCase> chunk)
+        {
+            lock (_lock)
+            {
+                chunk = null;
+                while (!_canceled && _remainingWeight == 0 && !_addingCompleted)
+                {
+                    Monitor.Wait(_lock);
+                }
+                if (_canceled || _remainingWeight == 0)
+                    return false;
+
+                int targetWeight = Math.Max(1, (_remainingWeight + 2 * NrOfThreads - 1) / (2 * NrOfThreads));
+
+                LinkedList<WorkItem> ownDeque = _deques[threadId];
+                if (ownDeque.Count > 0)
+                {
+                    chunk = TakeFromFront(ownDeque, threadId, targetWeight);
+                    return true;
+                }
+
+                int victim = GetIndexOfDequeWithMostWork();
+                chunk = TakeFromBack(_deques[victim], victim, targetWeight);
+                return true;
+            }
+        }
+
+        /// <summary>
+        /// Adds further tests to the queue; they are distributed to the threads with the least work left.
+        /// </summary>
+        public void Add(IEnumerable<TestCase> testCases, IDictionary<TestCase, int> durations = null)
+        {
+            lock (_lock)
+            {
+                if (_addingCompleted)
+                    throw new InvalidOperationException("Adding has already been completed");
+
+                Seed(testCases as TestCase[] ?? testCases.ToArray(), durations ?? new Dictionary<TestCase, int>());
+                Monitor.PulseAll(_lock);
+            }
+        }
+
+        public void CompleteAdding()
+        {
+            lock (_lock)
+            {
+                _addingCompleted = true;
+                Monitor.PulseAll(_lock);
+            }
+        }
+
+        public void Cancel()
+        {
+            lock (_lock)
+            {
+                _canceled = true;
+                Monitor.PulseAll(_lock);
+            }
+        }
+
+        private List<TestCase> TakeFromFront(LinkedList<WorkItem> deque, int dequeIndex, int targetWeight)
+        {
+            WorkItem item = deque.First.Value;
+            int count = CountFittingTestCases(item.TestCases, targetWeight, fromFront: true);
+
+            List<TestCase> chunk;
+            if (count == item.TestCases.Count)
+            {
+                deque.RemoveFirst();
+                chunk = item.TestCases;
+            }
+            else
+            {
+                chunk = item.TestCases.GetRange(0, count);
+                item.TestCases.RemoveRange(0, count);
+            }
+
+            UpdateWeights(chunk, dequeIndex);
+            return chunk;
+        }
+
+        private List<TestCase> TakeFromBack(LinkedList<WorkItem> deque, int dequeIndex, int targetWeight)
+        {
+            WorkItem item = deque.Last.Value;
+            int count = CountFittingTestCases(item.TestCases, targetWeight, fromFront: false);
+
+            List<TestCase> chunk;
+            if (count == item.TestCases.Count)
+            {
+                deque.RemoveLast();
+                chunk = item.TestCases;
+            }
+            else
+            {
+                int start = item.TestCases.Count - count;
+                chunk = item.TestCases.GetRange(start, count);
+                item.TestCases.RemoveRange(start, count);
+            }
+
+            UpdateWeights(chunk, dequeIndex);
+            return chunk;
+        }
+
+        private void UpdateWeights(List<TestCase> chunk, int dequeIndex)
+        {
+            int weight = chunk.Sum(tc => _weights[tc]);
+            _remainingWeights[dequeIndex] -= weight;
+            _remainingWeight -= weight;
+        }
+
+        /// <summary>
+        /// At least one test is taken, further tests as long as the target weight is not exceeded
+        /// </summary>
+        private int CountFittingTestCases(List<TestCase> testCases, int targetWeight, bool fromFront)
+        {
+            int count = 0;
+            int weight = 0;
+            while (count < testCases.Count)
+            {
+                TestCase testCase = testCases[fromFront ? count : testCases.Count - 1 - count];
+                if (count > 0 && weight + _weights[testCase] > targetWeight)
+                    break;
+                weight += _weights[testCase];
+                count++;
+            }
+            return count;
+        }
+
+        private int GetIndexOfDequeWithMostWork()
+        {
+            int index = 0;
+            for (int i = 1; i < _remainingWeights.Length; i++)
+            {
+                if (_remainingWeights[i] > _remainingWeights[index])
+                    index = i;
+            }
+            return index;
+        }
+
+        /// <summary>
+        /// Tests are sorted by executable and name (thus keeping suites together) and then cut into
+        /// contiguous ranges of roughly equal weight, one per thread (starting with the threads with the least work left)
+        /// </summary>
+        private void Seed(TestCase[] testCases, IDictionary<TestCase, int> durations)
+        {
+            foreach (KeyValuePair<TestCase, int> weight in new TestDurationEstimator(durations).GetWeights(testCases))
+            {
+                _weights[weight.Key] = weight.Value;
+            }
+            int[] threads = Enumerable.Range(0, NrOfThreads)
+                .OrderBy(i => _remainingWeights[i])
+                .ToArray();
+
+            List<TestCase> sortedTestCases = testCases
+                .OrderBy(tc => tc.Source)
+                .ThenBy(tc => tc.FullyQualifiedName)
+                .ToList();
+
+            int overallWeight = sortedTestCases.Sum(tc => _weights[tc]);
+            int currentThread = 0;
+            int accumulatedWeight = 0;
+            foreach (TestCase testCase in sortedTestCases)
+            {
+                int weight = _weights[testCase];
+                long targetWeight = (long)overallWeight * (currentThread + 1) / NrOfThreads;
+                if (accumulatedWeight > 0 && accumulatedWeight + weight / 2.0 > targetWeight && currentThread < NrOfThreads - 1)
+                    currentThread++;
+
+                AddToDeque(threads[currentThread], testCase, weight);
+                accumulatedWeight += weight;
+            }
+        }
+
+        private void AddToDeque(int threadId, TestCase testCase, int weight)
+        {
+            LinkedList<WorkItem> deque = _deques[threadId];
+            WorkItem item = deque.Last?.Value;
+            if (item == null || item.TestCases[0].Source != testCase.Source)
+            {
+                item = new WorkItem();
+                deque.AddLast(item);
+            }
+
+            item.TestCases.Add(testCase);
+            _remainingWeights[threadId] += weight;
+            _remainingWeight += weight;
+        }
+
+    }
+
+}
@@ -55,6 +55,25 @@ namespace GoogleTestAdapter.Settings
         bool? SkipOriginCheck { get; set; }
         string ExitCodeTestCase { get; set; }
         MissingTestsReportMode? MissingTestsReportMode { get; set; }
+        bool? WorkStealingTestExecution { get; set; }
+        int? NativeShardingThreshold { get; set; }
+        bool? SynthesizeTestFilters { get; set; }
+        bool? UseTestServer { get; set; }
+        int? CrashBudget { get; set; }
+        bool? AdaptiveConcurrency { get; set; }
+        int? TestTimeoutInSeconds { get; set; }
+        int? ProcessTimeoutInSeconds { get; set; }
+        bool? FailFast { get; set; }
+        bool? PrioritizeFailedAndLongTests { get; set; }
+        bool? ExecutableAffinitySplitting { get; set; }
+        string RemoteAgents { get; set; }
+        string RemoteOutputDirectory { get; set; }
+        string ResultCacheDirectory { get; set; }
+        string ChangedFilesList { get; set; }
+        bool? AsyncResultReporting { get; set; }
+        bool? PreSpawnTestProcesses { get; set; }
+        bool? PinTestThreadsToCpus { get; set; }
+        int? MemoryBudgetInMb { get; set; }
 
         bool? UseNewTestExecutionFramework { get; set; }
         DebuggerKind? DebuggerKind { get; set; }
@@ -104,6 +123,25 @@ namespace GoogleTestAdapter.Settings
             self.SkipOriginCheck = self.SkipOriginCheck ?? other.SkipOriginCheck;
             self.ExitCodeTestCase = self.ExitCodeTestCase ?? other.ExitCodeTestCase;
             self.MissingTestsReportMode = self.MissingTestsReportMode ?? other.MissingTestsReportMode;
+            self.WorkStealingTestExecution = self.WorkStealingTestExecution ?? other.WorkStealingTestExecution;
+            self.NativeShardingThreshold = self.NativeShardingThreshold ?? other.NativeShardingThreshold;
+            self.SynthesizeTestFilters = self.SynthesizeTestFilters ?? other.SynthesizeTestFilters;
+            self.UseTestServer = self.UseTestServer ?? other.UseTestServer;
+            self.CrashBudget = self.CrashBudget ?? other.CrashBudget;
+            self.AdaptiveConcurrency = self.AdaptiveConcurrency ?? other.AdaptiveConcurrency;
+            self.TestTimeoutInSeconds = self.TestTimeoutInSeconds ?? other.TestTimeoutInSeconds;
+            self.ProcessTimeoutInSeconds = self.ProcessTimeoutInSeconds ?? other.ProcessTimeoutInSeconds;
+            self.FailFast = self.FailFast ?? other.FailFast;
+            self.PrioritizeFailedAndLongTests = self.PrioritizeFailedAndLongTests ?? other.PrioritizeFailedAndLongTests;
+            self.ExecutableAffinitySplitting = self.ExecutableAffinitySplitting ?? other.ExecutableAffinitySplitting;
+            self.RemoteAgents = self.RemoteAgents ?? other.RemoteAgents;
+            self.RemoteOutputDirectory = self.RemoteOutputDirectory ?? other.RemoteOutputDirectory;
+            self.ResultCacheDirectory = self.ResultCacheDirectory ?? other.ResultCacheDirectory;
+            self.ChangedFilesList = self.ChangedFilesList ?? other.ChangedFilesList;
+            self.AsyncResultReporting = self.AsyncResultReporting ?? other.AsyncResultReporting;
+            self.PreSpawnTestProcesses = self.PreSpawnTestProcesses ?? other.PreSpawnTestProcesses;
+            self.PinTestThreadsToCpus = self.PinTestThreadsToCpus ?? other.PinTestThreadsToCpus;
+            self.MemoryBudgetInMb = self.MemoryBudgetInMb ?? other.MemoryBudgetInMb;
 
             self.UseNewTestExecutionFramework = self.UseNewTestExecutionFramework ?? other.UseNewTestExecutionFramework;
             self.DebuggerKind = self.DebuggerKind ?? other.DebuggerKind;
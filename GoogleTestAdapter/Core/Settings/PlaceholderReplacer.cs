@@ -3,6 +3,7 @@ using System.IO;
 using System.Linq;
 using System.Text.RegularExpressions;
 using GoogleTestAdapter.Common;
+using GoogleTestAdapter.Scheduling;
 
 namespace GoogleTestAdapter.Settings
 {
@@ -32,6 +33,15 @@ namespace GoogleTestAdapter.Settings
         public const string ThreadIdPlaceholder = "$(ThreadId)";
         private const string DescriptionOfThreadIdPlaceholder = ThreadIdPlaceholder + " - id of thread executing the current tests";
 
+        public const string CpuSetPlaceholder = "$(CpuSet)";
+        private const string DescriptionOfCpuSetPlaceholder = CpuSetPlaceholder + " - logical processors the current tests are pinned to, e.g. 0-3,8 (empty if not pinned)";
+
+        public const string CpuCountPlaceholder = "$(CpuCount)";
+        private const string DescriptionOfCpuCountPlaceholder = CpuCountPlaceholder + " - number of logical processors available to the current tests";
+
+        public const string NumaNodesPlaceholder = "$(NumaNodes)";
+        private const string DescriptionOfNumaNodesPlaceholder = NumaNodesPlaceholder + " - NUMA nodes of the processors the current tests are pinned to (empty if not pinned)";
+
         private const string DescriptionOfEnvVarPlaceholders = "Environment variables are also possible, e.g. %PATH%";
 
 
@@ -84,6 +94,9 @@ namespace GoogleTestAdapter.Settings
                                                      DescriptionOfExecutablePlaceHolder + "\n" + 
                                                      DescriptionOfTestDirPlaceholder + TestExecutionOnly + "\n" + 
                                                      DescriptionOfThreadIdPlaceholder + TestExecutionOnly + "\n" + 
+                                                     DescriptionOfCpuSetPlaceholder + TestExecutionOnly + "\n" + 
+                                                     DescriptionOfCpuCountPlaceholder + TestExecutionOnly + "\n" + 
+                                                     DescriptionOfNumaNodesPlaceholder + TestExecutionOnly + "\n" + 
                                                      DescriptionOfEnvVarPlaceholders;
 
         public string ReplaceWorkingDirPlaceholdersForDiscovery(string workingDir, string executable)
@@ -101,9 +114,9 @@ namespace GoogleTestAdapter.Settings
         }
 
         public string ReplaceWorkingDirPlaceholdersForExecution(string workingDir, string executable,
-            string testDirectory, int threadId)
+            string testDirectory, int threadId, CpuSet cpuSet = null)
         {
-            workingDir = ReplaceTestDirAndThreadIdPlaceholders(workingDir, testDirectory, threadId);
+            workingDir = ReplaceTestDirAndThreadIdPlaceholders(workingDir, testDirectory, threadId, cpuSet);
             workingDir = ReplaceExecutablePlaceholders(workingDir, executable);
             workingDir = ReplacePlatformAndConfigurationPlaceholders(workingDir, executable);
             workingDir = ReplaceSolutionDirPlaceholder(workingDir, executable);
@@ -146,12 +159,15 @@ namespace GoogleTestAdapter.Settings
                                                         DescriptionOfExecutablePlaceHolder + "\n" + 
                                                         DescriptionOfTestDirPlaceholder + TestExecutionOnly + "\n" + 
                                                         DescriptionOfThreadIdPlaceholder + TestExecutionOnly + "\n" + 
+                                                        DescriptionOfCpuSetPlaceholder + TestExecutionOnly + "\n" + 
+                                                        DescriptionOfCpuCountPlaceholder + TestExecutionOnly + "\n" + 
+                                                        DescriptionOfNumaNodesPlaceholder + TestExecutionOnly + "\n" + 
                                                         DescriptionOfEnvVarPlaceholders;
 
-        public string ReplaceEnvironmentVariablesPlaceholdersForExecution(string environmentVariables, string executable, string testDirectory, int threadId)
+        public string ReplaceEnvironmentVariablesPlaceholdersForExecution(string environmentVariables, string executable, string testDirectory, int threadId, CpuSet cpuSet = null)
         {
             environmentVariables =
-                ReplaceTestDirAndThreadIdPlaceholders(environmentVariables, testDirectory, threadId);
+                ReplaceTestDirAndThreadIdPlaceholders(environmentVariables, testDirectory, threadId, cpuSet);
             environmentVariables = ReplaceExecutablePlaceholders(environmentVariables, executable);
             environmentVariables = ReplacePlatformAndConfigurationPlaceholders(environmentVariables, executable);
             environmentVariables = ReplaceSolutionDirPlaceholder(environmentVariables, executable);
@@ -186,6 +202,9 @@ namespace GoogleTestAdapter.Settings
                                                                        DescriptionOfExecutablePlaceHolder + "\n" + 
                                                                        DescriptionOfTestDirPlaceholder + TestExecutionOnly + "\n" + 
                                                                        DescriptionOfThreadIdPlaceholder + TestExecutionOnly + "\n" + 
+                                                                       DescriptionOfCpuSetPlaceholder + TestExecutionOnly + "\n" + 
+                                                                       DescriptionOfCpuCountPlaceholder + TestExecutionOnly + "\n" + 
+                                                                       DescriptionOfNumaNodesPlaceholder + TestExecutionOnly + "\n" + 
                                                                        DescriptionOfEnvVarPlaceholders;
 
         public string ReplaceAdditionalTestExecutionParamPlaceholdersForDiscovery(string additionalTestExecutionParam, string executable)
@@ -202,10 +221,10 @@ namespace GoogleTestAdapter.Settings
             return additionalTestExecutionParam;
         }
 
-        public string ReplaceAdditionalTestExecutionParamPlaceholdersForExecution(string additionalTestExecutionParam, string executable, string testDirectory, int threadId)
+        public string ReplaceAdditionalTestExecutionParamPlaceholdersForExecution(string additionalTestExecutionParam, string executable, string testDirectory, int threadId, CpuSet cpuSet = null)
         {
             additionalTestExecutionParam =
-                ReplaceTestDirAndThreadIdPlaceholders(additionalTestExecutionParam, testDirectory, threadId);
+                ReplaceTestDirAndThreadIdPlaceholders(additionalTestExecutionParam, testDirectory, threadId, cpuSet);
             additionalTestExecutionParam = ReplaceExecutablePlaceholders(additionalTestExecutionParam, executable);
             additionalTestExecutionParam = ReplacePlatformAndConfigurationPlaceholders(additionalTestExecutionParam, executable);
             additionalTestExecutionParam = ReplaceSolutionDirPlaceholder(additionalTestExecutionParam, executable);
@@ -224,26 +243,29 @@ namespace GoogleTestAdapter.Settings
                                                   DescriptionOfConfigurationNamePlaceholder + "\n" + 
                                                   DescriptionOfTestDirPlaceholder + "\n" + 
                                                   DescriptionOfThreadIdPlaceholder + "\n" + 
+                                                  DescriptionOfCpuSetPlaceholder + "\n" + 
+                                                  DescriptionOfCpuCountPlaceholder + "\n" + 
+                                                  DescriptionOfNumaNodesPlaceholder + "\n" + 
                                                   DescriptionOfEnvVarPlaceholders;
 
 
-        public string ReplaceSetupBatchPlaceholders(string batch, string testDirectory, int threadId)
+        public string ReplaceSetupBatchPlaceholders(string batch, string testDirectory, int threadId, CpuSet cpuSet = null)
         {
-            batch = ReplaceBatchPlaceholders(batch, testDirectory, threadId);
+            batch = ReplaceBatchPlaceholders(batch, testDirectory, threadId, cpuSet);
             CheckForRemainingPlaceholders(batch, SettingsWrapper.OptionBatchForTestSetup);
             return batch;
         }
 
-        public string ReplaceTeardownBatchPlaceholders(string batch, string testDirectory, int threadId)
+        public string ReplaceTeardownBatchPlaceholders(string batch, string testDirectory, int threadId, CpuSet cpuSet = null)
         {
-            batch = ReplaceBatchPlaceholders(batch, testDirectory, threadId);
+            batch = ReplaceBatchPlaceholders(batch, testDirectory, threadId, cpuSet);
             CheckForRemainingPlaceholders(batch, SettingsWrapper.OptionBatchForTestTeardown);
             return batch;
         }
 
-        private string ReplaceBatchPlaceholders(string batch, string testDirectory, int threadId)
+        private string ReplaceBatchPlaceholders(string batch, string testDirectory, int threadId, CpuSet cpuSet)
         {
-            batch = ReplaceTestDirAndThreadIdPlaceholders(batch, testDirectory, threadId);
+            batch = ReplaceTestDirAndThreadIdPlaceholders(batch, testDirectory, threadId, cpuSet);
             batch = ReplacePlatformAndConfigurationPlaceholders(batch);
             batch = ReplaceSolutionDirPlaceholder(batch);
             batch = ReplaceEnvironmentVariables(batch);
@@ -281,14 +303,17 @@ namespace GoogleTestAdapter.Settings
                     .Replace(ExecutablePlaceholder, executable);
         }
 
-        private string ReplaceTestDirAndThreadIdPlaceholders(string theString, string testDirectory, int threadId)
+        private string ReplaceTestDirAndThreadIdPlaceholders(string theString, string testDirectory, int threadId, CpuSet cpuSet)
         {
-            return ReplaceTestDirAndThreadIdPlaceholders(theString, testDirectory, threadId.ToString());
+            return ReplaceTestDirAndThreadIdPlaceholders(theString, testDirectory, threadId.ToString(),
+                cpuSet?.ToString() ?? "",
+                (cpuSet?.Processors.Count ?? Environment.ProcessorCount).ToString(),
+                cpuSet != null ? CpuSet.FormatNumbers(cpuSet.NumaNodes) : "");
         }
 
         private string RemoveTestDirAndThreadIdPlaceholders(string theString)
         {
-            return ReplaceTestDirAndThreadIdPlaceholders(theString, "", "");
+            return ReplaceTestDirAndThreadIdPlaceholders(theString, "", "", "", "", "");
         }
 
         private string ReplaceEnvironmentVariables(string theString)
@@ -298,13 +323,17 @@ namespace GoogleTestAdapter.Settings
                 : Environment.ExpandEnvironmentVariables(theString);
         }
 
-        private string ReplaceTestDirAndThreadIdPlaceholders(string theString, string testDirectory, string threadId)
+        private string ReplaceTestDirAndThreadIdPlaceholders(string theString, string testDirectory, string threadId,
+            string cpuSet, string cpuCount, string numaNodes)
         {
             return string.IsNullOrWhiteSpace(theString)
                 ? ""
                 : theString
                     .Replace(TestDirPlaceholder, testDirectory)
-                    .Replace(ThreadIdPlaceholder, threadId);
+                    .Replace(ThreadIdPlaceholder, threadId)
+                    .Replace(CpuSetPlaceholder, cpuSet)
+                    .Replace(CpuCountPlaceholder, cpuCount)
+                    .Replace(NumaNodesPlaceholder, numaNodes);
         }
 
         private string ReplaceHelperFileSettings(string theString, string executable)
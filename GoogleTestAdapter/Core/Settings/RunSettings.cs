@@ -121,6 +121,63 @@ namespace GoogleTestAdapter.Settings
         public MissingTestsReportMode? MissingTestsReportMode { get; set; }
         public bool ShouldSerializeMissingTestsReportMode() { return MissingTestsReportMode != null; }
 
+        public virtual bool? WorkStealingTestExecution { get; set; }
+        public bool ShouldSerializeWorkStealingTestExecution() { return WorkStealingTestExecution != null; }
+
+        public virtual int? NativeShardingThreshold { get; set; }
+        public bool ShouldSerializeNativeShardingThreshold() { return NativeShardingThreshold != null; }
+
+        public virtual bool? SynthesizeTestFilters { get; set; }
+        public bool ShouldSerializeSynthesizeTestFilters() { return SynthesizeTestFilters != null; }
+
+        public virtual bool? UseTestServer { get; set; }
+        public bool ShouldSerializeUseTestServer() { return UseTestServer != null; }
+
+        public virtual int? CrashBudget { get; set; }
+        public bool ShouldSerializeCrashBudget() { return CrashBudget != null; }
+
+        public virtual bool? AdaptiveConcurrency { get; set; }
+        public bool ShouldSerializeAdaptiveConcurrency() { return AdaptiveConcurrency != null; }
+
+        public virtual int? TestTimeoutInSeconds { get; set; }
+        public bool ShouldSerializeTestTimeoutInSeconds() { return TestTimeoutInSeconds != null; }
+
+        public virtual int? ProcessTimeoutInSeconds { get; set; }
+        public bool ShouldSerializeProcessTimeoutInSeconds() { return ProcessTimeoutInSeconds != null; }
+
+        public virtual bool? FailFast { get; set; }
+        public bool ShouldSerializeFailFast() { return FailFast != null; }
+
+        public virtual bool? PrioritizeFailedAndLongTests { get; set; }
+        public bool ShouldSerializePrioritizeFailedAndLongTests() { return PrioritizeFailedAndLongTests != null; }
+
+        public virtual bool? ExecutableAffinitySplitting { get; set; }
+        public bool ShouldSerializeExecutableAffinitySplitting() { return ExecutableAffinitySplitting != null; }
+
+        public virtual string RemoteAgents { get; set; }
+        public bool ShouldSerializeRemoteAgents() { return RemoteAgents != null; }
+
+        public virtual string RemoteOutputDirectory { get; set; }
+        public bool ShouldSerializeRemoteOutputDirectory() { return RemoteOutputDirectory != null; }
+
+        public virtual string ResultCacheDirectory { get; set; }
+        public bool ShouldSerializeResultCacheDirectory() { return ResultCacheDirectory != null; }
+
+        public virtual string ChangedFilesList { get; set; }
+        public bool ShouldSerializeChangedFilesList() { return ChangedFilesList != null; }
+
+        public virtual bool? AsyncResultReporting { get; set; }
+        public bool ShouldSerializeAsyncResultReporting() { return AsyncResultReporting != null; }
+
+        public virtual bool? PreSpawnTestProcesses { get; set; }
+        public bool ShouldSerializePreSpawnTestProcesses() { return PreSpawnTestProcesses != null; }
+
+        public virtual bool? PinTestThreadsToCpus { get; set; }
+        public bool ShouldSerializePinTestThreadsToCpus() { return PinTestThreadsToCpus != null; }
+
+        public virtual int? MemoryBudgetInMb { get; set; }
+        public bool ShouldSerializeMemoryBudgetInMb() { return MemoryBudgetInMb != null; }
+
 
         public virtual bool? UseNewTestExecutionFramework { get; set; }
         public bool ShouldSerializeUseNewTestExecutionFramework() { return UseNewTestExecutionFramework != null; }
@@ -7,6 +7,7 @@ using System.Threading;
 using GoogleTestAdapter.Common;
 using GoogleTestAdapter.Helpers;
 using GoogleTestAdapter.ProcessExecution;
+using GoogleTestAdapter.Scheduling;
 
 namespace GoogleTestAdapter.Settings
 {
@@ -351,9 +352,9 @@ namespace GoogleTestAdapter.Settings
             ? OptionWorkingDirDefaultValue 
             : _currentSettings.WorkingDir;
 
-        public string GetWorkingDirForExecution(string executable, string testDirectory, int threadId)
+        public string GetWorkingDirForExecution(string executable, string testDirectory, int threadId, CpuSet cpuSet = null)
         {
-            return _placeholderReplacer.ReplaceWorkingDirPlaceholdersForExecution(WorkingDir, executable, testDirectory, threadId);
+            return _placeholderReplacer.ReplaceWorkingDirPlaceholdersForExecution(WorkingDir, executable, testDirectory, threadId, cpuSet);
         }
 
         public string GetWorkingDirForDiscovery(string executable)
@@ -386,9 +387,9 @@ namespace GoogleTestAdapter.Settings
             => EnvironmentVariablesParser.ParseEnvironmentVariablesString(
                 _placeholderReplacer.ReplaceEnvironmentVariablesPlaceholdersForDiscovery(EnvironmentVariables, executable));
 
-        public IDictionary<string, string> GetEnvironmentVariablesForExecution(string executable, string testDirectory, int threadId) 
+        public IDictionary<string, string> GetEnvironmentVariablesForExecution(string executable, string testDirectory, int threadId, CpuSet cpuSet = null) 
             => EnvironmentVariablesParser.ParseEnvironmentVariablesString(
-                _placeholderReplacer.ReplaceEnvironmentVariablesPlaceholdersForExecution(EnvironmentVariables, executable, testDirectory, threadId));
+                _placeholderReplacer.ReplaceEnvironmentVariablesPlaceholdersForExecution(EnvironmentVariables, executable, testDirectory, threadId, cpuSet));
         
 
         public const string OptionAdditionalTestExecutionParams = "Additional test execution parameters";
@@ -398,9 +399,9 @@ namespace GoogleTestAdapter.Settings
 
         public virtual string AdditionalTestExecutionParam => _currentSettings.AdditionalTestExecutionParam ?? OptionAdditionalTestExecutionParamsDefaultValue;
 
-        public string GetUserParametersForExecution(string executable, string testDirectory, int threadId)
+        public string GetUserParametersForExecution(string executable, string testDirectory, int threadId, CpuSet cpuSet = null)
             => _placeholderReplacer.ReplaceAdditionalTestExecutionParamPlaceholdersForExecution(
-                AdditionalTestExecutionParam, executable, testDirectory, threadId);
+                AdditionalTestExecutionParam, executable, testDirectory, threadId, cpuSet);
 
         public string GetUserParametersForDiscovery(string executable)
             => _placeholderReplacer.ReplaceAdditionalTestExecutionParamPlaceholdersForDiscovery(
@@ -415,8 +416,8 @@ namespace GoogleTestAdapter.Settings
 
         public virtual string BatchForTestSetup => _currentSettings.BatchForTestSetup ?? OptionBatchForTestSetupDefaultValue;
 
-        public string GetBatchForTestSetup(string testDirectory, int threadId)
-            => _placeholderReplacer.ReplaceSetupBatchPlaceholders(BatchForTestSetup, testDirectory, threadId);
+        public string GetBatchForTestSetup(string testDirectory, int threadId, CpuSet cpuSet = null)
+            => _placeholderReplacer.ReplaceSetupBatchPlaceholders(BatchForTestSetup, testDirectory, threadId, cpuSet);
 
 
         public const string OptionBatchForTestTeardown = "Test teardown batch file";
@@ -426,9 +427,9 @@ namespace GoogleTestAdapter.Settings
 
         public virtual string BatchForTestTeardown => _currentSettings.BatchForTestTeardown ?? OptionBatchForTestTeardownDefaultValue;
 
-        public string GetBatchForTestTeardown(string testDirectory, int threadId)
+        public string GetBatchForTestTeardown(string testDirectory, int threadId, CpuSet cpuSet = null)
             => _placeholderReplacer.ReplaceTeardownBatchPlaceholders(BatchForTestTeardown, testDirectory,
-                threadId);
+                threadId, cpuSet);
 
 
         public const string OptionKillProcessesOnCancel = "Kill processes on cancel";
@@ -482,6 +483,186 @@ namespace GoogleTestAdapter.Settings
         public virtual MissingTestsReportMode MissingTestsReportMode =>
             _currentSettings.MissingTestsReportMode ?? OptionMissingTestsReportModeDefaultValue;
 
+
+        public const string OptionWorkStealingTestExecution = "Work stealing";
+        public const string OptionWorkStealingTestExecutionDescription =
+            "If true, tests are not split into fixed lists per thread before executing them in parallel. Instead, each thread takes chunks of tests (belonging to one executable) from its own queue and steals work from other threads once its queue is empty. " +
+            "Chunks get smaller towards the end of the test run, which keeps threads busy even if test durations are not known in advance. " +
+            "If tests are run by executable (e.g. from the command line), the tests of an executable are executed as soon as it has been discovered, while other executables are still being discovered.";
+        public const bool OptionWorkStealingTestExecutionDefaultValue = false;
+
+        public virtual bool WorkStealingTestExecution => _currentSettings.WorkStealingTestExecution ?? OptionWorkStealingTestExecutionDefaultValue;
+
+
+        public const string OptionNativeShardingThreshold = "Native sharding threshold (%)";
+        public const string OptionNativeShardingThresholdDescription =
+            "If greater than 0, executables of which at least the given percentage of tests is to be run are executed by means of Google Test's native sharding: each thread runs the complete executable with environment variables GTEST_TOTAL_SHARDS and GTEST_SHARD_INDEX set, and no --gtest_filter is generated. " +
+            "Results of tests which are not selected, but run as part of a shard, are ignored. 0 disables native sharding.";
+        public const int OptionNativeShardingThresholdDefaultValue = 0;
+
+        public virtual int NativeShardingThreshold => _currentSettings.NativeShardingThreshold ?? OptionNativeShardingThresholdDefaultValue;
+
+
+        public const string OptionSynthesizeTestFilters = "Synthesize test filters";
+        public const string OptionSynthesizeTestFiltersDescription =
+            "If true, the list of all tests of an executable is used to compute the shortest --gtest_filter selecting exactly the tests to be run, making use of wildcards (e.g. 'Instance/Suite.*' or 'Suite.Test*') and negative patterns. " +
+            "This results in less test processes if only some tests of large (parameterized) suites are run. Note that running selected tests then requires the according executables to be discovered before test execution.";
+        public const bool OptionSynthesizeTestFiltersDefaultValue = false;
+
+        public virtual bool SynthesizeTestFilters => _currentSettings.SynthesizeTestFilters ?? OptionSynthesizeTestFiltersDefaultValue;
+
+
+        public const string OptionUseTestServer = "Use test server";
+        public const string OptionUseTestServerDescription =
+            "If true, executables which use the test server provided with the adapter (see GTA_TestServer.h) are started once per thread in server mode; all batches of tests of such an executable are then executed by that process. " +
+            "This avoids repeated process startup and static initialization for runs with many small batches. Not used while debugging or if an exit code test is configured. " +
+            "Requires Google Test 1.8 or later; note that static state of the tests is not reset between batches.";
+        public const bool OptionUseTestServerDefaultValue = false;
+
+        public virtual bool UseTestServer => _currentSettings.UseTestServer ?? OptionUseTestServerDefaultValue;
+
+
+        public const string OptionCrashBudget = "Crash budget";
+        public const string OptionCrashBudgetDescription =
+            "If a test crashes its executable, the executable is restarted for the tests of the crashed batch which have not yet been run. " +
+            "This option limits the number of such restarts per executable and thread; 0 disables restarting (tests not run due to a crash are then reported as skipped).";
+        public const int OptionCrashBudgetDefaultValue = 0;
+
+        public virtual int CrashBudget => _currentSettings.CrashBudget ?? OptionCrashBudgetDefaultValue;
+
+
+        public const string OptionAdaptiveConcurrency = "Adaptive concurrency";
+        public const string OptionAdaptiveConcurrencyDescription =
+            "If true, the number of concurrently running test processes is adapted to the machine's load (CPU utilization, run queue length, and available memory), " +
+            "starting with the number of processors and staying between 1 and the maximum number of threads. Decisions are logged in debug mode.";
+        public const bool OptionAdaptiveConcurrencyDefaultValue = false;
+
+        public virtual bool AdaptiveConcurrency => _currentSettings.AdaptiveConcurrency ?? OptionAdaptiveConcurrencyDefaultValue;
+
+
+        public const string OptionTestTimeoutInSeconds = "Test timeout in s";
+        public const string OptionTestTimeoutInSecondsDescription =
+            "If a test does not finish within this number of seconds (measured from its '[ RUN      ]' line), its executable is killed and the test is reported as timed out. " +
+            "The remaining tests of the executable are then run in a new process. 0 disables the timeout.";
+        public const int OptionTestTimeoutInSecondsDefaultValue = 0;
+
+        public virtual int TestTimeoutInSeconds => _currentSettings.TestTimeoutInSeconds ?? OptionTestTimeoutInSecondsDefaultValue;
+
+
+        public const string OptionProcessTimeoutInSeconds = "Test process timeout in s";
+        public const string OptionProcessTimeoutInSecondsDescription =
+            "If a test executable does not finish within this number of seconds, it is killed, and the test currently running is reported as timed out. " +
+            "The remaining tests of the executable are then run in a new process. 0 disables the timeout.";
+        public const int OptionProcessTimeoutInSecondsDefaultValue = 0;
+
+        public virtual int ProcessTimeoutInSeconds => _currentSettings.ProcessTimeoutInSeconds ?? OptionProcessTimeoutInSecondsDefaultValue;
+
+
+        public const string OptionFailFast = "Fail fast";
+        public const string OptionFailFastDescription =
+            "If true, test execution is canceled as soon as the first test has failed: running test executables are killed, no further tests are started, " +
+            "and all tests which have not been run are reported as not run.";
+        public const bool OptionFailFastDefaultValue = false;
+
+        public virtual bool FailFast => _currentSettings.FailFast ?? OptionFailFastDefaultValue;
+
+
+        public const string OptionPrioritizeFailedAndLongTests = "Prioritize failed and long tests";
+        public const string OptionPrioritizeFailedAndLongTestsDescription =
+            "If true, the tests which have failed when they were run last are run first, followed by the remaining tests of all executables in order of decreasing " +
+            "expected duration. Outcomes and durations of the last run are taken from the .gta.testdurations files.";
+        public const bool OptionPrioritizeFailedAndLongTestsDefaultValue = false;
+
+        public virtual bool PrioritizeFailedAndLongTests => _currentSettings.PrioritizeFailedAndLongTests ?? OptionPrioritizeFailedAndLongTestsDefaultValue;
+
+
+        public const string OptionExecutableAffinitySplitting = "Keep executables together";
+        public const string OptionExecutableAffinitySplittingDescription =
+            "If true, tests are distributed to the threads such that as few test processes as possible are launched: executables (and suites) are assigned " +
+            "to a single thread as a whole unless this would prolong the test run. Process startup and suite setup are taken into account as costs of their own.";
+        public const bool OptionExecutableAffinitySplittingDefaultValue = false;
+
+        public virtual bool ExecutableAffinitySplitting => _currentSettings.ExecutableAffinitySplitting ?? OptionExecutableAffinitySplittingDefaultValue;
+
+
+        public const string OptionRemoteAgents = "Remote agents";
+        public const string OptionRemoteAgentsDescription =
+            "If not empty, tests are executed by remote agents (GoogleTestAdapter.RemoteAgent.exe) instead of local processes. Format: host:port, separated by ';'. Each agent executes one test process at a time; " +
+            "list an agent several times to run several processes on it concurrently. Tests are distributed to the agents by means of work stealing, taking into account known test durations. " +
+            "Test executables and result files must be accessible by the agents under the same paths (see option '" + OptionRemoteOutputDirectory + "'). " +
+            "Environment variable " + RemoteAgentProtocol.SecretEnvironmentVariable + " must contain the secret the agents have been started with. " +
+            "Test setup and teardown batches are executed on the local machine.";
+        public const string OptionRemoteAgentsDefaultValue = "";
+
+        public virtual string RemoteAgents => _currentSettings.RemoteAgents ?? OptionRemoteAgentsDefaultValue;
+
+
+        public const string OptionRemoteOutputDirectory = "Remote output directory";
+        public const string OptionRemoteOutputDirectoryDescription =
+            "Directory to which test executables executed by remote agents write their result files. Must be accessible by the adapter and all agents under the same path (e.g. a network share). " +
+            "If empty, the local temp directory is used, which only works for agents running on the local machine.";
+        public const string OptionRemoteOutputDirectoryDefaultValue = "";
+
+        public virtual string RemoteOutputDirectory => _currentSettings.RemoteOutputDirectory ?? OptionRemoteOutputDirectoryDefaultValue;
+
+
+        public const string OptionResultCacheDirectory = "Result cache directory";
+        public const string OptionResultCacheDirectoryDescription =
+            "If not empty, results of passed tests are cached in the given directory (absolute path). If all tests to be run from an executable have passed before, and neither the executable nor its DLLs (imported directly or indirectly, and located next to it or in the path extension) " +
+            "nor the settings determining its command line and environment (including the use of flag files, event streams, and test servers) have changed since then, the tests are not run again; instead, the cached results are reported. " +
+            "Cached results are not used while debugging and if an exit code test is configured.";
+        public const string OptionResultCacheDirectoryDefaultValue = "";
+
+        public virtual string ResultCacheDirectory => _currentSettings.ResultCacheDirectory ?? OptionResultCacheDirectoryDefaultValue;
+
+
+        public const string OptionChangedFilesList = "Changed files list";
+        public const string OptionChangedFilesListDescription =
+            "If not empty, only tests affected by the changed source files listed in the given file (absolute path, one file per line, e.g. created with 'git diff --name-only') are run. " +
+            "An executable is affected if one of the files is part of its debug symbols or of those of its DLLs located next to it; if the changed files of an executable all contain tests, only these tests are run. " +
+            "Changed header files which are not part of any executable's debug symbols cause all tests to be run.";
+        public const string OptionChangedFilesListDefaultValue = "";
+
+        public virtual string ChangedFilesList => _currentSettings.ChangedFilesList ?? OptionChangedFilesListDefaultValue;
+
+
+        public const string OptionAsyncResultReporting = "Report results asynchronously";
+        public const string OptionAsyncResultReportingDescription =
+            "If true, test results are reported to VS (and test durations are stored) by a dedicated thread, such that test threads can start their next test process immediately. " +
+            "Test threads only have to wait if a large number of results is still waiting to be reported.";
+        public const bool OptionAsyncResultReportingDefaultValue = false;
+
+        public virtual bool AsyncResultReporting => _currentSettings.AsyncResultReporting ?? OptionAsyncResultReportingDefaultValue;
+
+
+        public const string OptionPreSpawnTestProcesses = "Pre-spawn test processes";
+        public const string OptionPreSpawnTestProcessesDescription =
+            "If true, the process of a thread's next test batch is created in suspended state while the current batch is still running, and resumed as soon as the current batch has finished. " +
+            "This hides process creation overhead (e.g. caused by anti virus software) if tests are run in many batches. Not used when debugging, with test servers, remote agents, or work stealing.";
+        public const bool OptionPreSpawnTestProcessesDefaultValue = false;
+
+        public virtual bool PreSpawnTestProcesses => _currentSettings.PreSpawnTestProcesses ?? OptionPreSpawnTestProcessesDefaultValue;
+
+
+        public const string OptionPinTestThreadsToCpus = "Pin test threads to CPUs";
+        public const string OptionPinTestThreadsToCpusDescription =
+            "If true and tests are executed in parallel, the test processes of each thread (including their child processes) are pinned to a set of logical processors which is disjoint from the sets of the other threads. " +
+            "A set does not span NUMA nodes unless there are fewer threads than nodes. " +
+            "The set is available to tests via the placeholders " + PlaceholderReplacer.CpuSetPlaceholder + ", " + PlaceholderReplacer.CpuCountPlaceholder + " and " + PlaceholderReplacer.NumaNodesPlaceholder + " and via the environment variables " + CpuSet.CpuSetEnvironmentVariable + ", " + CpuSet.CpuCountEnvironmentVariable + " and " + CpuSet.NumaNodesEnvironmentVariable + ".";
+        public const bool OptionPinTestThreadsToCpusDefaultValue = false;
+
+        public virtual bool PinTestThreadsToCpus => _currentSettings.PinTestThreadsToCpus ?? OptionPinTestThreadsToCpusDefaultValue;
+
+
+        public const string OptionMemoryBudgetInMb = "Memory budget in MB";
+        public const string OptionMemoryBudgetInMbDescription =
+            "If tests are executed in parallel, a test process is only started if the sum of the peak memory usages (committed memory, including child processes) of the running test processes and of the new process stays within this number of MB. " +
+            "Peak memory usages are predicted from the previous runs of the executables, which are stored together with the test durations; executables without history are not restricted. " +
+            "Threads which would exceed the budget wait until enough memory is available, while other threads keep running lighter executables (but only for a limited number of times, such that heavy executables do not starve). 0 disables the budget.";
+        public const int OptionMemoryBudgetInMbDefaultValue = 0;
+
+        public virtual int MemoryBudgetInMb => _currentSettings.MemoryBudgetInMb ?? OptionMemoryBudgetInMbDefaultValue;
+
         #endregion
 
         #region TestDiscoveryOptionsPage
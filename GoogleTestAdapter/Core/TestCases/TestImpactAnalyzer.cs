@@ -0,0 +1,155 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using GoogleTestAdapter.Common;
+using GoogleTestAdapter.DiaResolver;
+using GoogleTestAdapter.Model;
+using GoogleTestAdapter.Settings;
+
+namespace GoogleTestAdapter.TestCases
+{
+
+    /// <summary>
+    /// Selects the tests affected by a set of changed source files. The source files an executable consists of
+    /// are taken from the line tables of its pdb and of the pdbs of its DLLs located next to it. An executable
+    /// is affected if one of its source files has changed; if all its changed files contain tests (according
+    /// to the tests' code file paths), only these tests are selected, otherwise all tests of the executable.
+    /// Executables without symbol information are always selected. Header files only containing declarations
+    /// do not show up in line tables, so a changed header which is not part of any executable causes all
+    /// tests to be selected.
+    /// </summary>
+    public class TestImpactAnalyzer
+    {
+        private static readonly string[] HeaderFileExtensions = { ".h", ".hh", ".hpp", ".hxx", ".h++", ".inl", ".ipp", ".tcc" };
+
+        private readonly IDiaResolverFactory _diaResolverFactory;
+        private readonly SettingsWrapper _settings;
+        private readonly ILogger _logger;
+
+        public TestImpactAnalyzer(IDiaResolverFactory diaResolverFactory, SettingsWrapper settings, ILogger logger)
+        {
+            _diaResolverFactory = diaResolverFactory;
+            _settings = settings;
+            _logger = logger;
+        }
+
+        public static IList<string> ReadChangedFiles(string changedFilesList)
+        {
+            return File.ReadAllLines(changedFilesList)
+                .Select(l => l.Trim())
+                .Where(l => l.Length > 0)
+                .ToList();
+        }
+
+        public IList<TestCase> SelectAffectedTests(IEnumerable<TestCase> testCases, IEnumerable<string> changedFiles)
+        {
+            TestCase[] testCasesAsArray = testCases as TestCase[] ?? testCases.ToArray();
+            List<string> normalizedChangedFiles = changedFiles.Select(Normalize).Where(f => f.Length > 0).Distinct().ToList();
+
+            var affectedTests = new List<TestCase>();
+            var knownChangedFiles = new HashSet<string>();
+            foreach (IGrouping<string, TestCase> testCasesOfExecutable in testCasesAsArray.GroupBy(tc => tc.Source))
+            {
+                string executable = testCasesOfExecutable.Key;
+                ISet<string> sourceFiles = null;
+                _settings.ExecuteWithSettingsForExecutable(executable, _logger, () =>
+                {
+                    sourceFiles = GetSourceFiles(executable);
+                });
+
+                if (sourceFiles == null)
+                {
+                    _logger.DebugInfo($"No source files found for executable {executable}, selecting all its tests");
+                    affectedTests.AddRange(testCasesOfExecutable);
+                    continue;
+                }
+
+                List<string> changedSourceFiles = normalizedChangedFiles
+                    .Where(f => sourceFiles.Any(s => IsSameFile(s, f)))
+                    .ToList();
+                knownChangedFiles.UnionWith(changedSourceFiles);
+                if (changedSourceFiles.Count == 0)
+                    continue;
+
+                List<TestCase> testsInChangedFiles = testCasesOfExecutable
+                    .Where(tc => changedSourceFiles.Any(f => IsSameFile(Normalize(tc.CodeFilePath ?? ""), f)))
+                    .ToList();
+                bool onlyTestFilesChanged = changedSourceFiles
+                    .All(f => testsInChangedFiles.Any(tc => IsSameFile(Normalize(tc.CodeFilePath ?? ""), f)));
+                affectedTests.AddRange(onlyTestFilesChanged ? testsInChangedFiles : testCasesOfExecutable.ToList());
+                _logger.DebugInfo($"Executable {executable} is affected by {string.Join(", ", changedSourceFiles)}");
+            }
+
+            List<string> unknownHeaderFiles = normalizedChangedFiles
+                .Where(f => !knownChangedFiles.Contains(f) && HeaderFileExtensions.Contains(Path.GetExtension(f)))
+                .ToList();
+            if (unknownHeaderFiles.Count > 0)
+            {
+                _logger.LogInfo($"Changed header files {string.Join(", ", unknownHeaderFiles)} are not part of the debug symbols of any executable, selecting all tests");
+                return testCasesAsArray;
+            }
+
+            return affectedTests;
+        }
+
+        private ISet<string> GetSourceFiles(string executable)
+        {
+            ISet<string> sourceFiles = GetSourceFilesOfBinary(executable, executable);
+            if (sourceFiles == null)
+                return null;
+
+            string moduleDirectory = Path.GetDirectoryName(executable);
+            foreach (string import in PeParser.ParseImports(executable, _logger))
+            {
+                // ReSharper disable once AssignNullToNotNullAttribute
+                string importedBinary = Path.Combine(moduleDirectory, import);
+                if (File.Exists(importedBinary))
+                    sourceFiles.UnionWith(GetSourceFilesOfBinary(importedBinary, executable) ?? Enumerable.Empty<string>());
+            }
+
+            return sourceFiles.Count > 0 ? sourceFiles : null;
+        }
+
+        private ISet<string> GetSourceFilesOfBinary(string binary, string executable)
+        {
+            string pdb = PdbLocator.FindPdbFile(binary, _settings.GetPathExtension(executable), _logger);
+            if (pdb == null)
+            {
+                _logger.DebugWarning($"No .pdb file found for '{binary}'");
+                return null;
+            }
+
+            using (IDiaResolver diaResolver = _diaResolverFactory.Create(binary, pdb, _logger))
+            {
+                try
+                {
+                    return new HashSet<string>(diaResolver.GetSourceFiles().Select(Normalize));
+                }
+                catch (Exception e)
+                {
+                    _logger.DebugError($"Exception while resolving source files of '{binary}':{Environment.NewLine}{e}");
+                    return null;
+                }
+            }
+        }
+
+        private static string Normalize(string file)
+        {
+            string normalized = file.Trim().Replace('/', '\\').ToLowerInvariant();
+            return normalized.StartsWith(".\\") ? normalized.Substring(2) : normalized;
+        }
+
+        /// <summary>
+        /// Changed files are usually given relative to the repository root (as printed by git), whereas
+        /// pdbs contain absolute paths
+        /// </summary>
+        private static bool IsSameFile(string sourceFile, string changedFile)
+        {
+            return sourceFile.Length > 0
+                && (sourceFile == changedFile || sourceFile.EndsWith("\\" + changedFile));
+        }
+
+    }
+
+}
@@ -0,0 +1,201 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+using GoogleTestAdapter.Common;
+using GoogleTestAdapter.Model;
+
+namespace GoogleTestAdapter.TestResults
+{
+    /// <summary>
+    /// Creates test results from the binary event stream written by the listener provided in GTA_EventListener.h
+    /// (see there for the format). In contrast to the console and XML parsers, no text has to be scanned for
+    /// markers, and durations are available with microsecond resolution.
+    /// </summary>
+    public class EventStreamTestResultParser
+    {
+        public const string EnvironmentVariable = "GTA_EVENT_STREAM";
+
+        private const byte TestStart = 1;
+        private const byte TestFailure = 2;
+        private const byte TestEnd = 3;
+        private const byte TestResourceUsage = 4;
+
+        private const byte OutcomeFailed = 1;
+        private const byte OutcomeSkipped = 2;
+
+        private readonly IDictionary<string, TestCase> _testCasesMap;
+        private readonly string _eventStreamFile;
+        private readonly ILogger _logger;
+
+        private long _position;
+        private bool _isCorrupt;
+        private string _currentTest;
+        private readonly List<string> _failures = new List<string>();
+        private ResourceUsage _resourceUsage;
+
+        public TestCase CrashedTestCase { get; private set; }
+
+        public EventStreamTestResultParser(IEnumerable<TestCase> testCasesRun, string eventStreamFile, ILogger logger)
+        {
+            _testCasesMap = testCasesRun.ToDictionary(tc => tc.FullyQualifiedName, tc => tc);
+            _eventStreamFile = eventStreamFile;
+            _logger = logger;
+        }
+
+        /// <summary>
+        /// Returns the results of the tests which have finished since the last call. Only complete records are
+        /// consumed, so this can be called repeatedly while the listener is still writing the stream.
+        /// </summary>
+        public IList<TestResult> ReadNewTestResults()
+        {
+            var testResults = new List<TestResult>();
+            if (_isCorrupt || !File.Exists(_eventStreamFile))
+                return testResults;
+
+            // the listener still has the file open for writing while the executable is running
+            using (var stream = new FileStream(_eventStreamFile, FileMode.Open, FileAccess.Read, FileShare.ReadWrite | FileShare.Delete))
+            using (var reader = new BinaryReader(stream))
+            {
+                stream.Position = _position;
+                while (stream.Length - stream.Position >= 5)
+                {
+                    int payloadLength = reader.ReadInt32();
+                    byte recordType = reader.ReadByte();
+                    if (payloadLength < 0 || stream.Length - stream.Position < payloadLength)
+                        break;
+
+                    byte[] payload = reader.ReadBytes(payloadLength);
+                    try
+                    {
+                        ProcessRecord(recordType, payload, testResults);
+                    }
+                    catch (EndOfStreamException)
+                    {
+                        _logger.DebugWarning($"Event stream {_eventStreamFile} contains an invalid record - ignoring the rest of the stream");
+                        _isCorrupt = true;
+                        break;
+                    }
+                    _position = stream.Position;
+                }
+            }
+
+            return testResults;
+        }
+
+        /// <summary>
+        /// Reads the rest of the (complete) stream and returns the results which have not yet been returned by
+        /// ReadNewTestResults(). If the stream ends within a test, that test is reported as crashed.
+        /// </summary>
+        public List<TestResult> GetTestResults()
+        {
+            var testResults = new List<TestResult>();
+            if (!File.Exists(_eventStreamFile))
+                return testResults;
+
+            testResults.AddRange(ReadNewTestResults());
+            if (!_isCorrupt && new FileInfo(_eventStreamFile).Length > _position)
+                _logger.DebugWarning($"Event stream {_eventStreamFile} ends with an incomplete record - your test executable has probably crashed");
+
+            if (_currentTest != null && _testCasesMap.TryGetValue(_currentTest, out TestCase crashedTestCase))
+            {
+                CrashedTestCase = crashedTestCase;
+                string message = StreamingStandardOutputTestResultParser.CrashText;
+                if (_failures.Count > 0)
+                    message += $"\nTest output:\n\n{string.Join("\n", _failures)}";
+                testResults.Add(StreamingStandardOutputTestResultParser.CreateFailedTestResult(crashedTestCase, TimeSpan.FromMilliseconds(0), message, ""));
+                _currentTest = null;
+            }
+
+            return testResults;
+        }
+
+        private void ProcessRecord(byte recordType, byte[] payload, List<TestResult> testResults)
+        {
+            // records of unknown type are skipped for compatibility with future versions of the listener
+            using (var payloadReader = new BinaryReader(new MemoryStream(payload)))
+            {
+                switch (recordType)
+                {
+                    case TestStart:
+                        _currentTest = ReadString(payloadReader);
+                        _failures.Clear();
+                        _resourceUsage = null;
+                        break;
+                    case TestFailure:
+                        string file = ReadString(payloadReader);
+                        int line = payloadReader.ReadInt32();
+                        string message = ReadString(payloadReader);
+                        _failures.Add(string.IsNullOrEmpty(file) ? $"unknown file: error: {message}" : $"{file}({line}): error: {message}");
+                        break;
+                    case TestEnd:
+                        string testName = ReadString(payloadReader);
+                        byte outcome = payloadReader.ReadByte();
+                        long durationInUs = payloadReader.ReadInt64();
+                        AddTestResult(testResults, testName, outcome, TimeSpan.FromTicks(durationInUs * 10), _failures, _resourceUsage);
+                        _currentTest = null;
+                        _failures.Clear();
+                        _resourceUsage = null;
+                        break;
+                    case TestResourceUsage:
+                        ReadString(payloadReader);
+                        _resourceUsage = new ResourceUsage
+                        {
+                            UserTime = TimeSpan.FromTicks(payloadReader.ReadInt64() * 10),
+                            KernelTime = TimeSpan.FromTicks(payloadReader.ReadInt64() * 10),
+                            PeakMemoryInBytes = payloadReader.ReadInt64(),
+                            PageFaults = payloadReader.ReadInt64(),
+                            ReadBytes = payloadReader.ReadInt64(),
+                            WriteBytes = payloadReader.ReadInt64()
+                        };
+                        break;
+                }
+            }
+        }
+
+        private void AddTestResult(List<TestResult> testResults, string testName, byte outcome, TimeSpan duration, IList<string> failures, ResourceUsage resourceUsage)
+        {
+            if (!_testCasesMap.TryGetValue(testName, out TestCase testCase))
+            {
+                _logger.DebugWarning($"No known test case for test '{testName}' of event stream {_eventStreamFile}");
+                return;
+            }
+
+            duration = StreamingStandardOutputTestResultParser.NormalizeDuration(duration);
+            switch (outcome)
+            {
+                case OutcomeFailed:
+                    // failures are formatted like Google Test's console output such that file and line are recognized
+                    var parser = new ErrorMessageParser(string.Join("\n", failures));
+                    parser.Parse();
+                    testResults.Add(StreamingStandardOutputTestResultParser.CreateFailedTestResult(testCase, duration, parser.ErrorMessage, parser.ErrorStackTrace));
+                    break;
+                case OutcomeSkipped:
+                    testResults.Add(new TestResult(testCase)
+                    {
+                        ComputerName = Environment.MachineName,
+                        DisplayName = testCase.DisplayName,
+                        Outcome = TestOutcome.Skipped,
+                        Duration = duration
+                    });
+                    break;
+                default:
+                    testResults.Add(StreamingStandardOutputTestResultParser.CreatePassedTestResult(testCase, duration));
+                    break;
+            }
+            testResults[testResults.Count - 1].ResourceUsage = resourceUsage;
+        }
+
+        private static string ReadString(BinaryReader reader)
+        {
+            int length = reader.ReadInt32();
+            byte[] bytes = reader.ReadBytes(length);
+            if (bytes.Length < length)
+                throw new EndOfStreamException();
+            return Encoding.UTF8.GetString(bytes);
+        }
+
+    }
+
+}
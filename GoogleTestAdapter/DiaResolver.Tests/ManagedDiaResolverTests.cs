@@ -0,0 +1,151 @@
+﻿using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Threading.Tasks;
+using FluentAssertions;
+using GoogleTestAdapter.Common;
+using GoogleTestAdapter.Tests.Common;
+using GoogleTestAdapter.Tests.Common.Fakes;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using static GoogleTestAdapter.Tests.Common.TestMetadata.TestCategories;
+
+namespace GoogleTestAdapter.DiaResolver
+{
+
+    [TestClass]
+    public class ManagedDiaResolverTests
+    {
+        private const string SourceFile = @"C:\src\test.cpp";
+        private const string OtherSourceFile = @"C:\src\other_test.cpp";
+
+        private string _pdb;
+
+        [TestInitialize]
+        public void Setup()
+        {
+            _pdb = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName() + ".pdb");
+            new TestPdbBuilder()
+                .AddFunction("FooTest_DoesXyz_Test::TestBody", 1, 0x1000, 0x40, SourceFile, 17)
+                .AddFunction("FooTest_DoesAbc_Test::TestBody", 1, 0x1040, 0x40, SourceFile, 23)
+                .AddFunction("BarTest_Bar_Test::TestBody", 1, 0x1080, 0x20, OtherSourceFile, 5)
+                .AddFunction("main", 1, 0x2000, 0x10, OtherSourceFile, 42)
+                .AddPublicFunction("_main", 1, 0x2000)
+                .AddPublicFunction("_someImportedFunction", 2, 0x10)
+                .WriteTo(_pdb);
+        }
+
+        [TestCleanup]
+        public void TearDown()
+        {
+            File.Delete(_pdb);
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetFunctions_SyntheticPdb_TestBodiesAreResolved()
+        {
+            var locations = GetFunctions("*::TestBody");
+
+            locations.Select(l => $"{l.Symbol}|{l.Sourcefile}|{l.Line}").Should().BeEquivalentTo(
+                $"FooTest_DoesXyz_Test::TestBody|{SourceFile}|17",
+                $"FooTest_DoesAbc_Test::TestBody|{SourceFile}|23",
+                $"BarTest_Bar_Test::TestBody|{OtherSourceFile}|5");
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetFunctions_SyntheticPdb_QuestionMarkMatchesSingleCharacter()
+        {
+            GetFunctions("ma?n").Select(l => l.Symbol).Should().BeEquivalentTo("main");
+            GetFunctions("ma?").Should().BeEmpty();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetFunctions_SyntheticPdb_PublicSymbolsAreOnlyAddedIfNotCoveredByModuleSymbols()
+        {
+            var fakeLogger = new FakeLogger(() => OutputMode.Info);
+            var locations = GetFunctions("*", fakeLogger);
+
+            locations.Should().HaveCount(5);
+            locations.Should().NotContain(l => l.Symbol == "_main");
+            fakeLogger.Warnings.Should().ContainSingle(msg => msg.Contains("_someImportedFunction"));
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetFunctions_SyntheticPdb_NonMatchingFilter_NoResults()
+        {
+            GetFunctions("ThisFunctionDoesNotExist").Should().BeEmpty();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetFunctions_ConcurrentCalls_AllReturnSameResults()
+        {
+            using (IDiaResolver resolver = ManagedDiaResolverFactory.Instance.Create("foo.exe", _pdb, new FakeLogger()))
+            {
+                var results = new IList<SourceFileLocation>[64];
+                Parallel.For(0, results.Length, i => results[i] = resolver.GetFunctions("*::TestBody"));
+
+                results.Should().OnlyContain(r => r.Count == 3);
+            }
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetFunctions_PdbDoesNotExist_ErrorIsLogged()
+        {
+            var fakeLogger = new FakeLogger(() => OutputMode.Info);
+            var locations = GetFunctions("*", fakeLogger, _pdb + ".doesnotexist");
+
+            locations.Should().BeEmpty();
+            fakeLogger.Errors.Should().Contain(msg => msg.Contains("PDB file") && msg.Contains("does not exist"));
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void GetFunctions_FileIsNoPdb_ErrorIsLogged()
+        {
+            File.WriteAllText(_pdb, "This is not a pdb file, but it is long enough to contain a super block.");
+            var fakeLogger = new FakeLogger(() => OutputMode.Info);
+            var locations = GetFunctions("*", fakeLogger);
+
+            locations.Should().BeEmpty();
+            fakeLogger.Errors.Should().Contain(msg => msg.Contains("Could not parse pdb file"));
+        }
+
+        [TestMethod]
+        [TestCategory(Integration)]
+        public void GetFunctions_SampleTests_SameTestLocationsAsDia()
+        {
+            string executable = TestResources.Tests_DebugX86;
+            var fakeLogger = new FakeLogger(() => OutputMode.Info);
+            string pdb = PdbLocator.FindPdbFile(executable, "", fakeLogger);
+
+            IList<SourceFileLocation> expected, actual;
+            using (IDiaResolver resolver = DefaultDiaResolverFactory.Instance.Create(executable, pdb, fakeLogger))
+            {
+                expected = resolver.GetFunctions("*::TestBody");
+            }
+            using (IDiaResolver resolver = ManagedDiaResolverFactory.Instance.Create(executable, pdb, fakeLogger))
+            {
+                actual = resolver.GetFunctions("*::TestBody");
+            }
+
+            expected.Should().NotBeEmpty();
+            actual.Select(l => $"{l.Symbol}|{l.Sourcefile}|{l.Line}")
+                .Should().BeEquivalentTo(expected.Select(l => $"{l.Symbol}|{l.Sourcefile}|{l.Line}"));
+        }
+
+        private IList<SourceFileLocation> GetFunctions(string filter, ILogger logger = null, string pdb = null)
+        {
+            using (IDiaResolver resolver = ManagedDiaResolverFactory.Instance.Create("foo.exe", pdb ?? _pdb, logger ?? new FakeLogger()))
+            {
+                return resolver.GetFunctions(filter);
+            }
+        }
+
+    }
+
+}
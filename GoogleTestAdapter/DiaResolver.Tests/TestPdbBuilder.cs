@@ -0,0 +1,321 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+
+namespace GoogleTestAdapter.DiaResolver
+{
+    /// <summary>
+    /// Writes minimal pdb files (MSF 7.00 container, PDB info stream, /names, DBI stream with a single module
+    /// containing S_GPROC32 symbols and C13 line tables, and a symbol record stream with S_PUB32 symbols).
+    /// Allows to test the managed pdb reader on any machine without depending on binaries built by msvc.
+    /// </summary>
+    internal class TestPdbBuilder
+    {
+        private const int BlockSize = 512;
+
+        private class Function
+        {
+            internal string Name;
+            internal ushort Segment;
+            internal uint Offset;
+            internal uint Length;
+            internal string SourceFile;
+            internal uint Line;
+        }
+
+        private readonly List<Function> _functions = new List<Function>();
+        private readonly List<Function> _publicFunctions = new List<Function>();
+
+        internal TestPdbBuilder AddFunction(string name, ushort segment, uint offset, uint length, string sourceFile, uint line)
+        {
+            _functions.Add(new Function { Name = name, Segment = segment, Offset = offset, Length = length, SourceFile = sourceFile, Line = line });
+            return this;
+        }
+
+        internal TestPdbBuilder AddPublicFunction(string name, ushort segment, uint offset)
+        {
+            _publicFunctions.Add(new Function { Name = name, Segment = segment, Offset = offset });
+            return this;
+        }
+
+        internal void WriteTo(string pdb)
+        {
+            File.WriteAllBytes(pdb, Build());
+        }
+
+        internal byte[] Build()
+        {
+            var names = new NamesBuilder();
+            int symbolBytes, c13Bytes;
+            byte[] moduleStream = CreateModuleStream(names, out symbolBytes, out c13Bytes);
+
+            var streams = new List<byte[]>
+            {
+                new byte[0],
+                CreatePdbInfoStream(),
+                new byte[0],
+                CreateDbiStream(6, 7, symbolBytes, c13Bytes),
+                new byte[0],
+                names.ToArray(),
+                moduleStream,
+                CreateSymbolRecordStream()
+            };
+            return CreateMsf(streams);
+        }
+
+        private static byte[] CreatePdbInfoStream()
+        {
+            var writer = new Writer();
+            writer.UInt32(20000404); // version
+            writer.UInt32(0); // signature
+            writer.UInt32(1); // age
+            writer.Bytes(new byte[16]); // guid
+
+            byte[] strings = Encoding.ASCII.GetBytes("/names\0");
+            writer.Int32(strings.Length);
+            writer.Bytes(strings);
+
+            writer.Int32(1); // size
+            writer.Int32(1); // capacity
+            writer.Int32(1); // present words
+            writer.UInt32(1);
+            writer.Int32(0); // deleted words
+            writer.Int32(0); // key: offset of "/names"
+            writer.Int32(5); // value: stream index
+            return writer.ToArray();
+        }
+
+        private static byte[] CreateDbiStream(ushort moduleStream, ushort symbolRecordStream, int symbolBytes, int c13Bytes)
+        {
+            var moduleInfo = new Writer();
+            moduleInfo.Bytes(new byte[34]);
+            moduleInfo.UInt16(moduleStream);
+            moduleInfo.Int32(symbolBytes);
+            moduleInfo.Int32(0); // C11 lines
+            moduleInfo.Int32(c13Bytes);
+            moduleInfo.Bytes(new byte[16]);
+            moduleInfo.CString(@"C:\src\test.obj");
+            moduleInfo.CString(@"C:\src\test.obj");
+            moduleInfo.Align4();
+            byte[] moduleInfoBytes = moduleInfo.ToArray();
+
+            var writer = new Writer();
+            writer.Int32(-1); // version signature
+            writer.UInt32(19990903); // version header
+            writer.UInt32(1); // age
+            writer.UInt16(0xFFFF); // global stream
+            writer.UInt16(0); // build number
+            writer.UInt16(0xFFFF); // public stream
+            writer.UInt16(0); // pdb dll version
+            writer.UInt16(symbolRecordStream);
+            writer.UInt16(0); // pdb dll rebuild
+            writer.Int32(moduleInfoBytes.Length);
+            writer.Bytes(new byte[64 - 28]);
+            writer.Bytes(moduleInfoBytes);
+            return writer.ToArray();
+        }
+
+        private byte[] CreateModuleStream(NamesBuilder names, out int symbolBytes, out int c13Bytes)
+        {
+            var symbols = new Writer();
+            symbols.UInt32(4); // CV signature
+            foreach (Function function in _functions)
+            {
+                var record = new Writer();
+                record.UInt16(0x1110); // S_GPROC32
+                record.Bytes(new byte[12]); // parent, end, next
+                record.UInt32(function.Length);
+                record.Bytes(new byte[12]); // debug start, debug end, type
+                record.UInt32(function.Offset);
+                record.UInt16(function.Segment);
+                record.Byte(0); // flags
+                record.CString(function.Name);
+                record.Align4(2);
+                byte[] recordBytes = record.ToArray();
+
+                symbols.UInt16((ushort)recordBytes.Length);
+                symbols.Bytes(recordBytes);
+            }
+            symbolBytes = symbols.Length;
+
+            var fileChecksums = new Writer();
+            var checksumOffsets = new Dictionary<string, int>();
+            foreach (string sourceFile in _functions.Select(f => f.SourceFile).Distinct())
+            {
+                checksumOffsets[sourceFile] = fileChecksums.Length;
+                fileChecksums.Int32(names.Add(sourceFile));
+                fileChecksums.Byte(0); // checksum size
+                fileChecksums.Byte(0); // checksum kind
+                fileChecksums.Align4();
+            }
+
+            var lines = new Writer();
+            foreach (Function function in _functions)
+            {
+                var subsection = new Writer();
+                subsection.UInt32(function.Offset);
+                subsection.UInt16(function.Segment);
+                subsection.UInt16(0); // flags
+                subsection.UInt32(function.Length);
+                subsection.Int32(checksumOffsets[function.SourceFile]);
+                subsection.Int32(2); // number of lines
+                subsection.Int32(12 + 2 * 8);
+                subsection.UInt32(0);
+                subsection.UInt32(function.Line | 0x80000000);
+                subsection.UInt32(function.Length / 2);
+                subsection.UInt32((function.Line + 1) | 0x80000000);
+                WriteSubsection(lines, 0xF2, subsection.ToArray());
+            }
+            WriteSubsection(lines, 0xF4, fileChecksums.ToArray());
+            c13Bytes = lines.Length;
+
+            return symbols.ToArray().Concat(lines.ToArray()).ToArray();
+        }
+
+        private static void WriteSubsection(Writer writer, uint kind, byte[] data)
+        {
+            writer.UInt32(kind);
+            writer.Int32(data.Length);
+            writer.Bytes(data);
+            writer.Align4();
+        }
+
+        private byte[] CreateSymbolRecordStream()
+        {
+            var writer = new Writer();
+            foreach (Function function in _publicFunctions)
+            {
+                var record = new Writer();
+                record.UInt16(0x110E); // S_PUB32
+                record.UInt32(0x2); // function
+                record.UInt32(function.Offset);
+                record.UInt16(function.Segment);
+                record.CString(function.Name);
+                record.Align4(2);
+                byte[] recordBytes = record.ToArray();
+
+                writer.UInt16((ushort)recordBytes.Length);
+                writer.Bytes(recordBytes);
+            }
+            return writer.ToArray();
+        }
+
+        private static byte[] CreateMsf(List<byte[]> streams)
+        {
+            // block 0: super block, blocks 1 and 2: free block maps
+            int nextBlock = 3;
+            var streamBlocks = new List<int[]>();
+            foreach (byte[] stream in streams)
+            {
+                int[] blocks = Enumerable.Range(nextBlock, NrOfBlocks(stream.Length)).ToArray();
+                nextBlock += blocks.Length;
+                streamBlocks.Add(blocks);
+            }
+
+            var directory = new Writer();
+            directory.Int32(streams.Count);
+            foreach (byte[] stream in streams)
+                directory.Int32(stream.Length);
+            foreach (int block in streamBlocks.SelectMany(b => b))
+                directory.Int32(block);
+
+            byte[] directoryBytes = directory.ToArray();
+            int[] directoryBlocks = Enumerable.Range(nextBlock, NrOfBlocks(directoryBytes.Length)).ToArray();
+            nextBlock += directoryBlocks.Length;
+            int blockMapBlock = nextBlock++;
+
+            var file = new byte[nextBlock * BlockSize];
+            var superBlock = new Writer();
+            superBlock.Bytes(Encoding.ASCII.GetBytes("Microsoft C/C++ MSF 7.00\r\n\x1a" + "DS\0\0\0"));
+            superBlock.Int32(BlockSize);
+            superBlock.Int32(1); // free block map
+            superBlock.Int32(nextBlock);
+            superBlock.Int32(directoryBytes.Length);
+            superBlock.Int32(0);
+            superBlock.Int32(blockMapBlock);
+            Copy(superBlock.ToArray(), file, new[] { 0 });
+
+            for (int i = 0; i < streams.Count; i++)
+                Copy(streams[i], file, streamBlocks[i]);
+            Copy(directoryBytes, file, directoryBlocks);
+
+            var blockMap = new Writer();
+            foreach (int block in directoryBlocks)
+                blockMap.Int32(block);
+            Copy(blockMap.ToArray(), file, new[] { blockMapBlock });
+
+            return file;
+        }
+
+        private static void Copy(byte[] data, byte[] file, int[] blocks)
+        {
+            for (int i = 0; i < blocks.Length; i++)
+            {
+                int count = Math.Min(BlockSize, data.Length - i * BlockSize);
+                Array.Copy(data, i * BlockSize, file, blocks[i] * BlockSize, count);
+            }
+        }
+
+        private static int NrOfBlocks(int nrOfBytes)
+        {
+            return (nrOfBytes + BlockSize - 1) / BlockSize;
+        }
+
+        private class NamesBuilder
+        {
+            private readonly Writer _strings = new Writer();
+
+            internal NamesBuilder()
+            {
+                _strings.Byte(0);
+            }
+
+            internal int Add(string name)
+            {
+                int offset = _strings.Length;
+                _strings.CString(name);
+                return offset;
+            }
+
+            internal byte[] ToArray()
+            {
+                byte[] strings = _strings.ToArray();
+                var writer = new Writer();
+                writer.UInt32(0xEFFEEFFE);
+                writer.UInt32(1);
+                writer.Int32(strings.Length);
+                writer.Bytes(strings);
+                return writer.ToArray();
+            }
+        }
+
+        private class Writer
+        {
+            private readonly MemoryStream _stream = new MemoryStream();
+
+            internal int Length => (int)_stream.Length;
+
+            internal void Byte(byte value) => _stream.WriteByte(value);
+            internal void UInt16(ushort value) => Bytes(BitConverter.GetBytes(value));
+            internal void Int32(int value) => Bytes(BitConverter.GetBytes(value));
+            internal void UInt32(uint value) => Bytes(BitConverter.GetBytes(value));
+            internal void Bytes(byte[] value) => _stream.Write(value, 0, value.Length);
+            internal void CString(string value) => Bytes(Encoding.UTF8.GetBytes(value + "\0"));
+
+            /// <summary>
+            /// Pads such that Length + offset is a multiple of 4
+            /// </summary>
+            internal void Align4(int offset = 0)
+            {
+                while ((Length + offset) % 4 != 0)
+                    Byte(0);
+            }
+
+            internal byte[] ToArray() => _stream.ToArray();
+        }
+
+    }
+
+}
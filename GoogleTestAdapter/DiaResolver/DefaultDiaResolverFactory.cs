@@ -1,4 +1,5 @@
-﻿using GoogleTestAdapter.Common;
+﻿using System;
+using GoogleTestAdapter.Common;
 
 namespace GoogleTestAdapter.DiaResolver
 {
@@ -8,7 +9,23 @@ namespace GoogleTestAdapter.DiaResolver
 
         public IDiaResolver Create(string binary, string pdb, ILogger logger)
         {
-            return new DiaResolver(binary, pdb, logger);
+            if (IsDiaAvailable())
+                return new DiaResolver(binary, pdb, logger);
+
+            logger.DebugInfo("msdia is not available, falling back to managed pdb reader");
+            return ManagedDiaResolverFactory.Instance.Create(binary, pdb, logger);
+        }
+
+        private static bool IsDiaAvailable()
+        {
+            try
+            {
+                return DiaFactory.IsAvailable;
+            }
+            catch (TypeInitializationException)
+            {
+                return false;
+            }
         }
     }
 }
\ No newline at end of file
@@ -23,6 +23,8 @@ namespace GoogleTestAdapter.DiaResolver
             MsdiaDll = NativeMethods.LoadLibrary(MsdiaDllPath);
         }
 
+        public static bool IsAvailable => MsdiaDll != IntPtr.Zero;
+
         public static IDiaDataSource CreateInstance()
         {
             if (MsdiaDll == IntPtr.Zero)
@@ -85,6 +85,21 @@ namespace GoogleTestAdapter.DiaResolver
             return GetSymbolNamesAndAddresses(diaSymbols).Select(ToSourceFileLocation).ToList();
         }
 
+        public IList<string> GetSourceFiles()
+        {
+            if (_diaDataSource == null) // Silently return when DIA failed to load
+                return new string[0];
+
+            IDiaEnumSourceFiles sourceFiles;
+            _diaSession.findFile(null, null, (uint)NameSearchOptions.NsNone, out sourceFiles);
+            var result = new List<string>();
+            foreach (IDiaSourceFile sourceFile in sourceFiles)
+            {
+                result.Add(sourceFile.fileName);
+            }
+            return result.Distinct(StringComparer.OrdinalIgnoreCase).ToList();
+        }
+
         /// From given symbol enumeration, extract name, section, offset and length
         private IList<NativeSourceFileLocation> GetSymbolNamesAndAddresses(IDiaEnumSymbols diaSymbols)
         {
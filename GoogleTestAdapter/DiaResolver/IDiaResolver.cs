@@ -6,5 +6,8 @@ namespace GoogleTestAdapter.DiaResolver
     public interface IDiaResolver : IDisposable
     {
         IList<SourceFileLocation> GetFunctions(string symbolFilterString);
+
+        /// <returns>The source files the line tables of the binary refer to.</returns>
+        IList<string> GetSourceFiles();
     }
 }
\ No newline at end of file
@@ -0,0 +1,121 @@
+﻿using GoogleTestAdapter.Common;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text.RegularExpressions;
+
+namespace GoogleTestAdapter.DiaResolver
+{
+    /// <summary>
+    /// Resolves source locations by reading the pdb file itself instead of going through msdia's COM interfaces.
+    /// The pdb is parsed completely at construction time, so instances are immutable afterwards and
+    /// GetFunctions() can safely be called from multiple threads concurrently.
+    /// </summary>
+    internal sealed class ManagedDiaResolver : IDiaResolver
+    {
+        private readonly string _binary;
+        private readonly ILogger _logger;
+        private readonly PdbFile _pdbFile;
+
+        internal ManagedDiaResolver(string binary, string pdb, ILogger logger)
+        {
+            _binary = binary;
+            _logger = logger;
+
+            if (!File.Exists(pdb))
+            {
+                _logger.LogError($"PDB file '{pdb}' does not exist");
+                return;
+            }
+
+            _logger.DebugInfo($"Parsing pdb file \"{pdb}\"");
+
+            try
+            {
+                using (var msfFile = new MsfFile(pdb))
+                {
+                    _pdbFile = new PdbFile(msfFile);
+                }
+            }
+            catch (Exception e)
+            {
+                _logger.LogError($"Could not parse pdb file '{pdb}': {e.Message}. You will not get any source locations for your tests.");
+                _logger.DebugError(e.ToString());
+            }
+        }
+
+        public void Dispose()
+        {
+        }
+
+        public IList<SourceFileLocation> GetFunctions(string symbolFilterString)
+        {
+            if (_pdbFile == null) // Silently return when the pdb could not be parsed
+                return new SourceFileLocation[0];
+
+            Regex filter = ToRegex(symbolFilterString);
+            return FindFunctions(filter).Select(ToSourceFileLocation).ToList();
+        }
+
+        public IList<string> GetSourceFiles()
+        {
+            if (_pdbFile == null)
+                return new string[0];
+
+            return _pdbFile.Modules
+                .SelectMany(m => m.LineBlocks)
+                .Select(b => b.SourceFile)
+                .Where(f => !string.IsNullOrEmpty(f))
+                .Distinct(StringComparer.OrdinalIgnoreCase)
+                .ToList();
+        }
+
+        /// <summary>
+        /// Function symbols of the modules; public symbols are only considered if a pdb does not provide
+        /// module symbols for the according address (e.g. for stripped pdbs)
+        /// </summary>
+        private IEnumerable<PdbFunction> FindFunctions(Regex filter)
+        {
+            var addresses = new HashSet<Tuple<ushort, uint>>();
+            foreach (PdbFunction function in _pdbFile.Functions)
+            {
+                addresses.Add(Tuple.Create(function.Segment, function.Offset));
+                if (filter.IsMatch(function.Name))
+                    yield return function;
+            }
+
+            foreach (PdbFunction function in _pdbFile.PublicFunctions)
+            {
+                if (!addresses.Contains(Tuple.Create(function.Segment, function.Offset)) && filter.IsMatch(function.Name))
+                    yield return function;
+            }
+        }
+
+        private SourceFileLocation ToSourceFileLocation(PdbFunction function)
+        {
+            string sourceFile;
+            uint line;
+            if (!_pdbFile.TryFindLine(function, out sourceFile, out line))
+            {
+                _logger.LogWarning("Failed to locate line number for " + function);
+                return new SourceFileLocation(_binary, "", 0);
+            }
+
+            return new SourceFileLocation(function.Name, sourceFile, line);
+        }
+
+        /// <summary>
+        /// Same semantics as msdia's NsfRegularExpression search option: '*' matches any sequence, '?' any single character
+        /// </summary>
+        internal static Regex ToRegex(string symbolFilterString)
+        {
+            string pattern = Regex.Escape(symbolFilterString)
+                .Replace(@"\*", ".*")
+                .Replace(@"\?", ".");
+            return new Regex($"^{pattern}$", RegexOptions.Singleline | RegexOptions.CultureInvariant);
+        }
+
+    }
+
+}
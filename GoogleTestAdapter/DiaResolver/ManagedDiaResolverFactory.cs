@@ -0,0 +1,14 @@
+﻿using GoogleTestAdapter.Common;
+
+namespace GoogleTestAdapter.DiaResolver
+{
+    public class ManagedDiaResolverFactory : IDiaResolverFactory
+    {
+        public static IDiaResolverFactory Instance { get; } = new ManagedDiaResolverFactory();
+
+        public IDiaResolver Create(string binary, string pdb, ILogger logger)
+        {
+            return new ManagedDiaResolver(binary, pdb, logger);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+﻿using System;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+using System.Text;
+
+namespace GoogleTestAdapter.DiaResolver
+{
+    /// <summary>
+    /// Read-only access to the streams of a multi-stream file (MSF 7.00), the container format of *.pdb files.
+    /// The file is memory-mapped; reading streams does not change any state and can thus happen from many threads concurrently.
+    /// </summary>
+    internal sealed class MsfFile : IDisposable
+    {
+        private const string Magic = "Microsoft C/C++ MSF 7.00\r\n\x1a" + "DS\0\0\0";
+        private const int SuperBlockSize = 56;
+        private const uint NilStreamSize = 0xFFFFFFFF;
+
+        private readonly MemoryMappedFile _file;
+        private readonly MemoryMappedViewAccessor _view;
+        private readonly long _fileSize;
+
+        private readonly int _blockSize;
+        private readonly int[] _streamSizes;
+        private readonly int[][] _streamBlocks;
+
+        internal MsfFile(string path)
+        {
+            using (var fileStream = File.Open(path, FileMode.Open, FileAccess.Read, FileShare.Read))
+            {
+                _fileSize = fileStream.Length;
+                if (_fileSize < SuperBlockSize)
+                    throw new InvalidDataException($"File '{path}' is too small to be a pdb file");
+
+                _file = MemoryMappedFile.CreateFromFile(fileStream, null, 0, MemoryMappedFileAccess.Read, null, HandleInheritability.None, true);
+            }
+
+            try
+            {
+                _view = _file.CreateViewAccessor(0, 0, MemoryMappedFileAccess.Read);
+
+                var superBlock = new byte[SuperBlockSize];
+                _view.ReadArray(0, superBlock, 0, SuperBlockSize);
+                if (Encoding.ASCII.GetString(superBlock, 0, Magic.Length) != Magic)
+                    throw new InvalidDataException($"File '{path}' is not a pdb file in MSF 7.00 format");
+
+                _blockSize = BitConverter.ToInt32(superBlock, 32);
+                int nrOfDirectoryBytes = BitConverter.ToInt32(superBlock, 44);
+                int blockMapAddress = BitConverter.ToInt32(superBlock, 52);
+                if (_blockSize <= 0 || (_blockSize & (_blockSize - 1)) != 0)
+                    throw new InvalidDataException($"Invalid MSF block size {_blockSize} in file '{path}'");
+
+                byte[] directory = ReadDirectory(nrOfDirectoryBytes, blockMapAddress);
+                ParseDirectory(directory, out _streamSizes, out _streamBlocks);
+            }
+            catch
+            {
+                Dispose();
+                throw;
+            }
+        }
+
+        internal int NrOfStreams => _streamSizes.Length;
+
+        internal bool HasStream(int index)
+        {
+            return index >= 0 && index < _streamSizes.Length && _streamSizes[index] > 0;
+        }
+
+        internal byte[] ReadStream(int index)
+        {
+            if (index < 0 || index >= _streamSizes.Length)
+                throw new ArgumentOutOfRangeException(nameof(index), $"Stream {index} does not exist");
+
+            int size = _streamSizes[index];
+            var result = new byte[size];
+            int[] blocks = _streamBlocks[index];
+            for (int i = 0, read = 0; read < size; i++)
+            {
+                int count = Math.Min(_blockSize, size - read);
+                ReadBlock(blocks[i], result, read, count);
+                read += count;
+            }
+            return result;
+        }
+
+        public void Dispose()
+        {
+            _view?.Dispose();
+            _file?.Dispose();
+        }
+
+        private byte[] ReadDirectory(int nrOfDirectoryBytes, int blockMapAddress)
+        {
+            int nrOfDirectoryBlocks = NrOfBlocks(nrOfDirectoryBytes);
+            var blockMap = new byte[nrOfDirectoryBlocks * sizeof(int)];
+            ReadBlock(blockMapAddress, blockMap, 0, blockMap.Length);
+
+            var directory = new byte[nrOfDirectoryBytes];
+            for (int i = 0, read = 0; read < nrOfDirectoryBytes; i++)
+            {
+                int count = Math.Min(_blockSize, nrOfDirectoryBytes - read);
+                ReadBlock(BitConverter.ToInt32(blockMap, i * sizeof(int)), directory, read, count);
+                read += count;
+            }
+            return directory;
+        }
+
+        private void ParseDirectory(byte[] directory, out int[] streamSizes, out int[][] streamBlocks)
+        {
+            int nrOfStreams = BitConverter.ToInt32(directory, 0);
+            streamSizes = new int[nrOfStreams];
+            streamBlocks = new int[nrOfStreams][];
+
+            int position = sizeof(int);
+            for (int i = 0; i < nrOfStreams; i++, position += sizeof(uint))
+            {
+                uint size = BitConverter.ToUInt32(directory, position);
+                streamSizes[i] = size == NilStreamSize ? 0 : (int)size;
+            }
+
+            for (int i = 0; i < nrOfStreams; i++)
+            {
+                var blocks = new int[NrOfBlocks(streamSizes[i])];
+                for (int j = 0; j < blocks.Length; j++, position += sizeof(int))
+                {
+                    blocks[j] = BitConverter.ToInt32(directory, position);
+                }
+                streamBlocks[i] = blocks;
+            }
+        }
+
+        private void ReadBlock(int block, byte[] buffer, int offset, int count)
+        {
+            long position = (long)block * _blockSize;
+            if (block < 0 || position + count > _fileSize)
+                throw new InvalidDataException($"MSF block {block} is out of range");
+
+            _view.ReadArray(position, buffer, offset, count);
+        }
+
+        private int NrOfBlocks(int nrOfBytes)
+        {
+            return (nrOfBytes + _blockSize - 1) / _blockSize;
+        }
+
+    }
+
+}
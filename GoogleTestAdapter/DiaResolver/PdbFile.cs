@@ -0,0 +1,349 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+
+namespace GoogleTestAdapter.DiaResolver
+{
+    internal class PdbFunction
+    {
+        internal string Name;
+        internal ushort Segment;
+        internal uint Offset;
+        internal uint Length;
+        internal PdbModule Module;
+
+        public override string ToString()
+        {
+            return Name;
+        }
+    }
+
+    internal class PdbLineBlock
+    {
+        internal ushort Segment;
+        internal uint Offset;
+        internal uint Length;
+        internal string SourceFile;
+        internal uint[] Offsets;
+        internal uint[] Lines;
+
+        internal bool Contains(ushort segment, uint offset)
+        {
+            return segment == Segment && offset >= Offset && offset - Offset < Length;
+        }
+    }
+
+    internal class PdbModule
+    {
+        internal string Name;
+        internal IList<PdbLineBlock> LineBlocks = new List<PdbLineBlock>();
+    }
+
+    /// <summary>
+    /// Minimal parser for the parts of a pdb file needed to resolve source locations: function symbols of all
+    /// modules, public function symbols, and the C13 line tables. Parsing happens once at construction time;
+    /// afterwards, the object is immutable and can be used from many threads concurrently.
+    /// </summary>
+    internal sealed class PdbFile
+    {
+        private const int PdbInfoStreamIndex = 1;
+        private const int DbiStreamIndex = 3;
+        private const int DbiHeaderSize = 64;
+        private const int ModInfoHeaderSize = 64;
+        private const ushort NilStreamIndex = 0xFFFF;
+        private const string NamesStreamName = "/names";
+        private const uint NamesStreamSignature = 0xEFFEEFFE;
+
+        private const ushort S_PUB32 = 0x110E;
+        private const ushort S_LPROC32 = 0x110F;
+        private const ushort S_GPROC32 = 0x1110;
+        private const ushort S_LPROC32_ID = 0x1146;
+        private const ushort S_GPROC32_ID = 0x1147;
+        private const uint CvPubSymFlagFunction = 0x2;
+
+        private const uint DEBUG_S_IGNORE = 0x80000000;
+        private const uint DEBUG_S_LINES = 0xF2;
+        private const uint DEBUG_S_FILECHKSMS = 0xF4;
+
+        private readonly byte[] _names;
+
+        internal IList<PdbModule> Modules { get; } = new List<PdbModule>();
+        internal IList<PdbFunction> Functions { get; } = new List<PdbFunction>();
+        internal IList<PdbFunction> PublicFunctions { get; } = new List<PdbFunction>();
+
+        internal PdbFile(MsfFile msf)
+        {
+            _names = ReadNamesStream(msf);
+
+            byte[] dbi = msf.ReadStream(DbiStreamIndex);
+            if (dbi.Length < DbiHeaderSize || BitConverter.ToInt32(dbi, 0) != -1)
+                throw new InvalidDataException("Unsupported format of DBI stream");
+
+            ushort symRecordStream = BitConverter.ToUInt16(dbi, 20);
+            int modInfoSize = BitConverter.ToInt32(dbi, 24);
+
+            ParseModules(msf, dbi, DbiHeaderSize, modInfoSize);
+            if (symRecordStream != NilStreamIndex && msf.HasStream(symRecordStream))
+                ParsePublicSymbols(msf.ReadStream(symRecordStream));
+        }
+
+        internal bool TryFindLine(PdbFunction function, out string sourceFile, out uint line)
+        {
+            IEnumerable<PdbLineBlock> candidates = function.Module != null
+                ? function.Module.LineBlocks
+                : Modules.SelectMany(m => m.LineBlocks);
+
+            foreach (PdbLineBlock block in candidates)
+            {
+                if (!block.Contains(function.Segment, function.Offset))
+                    continue;
+
+                // the line covering the function's start address, i.e., the last one starting at or before it
+                int index = -1;
+                for (int i = 0; i < block.Offsets.Length; i++)
+                {
+                    if (block.Offset + block.Offsets[i] > function.Offset)
+                        break;
+                    index = i;
+                }
+                if (index < 0 && block.Offsets.Length > 0 && block.Offset + block.Offsets[0] - function.Offset < function.Length)
+                    index = 0;
+                if (index < 0)
+                    continue;
+
+                sourceFile = block.SourceFile;
+                line = block.Lines[index];
+                return true;
+            }
+
+            sourceFile = null;
+            line = 0;
+            return false;
+        }
+
+        private static byte[] ReadNamesStream(MsfFile msf)
+        {
+            byte[] info = msf.ReadStream(PdbInfoStreamIndex);
+
+            // version, signature, age, guid
+            int position = 28;
+            int stringBufferSize = BitConverter.ToInt32(info, position);
+            position += sizeof(int);
+            int stringBufferStart = position;
+            position += stringBufferSize;
+
+            // hash table of named streams: size, capacity, present bit vector, deleted bit vector, entries
+            position += sizeof(int);
+            int capacity = BitConverter.ToInt32(info, position);
+            position += sizeof(int);
+            int presentWords = BitConverter.ToInt32(info, position);
+            position += sizeof(int);
+            var present = new uint[presentWords];
+            for (int i = 0; i < presentWords; i++, position += sizeof(uint))
+            {
+                present[i] = BitConverter.ToUInt32(info, position);
+            }
+            int deletedWords = BitConverter.ToInt32(info, position);
+            position += sizeof(int) + deletedWords * sizeof(uint);
+
+            for (int i = 0; i < capacity; i++)
+            {
+                if (i / 32 >= presentWords || (present[i / 32] & (1u << (i % 32))) == 0)
+                    continue;
+
+                int key = BitConverter.ToInt32(info, position);
+                int value = BitConverter.ToInt32(info, position + sizeof(int));
+                position += 2 * sizeof(int);
+
+                if (ReadString(info, stringBufferStart + key) == NamesStreamName && msf.HasStream(value))
+                {
+                    byte[] names = msf.ReadStream(value);
+                    if (BitConverter.ToUInt32(names, 0) != NamesStreamSignature)
+                        throw new InvalidDataException("Unsupported format of /names stream");
+                    return names;
+                }
+            }
+
+            return new byte[0];
+        }
+
+        private void ParseModules(MsfFile msf, byte[] dbi, int start, int size)
+        {
+            int position = start;
+            while (position + ModInfoHeaderSize <= start + size)
+            {
+                ushort moduleSymStream = BitConverter.ToUInt16(dbi, position + 34);
+                int symByteSize = BitConverter.ToInt32(dbi, position + 36);
+                int c11ByteSize = BitConverter.ToInt32(dbi, position + 40);
+                int c13ByteSize = BitConverter.ToInt32(dbi, position + 44);
+
+                int nameStart = position + ModInfoHeaderSize;
+                string moduleName = ReadString(dbi, nameStart);
+                int objectFileNameStart = EndOfString(dbi, nameStart) + 1;
+                position = Align4(EndOfString(dbi, objectFileNameStart) + 1);
+
+                var module = new PdbModule { Name = moduleName };
+                Modules.Add(module);
+
+                if (moduleSymStream == NilStreamIndex || !msf.HasStream(moduleSymStream))
+                    continue;
+
+                byte[] moduleStream = msf.ReadStream(moduleSymStream);
+                // skip CV signature
+                ParseModuleSymbols(module, moduleStream, sizeof(uint), symByteSize);
+                ParseLines(module, moduleStream, symByteSize + c11ByteSize, c13ByteSize);
+            }
+        }
+
+        private void ParseModuleSymbols(PdbModule module, byte[] stream, int start, int end)
+        {
+            end = Math.Min(end, stream.Length);
+            int position = start;
+            while (position + 4 <= end)
+            {
+                ushort recordLength = BitConverter.ToUInt16(stream, position);
+                ushort recordKind = BitConverter.ToUInt16(stream, position + 2);
+                int data = position + 4;
+                if (recordLength < 2)
+                    break;
+
+                switch (recordKind)
+                {
+                    case S_GPROC32:
+                    case S_LPROC32:
+                    case S_GPROC32_ID:
+                    case S_LPROC32_ID:
+                        Functions.Add(new PdbFunction
+                        {
+                            Length = BitConverter.ToUInt32(stream, data + 12),
+                            Offset = BitConverter.ToUInt32(stream, data + 28),
+                            Segment = BitConverter.ToUInt16(stream, data + 32),
+                            Name = ReadString(stream, data + 35),
+                            Module = module
+                        });
+                        break;
+                }
+
+                position += sizeof(ushort) + recordLength;
+            }
+        }
+
+        private void ParsePublicSymbols(byte[] stream)
+        {
+            int position = 0;
+            while (position + 4 <= stream.Length)
+            {
+                ushort recordLength = BitConverter.ToUInt16(stream, position);
+                ushort recordKind = BitConverter.ToUInt16(stream, position + 2);
+                int data = position + 4;
+                if (recordLength < 2)
+                    break;
+
+                if (recordKind == S_PUB32 && (BitConverter.ToUInt32(stream, data) & CvPubSymFlagFunction) != 0)
+                {
+                    PublicFunctions.Add(new PdbFunction
+                    {
+                        Offset = BitConverter.ToUInt32(stream, data + 4),
+                        Segment = BitConverter.ToUInt16(stream, data + 8),
+                        Name = ReadString(stream, data + 10)
+                    });
+                }
+
+                position += sizeof(ushort) + recordLength;
+            }
+        }
+
+        private void ParseLines(PdbModule module, byte[] stream, int start, int size)
+        {
+            int end = Math.Min(start + size, stream.Length);
+
+            // file checksums might come after the lines which reference them
+            var subsections = new List<Tuple<int, int>>();
+            int fileChecksums = -1;
+            for (int position = start; position + 8 <= end;)
+            {
+                uint kind = BitConverter.ToUInt32(stream, position);
+                int length = BitConverter.ToInt32(stream, position + 4);
+                int data = position + 8;
+                if ((kind & DEBUG_S_IGNORE) == 0)
+                {
+                    if (kind == DEBUG_S_FILECHKSMS)
+                        fileChecksums = data;
+                    else if (kind == DEBUG_S_LINES)
+                        subsections.Add(Tuple.Create(data, length));
+                }
+                position = Align4(data + length);
+            }
+
+            if (fileChecksums < 0)
+                return;
+
+            foreach (var subsection in subsections)
+            {
+                ParseLinesSubsection(module, stream, subsection.Item1, subsection.Item1 + subsection.Item2, fileChecksums);
+            }
+        }
+
+        private void ParseLinesSubsection(PdbModule module, byte[] stream, int start, int end, int fileChecksums)
+        {
+            uint offset = BitConverter.ToUInt32(stream, start);
+            ushort segment = BitConverter.ToUInt16(stream, start + 4);
+            uint codeSize = BitConverter.ToUInt32(stream, start + 8);
+
+            for (int position = start + 12; position + 12 <= end;)
+            {
+                int fileChecksumOffset = BitConverter.ToInt32(stream, position);
+                int nrOfLines = BitConverter.ToInt32(stream, position + 4);
+                int blockSize = BitConverter.ToInt32(stream, position + 8);
+                if (blockSize <= 0)
+                    break;
+
+                var block = new PdbLineBlock
+                {
+                    Segment = segment,
+                    Offset = offset,
+                    Length = codeSize,
+                    SourceFile = ReadName(BitConverter.ToInt32(stream, fileChecksums + fileChecksumOffset)),
+                    Offsets = new uint[nrOfLines],
+                    Lines = new uint[nrOfLines]
+                };
+                int line = position + 12;
+                for (int i = 0; i < nrOfLines; i++, line += 8)
+                {
+                    block.Offsets[i] = BitConverter.ToUInt32(stream, line);
+                    block.Lines[i] = BitConverter.ToUInt32(stream, line + 4) & 0x00FFFFFF;
+                }
+                module.LineBlocks.Add(block);
+
+                position += blockSize;
+            }
+        }
+
+        private string ReadName(int offset)
+        {
+            // signature, version, size of string buffer
+            const int namesHeaderSize = 12;
+            return _names.Length > namesHeaderSize + offset ? ReadString(_names, namesHeaderSize + offset) : "";
+        }
+
+        private static string ReadString(byte[] buffer, int start)
+        {
+            return Encoding.UTF8.GetString(buffer, start, EndOfString(buffer, start) - start);
+        }
+
+        private static int EndOfString(byte[] buffer, int start)
+        {
+            int end = Array.IndexOf(buffer, (byte)0, start);
+            return end < 0 ? buffer.Length : end;
+        }
+
+        private static int Align4(int position)
+        {
+            return (position + 3) & ~3;
+        }
+
+    }
+
+}
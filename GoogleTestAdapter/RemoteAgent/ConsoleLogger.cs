@@ -0,0 +1,26 @@
+﻿using System;
+using GoogleTestAdapter.Common;
+
+namespace GoogleTestAdapter.RemoteAgent
+{
+    public class ConsoleLogger : LoggerBase
+    {
+        public ConsoleLogger(OutputMode outputMode) : base(() => outputMode)
+        {
+        }
+
+        public override void Log(Severity severity, string message)
+        {
+            string line = $"{DateTime.Now:HH:mm:ss.fff} {severity.ToString().ToUpper()}: {message}";
+            lock (this)
+            {
+                if (severity == Severity.Info)
+                    Console.WriteLine(line);
+                else
+                    Console.Error.WriteLine(line);
+            }
+        }
+
+    }
+
+}
@@ -0,0 +1,66 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Net;
+using System.Threading;
+using GoogleTestAdapter.Common;
+using GoogleTestAdapter.ProcessExecution;
+
+namespace GoogleTestAdapter.RemoteAgent
+{
+    /// <summary>
+    /// Executes test processes on behalf of Google Test Adapter (see option 'Remote agents'). Several agents
+    /// can be run on the same machine by choosing different ports. By default, the agent only accepts
+    /// connections from the local machine; other addresses have to be chosen explicitly.
+    /// </summary>
+    class Program
+    {
+        private const string DebugOption = "-debug";
+        private const string AddressOption = "-address";
+
+        static int Main(string[] args)
+        {
+            var arguments = new List<string>();
+            IPAddress address = IPAddress.Loopback;
+            bool debug = false;
+            bool isValid = true;
+            for (int i = 0; i < args.Length; i++)
+            {
+                if (args[i] == DebugOption)
+                    debug = true;
+                else if (args[i] == AddressOption)
+                    isValid &= ++i < args.Length && IPAddress.TryParse(args[i], out address);
+                else
+                    arguments.Add(args[i]);
+            }
+
+            string secret = Environment.GetEnvironmentVariable(RemoteAgentProtocol.SecretEnvironmentVariable);
+            if (!isValid || arguments.Count != 2 || !int.TryParse(arguments[0], out int port) || port < 0 || port > 65535
+                || !Directory.Exists(arguments[1]) || string.IsNullOrEmpty(secret))
+            {
+                Console.Error.WriteLine($"Usage: GoogleTestAdapter.RemoteAgent.exe <port> <test directory> [{AddressOption} <ip address>] [{DebugOption}]");
+                Console.Error.WriteLine($"Only executables within the test directory are run. Environment variable {RemoteAgentProtocol.SecretEnvironmentVariable} must contain " +
+                    $"the secret shared with the adapter. The agent listens at {IPAddress.Loopback} unless another address (e.g. {IPAddress.Any}) is given.");
+                return 1;
+            }
+
+            var logger = new ConsoleLogger(debug ? OutputMode.Debug : OutputMode.Info);
+            var stopped = new ManualResetEvent(false);
+            Console.CancelKeyPress += (sender, e) =>
+            {
+                e.Cancel = true;
+                stopped.Set();
+            };
+
+            using (var server = new RemoteAgentServer(address, port, arguments[1], secret, logger))
+            {
+                server.Start();
+                logger.LogInfo("Press Ctrl+C to stop");
+                stopped.WaitOne();
+            }
+            return 0;
+        }
+
+    }
+
+}
@@ -123,6 +123,28 @@ namespace GoogleTestAdapter.TestAdapter.Helpers
             AssertAreEqual(testCases, filteredTestCases);
         }
 
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void IsIndependentOfTraits_FilterIsValidWithoutTraits_True()
+        {
+            TestCaseFilter filter = new TestCaseFilter(MockRunContext.Object, _traitNames, TestEnvironment.Logger);
+
+            filter.IsIndependentOfTraits().Should().BeTrue();
+        }
+
+        [TestMethod]
+        [TestCategory(Unit)]
+        public void IsIndependentOfTraits_FilterRefersToUnknownProperty_False()
+        {
+            MockRunContext.Setup(rc => rc.GetTestCaseFilter(
+                    It.IsAny<IEnumerable<string>>(), It.IsAny<Func<string, TestProperty>>()))
+                .Throws(new TestPlatformFormatException("MyTrait is not supported"));
+
+            TestCaseFilter filter = new TestCaseFilter(MockRunContext.Object, _traitNames, TestEnvironment.Logger);
+
+            filter.IsIndependentOfTraits().Should().BeFalse();
+        }
+
         [TestMethod]
         [TestCategory(Unit)]
         public void SetPropertyValue_Trait_CorrectValidation()
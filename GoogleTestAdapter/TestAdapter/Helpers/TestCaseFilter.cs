@@ -45,6 +45,23 @@ namespace GoogleTestAdapter.TestAdapter.Helpers
             return filterExpression == null || Matches(testCase, filterExpression);
         }
 
+        /// <summary>
+        /// True if the filter does not refer to any traits, i.e., if tests can be filtered without knowing the
+        /// trait names of all tests to be filtered.
+        /// </summary>
+        public bool IsIndependentOfTraits()
+        {
+            try
+            {
+                _runContext.GetTestCaseFilter(_testPropertiesMap.Keys, PropertyProvider);
+                return true;
+            }
+            catch (TestPlatformFormatException)
+            {
+                return false;
+            }
+        }
+
 
         private void InitProperties(ISet<string> traitNames)
         {
@@ -93,17 +93,23 @@ namespace GoogleTestAdapter.TestAdapter
             if (!AbleToRun(runContext))
                 return;
 
-            IList<TestCase> allTestCasesInExecutables = GetAllTestCasesInExecutables(executables).ToList();
+            // if the filter does not depend on the traits of all tests, each executable's tests can be filtered
+            // (and run) as soon as the executable has been discovered
+            var filterWithoutTraits = new TestCaseFilter(runContext, new HashSet<string>(), _logger);
+            if (filterWithoutTraits.IsIndependentOfTraits())
+            {
+                DoRunTests(executables, filterWithoutTraits, runContext, frameworkHandle);
+            }
+            else
+            {
+                IList<TestCase> allTestCasesInExecutables = GetAllTestCasesInExecutables(executables).ToList();
 
-            ISet<string> allTraitNames = GetAllTraitNames(allTestCasesInExecutables);
-            var filter = new TestCaseFilter(runContext, allTraitNames, _logger);
-            List<VsTestCase> vsTestCasesToRun =
-                filter.Filter(allTestCasesInExecutables.Select(tc => tc.ToVsTestCase())).ToList();
-            ICollection<TestCase> testCasesToRun =
-                allTestCasesInExecutables.Where(
-                    tc => vsTestCasesToRun.Any(vtc => tc.FullyQualifiedName == vtc.FullyQualifiedName)).ToArray();
+                ISet<string> allTraitNames = GetAllTraitNames(allTestCasesInExecutables);
+                var filter = new TestCaseFilter(runContext, allTraitNames, _logger);
+                ICollection<TestCase> testCasesToRun = Filter(allTestCasesInExecutables, filter);
 
-            DoRunTests(testCasesToRun, runContext, frameworkHandle);
+                DoRunTests(testCasesToRun, _settings.SynthesizeTestFilters ? allTestCasesInExecutables : null, runContext, frameworkHandle);
+            }
 
             stopwatch.Stop();
             _logger.LogInfo($"Google Test execution completed, overall duration: {stopwatch.Elapsed}.");
@@ -122,7 +128,10 @@ namespace GoogleTestAdapter.TestAdapter
             vsTestCasesToRun = filter.Filter(vsTestCasesToRunAsArray);
 
             ICollection<TestCase> testCasesToRun = vsTestCasesToRun.Select(tc => tc.ToTestCase()).ToArray();
-            DoRunTests(testCasesToRun, runContext, frameworkHandle);
+            IList<TestCase> allTestCasesInExecutables = _settings.SynthesizeTestFilters
+                ? GetAllTestCasesOfPartiallyRunExecutables(testCasesToRun)
+                : null;
+            DoRunTests(testCasesToRun, allTestCasesInExecutables, runContext, frameworkHandle);
 
             stopwatch.Stop();
             _logger.LogInfo($"Google Test execution completed, overall duration: {stopwatch.Elapsed}.");
@@ -182,6 +191,24 @@ namespace GoogleTestAdapter.TestAdapter
             return allTestCasesInExecutables;
         }
 
+        /// <summary>
+        /// Executables of which all tests are run do not need a filter, so they are not discovered
+        /// </summary>
+        private IList<TestCase> GetAllTestCasesOfPartiallyRunExecutables(ICollection<TestCase> testCasesToRun)
+        {
+            IEnumerable<string> partiallyRunExecutables = testCasesToRun
+                .Where(tc => !tc.IsExitCodeTestCase)
+                .GroupBy(tc => tc.Source)
+                .Where(group =>
+                {
+                    TestCaseMetaDataProperty metaData = group.First().Properties.OfType<TestCaseMetaDataProperty>().SingleOrDefault();
+                    return metaData != null && group.Count() < metaData.NrOfTestCasesInExecutable;
+                })
+                .Select(group => group.Key);
+
+            return GetAllTestCasesInExecutables(partiallyRunExecutables).ToList();
+        }
+
         private static IList<TestCase> GetTestCasesOfExecutable(string executable, SettingsWrapper settings, ILogger logger, Func<bool> testrunIsCanceled)
         {
             IList<TestCase> testCases = new List<TestCase>();
@@ -198,6 +225,17 @@ namespace GoogleTestAdapter.TestAdapter
             return testCases;
         }
 
+        private static IList<TestCase> Filter(IList<TestCase> testCases, TestCaseFilter filter)
+        {
+            List<VsTestCase> vsTestCasesToRun;
+            lock (filter)
+            {
+                vsTestCasesToRun = filter.Filter(testCases.Select(tc => tc.ToVsTestCase())).ToList();
+            }
+            return testCases.Where(
+                tc => vsTestCasesToRun.Any(vtc => tc.FullyQualifiedName == vtc.FullyQualifiedName)).ToArray();
+        }
+
         private ISet<string> GetAllTraitNames(IEnumerable<TestCase> testCases)
         {
             var allTraitNames = new HashSet<string>();
@@ -216,15 +254,36 @@ namespace GoogleTestAdapter.TestAdapter
             return _settings.DebuggingNamedPipeId != null;
         }
 
-        private void DoRunTests(ICollection<TestCase> testCasesToRun, IRunContext runContext, IFrameworkHandle frameworkHandle)
+        private void DoRunTests(ICollection<TestCase> testCasesToRun, IEnumerable<TestCase> allTestCasesInExecutables, IRunContext runContext, IFrameworkHandle frameworkHandle)
         {
             if (testCasesToRun.Count == 0)
             {
                 return;
             }
 
+            if (!CreateExecutor(runContext, frameworkHandle, out VsTestFrameworkReporter reporter))
+                return;
+
+            _executor.RunTests(testCasesToRun, allTestCasesInExecutables, reporter, runContext.IsBeingDebugged);
+            reporter.AllTestsFinished();
+        }
+
+        private void DoRunTests(IEnumerable<string> executables, TestCaseFilter filter, IRunContext runContext, IFrameworkHandle frameworkHandle)
+        {
+            if (!CreateExecutor(runContext, frameworkHandle, out VsTestFrameworkReporter reporter))
+                return;
+
+            _executor.RunTests(executables,
+                executable => GetTestCasesOfExecutable(executable, _settings.Clone(), _logger, () => _canceled),
+                testCases => Filter(testCases, filter),
+                reporter, runContext.IsBeingDebugged);
+            reporter.AllTestsFinished();
+        }
+
+        private bool CreateExecutor(IRunContext runContext, IFrameworkHandle frameworkHandle, out VsTestFrameworkReporter reporter)
+        {
             bool isRunningInsideVisualStudio = !string.IsNullOrEmpty(runContext.SolutionDirectory);
-            var reporter = new VsTestFrameworkReporter(frameworkHandle, isRunningInsideVisualStudio, _logger);
+            reporter = new VsTestFrameworkReporter(frameworkHandle, isRunningInsideVisualStudio, _logger);
 
             var debuggerAttacher = _debuggerAttacher ?? new MessageBasedDebuggerAttacher(_settings.DebuggingNamedPipeId, _logger);
             var processExecutorFactory = new DebuggedProcessExecutorFactory(frameworkHandle, debuggerAttacher);
@@ -234,12 +293,11 @@ namespace GoogleTestAdapter.TestAdapter
             lock (_lock)
             {
                 if (_canceled)
-                    return;
+                    return false;
 
                 _executor = new GoogleTestExecutor(_logger, _settings, processExecutorFactory, exitCodeTestsReporter);
+                return true;
             }
-            _executor.RunTests(testCasesToRun, reporter, runContext.IsBeingDebugged);
-            reporter.AllTestsFinished();
         }
 
     }
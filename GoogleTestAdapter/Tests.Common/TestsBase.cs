@@ -104,6 +104,25 @@ namespace GoogleTestAdapter.Tests.Common
             mockOptions.Setup(o => o.ExitCodeTestCase).Returns(SettingsWrapper.OptionExitCodeTestCaseDefaultValue);
             mockOptions.Setup(o => o.MissingTestsReportMode)
                 .Returns(SettingsWrapper.OptionMissingTestsReportModeDefaultValue);
+            mockOptions.Setup(o => o.WorkStealingTestExecution).Returns(SettingsWrapper.OptionWorkStealingTestExecutionDefaultValue);
+            mockOptions.Setup(o => o.NativeShardingThreshold).Returns(SettingsWrapper.OptionNativeShardingThresholdDefaultValue);
+            mockOptions.Setup(o => o.SynthesizeTestFilters).Returns(SettingsWrapper.OptionSynthesizeTestFiltersDefaultValue);
+            mockOptions.Setup(o => o.UseTestServer).Returns(SettingsWrapper.OptionUseTestServerDefaultValue);
+            mockOptions.Setup(o => o.CrashBudget).Returns(SettingsWrapper.OptionCrashBudgetDefaultValue);
+            mockOptions.Setup(o => o.AdaptiveConcurrency).Returns(SettingsWrapper.OptionAdaptiveConcurrencyDefaultValue);
+            mockOptions.Setup(o => o.TestTimeoutInSeconds).Returns(SettingsWrapper.OptionTestTimeoutInSecondsDefaultValue);
+            mockOptions.Setup(o => o.ProcessTimeoutInSeconds).Returns(SettingsWrapper.OptionProcessTimeoutInSecondsDefaultValue);
+            mockOptions.Setup(o => o.FailFast).Returns(SettingsWrapper.OptionFailFastDefaultValue);
+            mockOptions.Setup(o => o.PrioritizeFailedAndLongTests).Returns(SettingsWrapper.OptionPrioritizeFailedAndLongTestsDefaultValue);
+            mockOptions.Setup(o => o.ExecutableAffinitySplitting).Returns(SettingsWrapper.OptionExecutableAffinitySplittingDefaultValue);
+            mockOptions.Setup(o => o.RemoteAgents).Returns(SettingsWrapper.OptionRemoteAgentsDefaultValue);
+            mockOptions.Setup(o => o.RemoteOutputDirectory).Returns(SettingsWrapper.OptionRemoteOutputDirectoryDefaultValue);
+            mockOptions.Setup(o => o.ResultCacheDirectory).Returns(SettingsWrapper.OptionResultCacheDirectoryDefaultValue);
+            mockOptions.Setup(o => o.ChangedFilesList).Returns(SettingsWrapper.OptionChangedFilesListDefaultValue);
+            mockOptions.Setup(o => o.AsyncResultReporting).Returns(SettingsWrapper.OptionAsyncResultReportingDefaultValue);
+            mockOptions.Setup(o => o.PreSpawnTestProcesses).Returns(SettingsWrapper.OptionPreSpawnTestProcessesDefaultValue);
+            mockOptions.Setup(o => o.PinTestThreadsToCpus).Returns(SettingsWrapper.OptionPinTestThreadsToCpusDefaultValue);
+            mockOptions.Setup(o => o.MemoryBudgetInMb).Returns(SettingsWrapper.OptionMemoryBudgetInMbDefaultValue);
 
             mockOptions.Setup(o => o.DebuggerKind).Returns(DebuggerKind.Native);
 
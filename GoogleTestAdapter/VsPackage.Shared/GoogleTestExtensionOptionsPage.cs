@@ -280,6 +280,25 @@ namespace GoogleTestAdapter.VsPackage
                 MaxNrOfThreads = _testExecutionOptions.MaxNrOfThreads,
                 DebuggerKind = _testExecutionOptions.DebuggerKind,
                 MissingTestsReportMode = _testExecutionOptions.MissingTestsReportMode,
+                WorkStealingTestExecution = _testExecutionOptions.EnableWorkStealing,
+                NativeShardingThreshold = _testExecutionOptions.NativeShardingThreshold,
+                SynthesizeTestFilters = _testExecutionOptions.SynthesizeTestFilters,
+                UseTestServer = _testExecutionOptions.UseTestServer,
+                CrashBudget = _testExecutionOptions.CrashBudget,
+                AdaptiveConcurrency = _testExecutionOptions.AdaptiveConcurrency,
+                TestTimeoutInSeconds = _testExecutionOptions.TestTimeoutInSeconds,
+                ProcessTimeoutInSeconds = _testExecutionOptions.ProcessTimeoutInSeconds,
+                FailFast = _testExecutionOptions.FailFast,
+                PrioritizeFailedAndLongTests = _testExecutionOptions.PrioritizeFailedAndLongTests,
+                ExecutableAffinitySplitting = _testExecutionOptions.ExecutableAffinitySplitting,
+                RemoteAgents = _testExecutionOptions.RemoteAgents,
+                RemoteOutputDirectory = _testExecutionOptions.RemoteOutputDirectory,
+                ResultCacheDirectory = _testExecutionOptions.ResultCacheDirectory,
+                ChangedFilesList = _testExecutionOptions.ChangedFilesList,
+                AsyncResultReporting = _testExecutionOptions.AsyncResultReporting,
+                PreSpawnTestProcesses = _testExecutionOptions.PreSpawnTestProcesses,
+                PinTestThreadsToCpus = _testExecutionOptions.PinTestThreadsToCpus,
+                MemoryBudgetInMb = _testExecutionOptions.MemoryBudgetInMb,
 
                 DebuggingNamedPipeId = _debuggingNamedPipeId,
                 SolutionDir = solutionDir,
@@ -44,6 +44,130 @@ namespace GoogleTestAdapter.VsPackage.OptionsPages
         }
         private int _maxNrOfThreads = SettingsWrapper.OptionMaxNrOfThreadsDefaultValue;
 
+        [Category(SettingsWrapper.CategoryParallelizationName)]
+        [DisplayName(SettingsWrapper.OptionWorkStealingTestExecution)]
+        [Description(SettingsWrapper.OptionWorkStealingTestExecutionDescription)]
+        public bool EnableWorkStealing
+        {
+            get => _enableWorkStealing;
+            set => SetAndNotify(ref _enableWorkStealing, value);
+        }
+        private bool _enableWorkStealing = SettingsWrapper.OptionWorkStealingTestExecutionDefaultValue;
+
+        [Category(SettingsWrapper.CategoryParallelizationName)]
+        [DisplayName(SettingsWrapper.OptionNativeShardingThreshold)]
+        [Description(SettingsWrapper.OptionNativeShardingThresholdDescription)]
+        public int NativeShardingThreshold
+        {
+            get => _nativeShardingThreshold;
+            set
+            {
+                if (value < 0 || value > 100)
+                    throw new ArgumentOutOfRangeException(nameof(NativeShardingThreshold), value, "Expected a number between 0 and 100.");
+                SetAndNotify(ref _nativeShardingThreshold, value);
+            }
+        }
+        private int _nativeShardingThreshold = SettingsWrapper.OptionNativeShardingThresholdDefaultValue;
+
+        [Category(SettingsWrapper.CategoryParallelizationName)]
+        [DisplayName(SettingsWrapper.OptionAdaptiveConcurrency)]
+        [Description(SettingsWrapper.OptionAdaptiveConcurrencyDescription)]
+        public bool AdaptiveConcurrency
+        {
+            get => _adaptiveConcurrency;
+            set => SetAndNotify(ref _adaptiveConcurrency, value);
+        }
+        private bool _adaptiveConcurrency = SettingsWrapper.OptionAdaptiveConcurrencyDefaultValue;
+
+        [Category(SettingsWrapper.CategoryParallelizationName)]
+        [DisplayName(SettingsWrapper.OptionPrioritizeFailedAndLongTests)]
+        [Description(SettingsWrapper.OptionPrioritizeFailedAndLongTestsDescription)]
+        public bool PrioritizeFailedAndLongTests
+        {
+            get => _prioritizeFailedAndLongTests;
+            set => SetAndNotify(ref _prioritizeFailedAndLongTests, value);
+        }
+        private bool _prioritizeFailedAndLongTests = SettingsWrapper.OptionPrioritizeFailedAndLongTestsDefaultValue;
+
+        [Category(SettingsWrapper.CategoryParallelizationName)]
+        [DisplayName(SettingsWrapper.OptionExecutableAffinitySplitting)]
+        [Description(SettingsWrapper.OptionExecutableAffinitySplittingDescription)]
+        public bool ExecutableAffinitySplitting
+        {
+            get => _executableAffinitySplitting;
+            set => SetAndNotify(ref _executableAffinitySplitting, value);
+        }
+        private bool _executableAffinitySplitting = SettingsWrapper.OptionExecutableAffinitySplittingDefaultValue;
+
+        [Category(SettingsWrapper.CategoryParallelizationName)]
+        [DisplayName(SettingsWrapper.OptionRemoteAgents)]
+        [Description(SettingsWrapper.OptionRemoteAgentsDescription)]
+        public string RemoteAgents
+        {
+            get => _remoteAgents;
+            set
+            {
+                RemoteAgentProtocol.ParseEndpoints(value ?? "");
+                SetAndNotify(ref _remoteAgents, value);
+            }
+        }
+        private string _remoteAgents = SettingsWrapper.OptionRemoteAgentsDefaultValue;
+
+        [Category(SettingsWrapper.CategoryParallelizationName)]
+        [DisplayName(SettingsWrapper.OptionRemoteOutputDirectory)]
+        [Description(SettingsWrapper.OptionRemoteOutputDirectoryDescription)]
+        public string RemoteOutputDirectory
+        {
+            get => _remoteOutputDirectory;
+            set => SetAndNotify(ref _remoteOutputDirectory, value);
+        }
+        private string _remoteOutputDirectory = SettingsWrapper.OptionRemoteOutputDirectoryDefaultValue;
+
+        [Category(SettingsWrapper.CategoryParallelizationName)]
+        [DisplayName(SettingsWrapper.OptionAsyncResultReporting)]
+        [Description(SettingsWrapper.OptionAsyncResultReportingDescription)]
+        public bool AsyncResultReporting
+        {
+            get => _asyncResultReporting;
+            set => SetAndNotify(ref _asyncResultReporting, value);
+        }
+        private bool _asyncResultReporting = SettingsWrapper.OptionAsyncResultReportingDefaultValue;
+
+        [Category(SettingsWrapper.CategoryParallelizationName)]
+        [DisplayName(SettingsWrapper.OptionPreSpawnTestProcesses)]
+        [Description(SettingsWrapper.OptionPreSpawnTestProcessesDescription)]
+        public bool PreSpawnTestProcesses
+        {
+            get => _preSpawnTestProcesses;
+            set => SetAndNotify(ref _preSpawnTestProcesses, value);
+        }
+        private bool _preSpawnTestProcesses = SettingsWrapper.OptionPreSpawnTestProcessesDefaultValue;
+
+        [Category(SettingsWrapper.CategoryParallelizationName)]
+        [DisplayName(SettingsWrapper.OptionPinTestThreadsToCpus)]
+        [Description(SettingsWrapper.OptionPinTestThreadsToCpusDescription)]
+        public bool PinTestThreadsToCpus
+        {
+            get => _pinTestThreadsToCpus;
+            set => SetAndNotify(ref _pinTestThreadsToCpus, value);
+        }
+        private bool _pinTestThreadsToCpus = SettingsWrapper.OptionPinTestThreadsToCpusDefaultValue;
+
+        [Category(SettingsWrapper.CategoryParallelizationName)]
+        [DisplayName(SettingsWrapper.OptionMemoryBudgetInMb)]
+        [Description(SettingsWrapper.OptionMemoryBudgetInMbDescription)]
+        public int MemoryBudgetInMb
+        {
+            get => _memoryBudgetInMb;
+            set
+            {
+                if (value < 0)
+                    throw new ArgumentOutOfRangeException(nameof(MemoryBudgetInMb), value, "Expected a number greater than or equal to 0.");
+                SetAndNotify(ref _memoryBudgetInMb, value);
+            }
+        }
+        private int _memoryBudgetInMb = SettingsWrapper.OptionMemoryBudgetInMbDefaultValue;
+
         #endregion
 
         #region Run configuration
@@ -189,6 +313,101 @@ namespace GoogleTestAdapter.VsPackage.OptionsPages
         }
         private MissingTestsReportMode _missingTestsReportMode = SettingsWrapper.OptionMissingTestsReportModeDefaultValue;
 
+        [Category(SettingsWrapper.CategoryMiscName)]
+        [DisplayName(SettingsWrapper.OptionSynthesizeTestFilters)]
+        [Description(SettingsWrapper.OptionSynthesizeTestFiltersDescription)]
+        public bool SynthesizeTestFilters
+        {
+            get => _synthesizeTestFilters;
+            set => SetAndNotify(ref _synthesizeTestFilters, value);
+        }
+        private bool _synthesizeTestFilters = SettingsWrapper.OptionSynthesizeTestFiltersDefaultValue;
+
+        [Category(SettingsWrapper.CategoryMiscName)]
+        [DisplayName(SettingsWrapper.OptionUseTestServer)]
+        [Description(SettingsWrapper.OptionUseTestServerDescription)]
+        public bool UseTestServer
+        {
+            get => _useTestServer;
+            set => SetAndNotify(ref _useTestServer, value);
+        }
+        private bool _useTestServer = SettingsWrapper.OptionUseTestServerDefaultValue;
+
+        [Category(SettingsWrapper.CategoryMiscName)]
+        [DisplayName(SettingsWrapper.OptionCrashBudget)]
+        [Description(SettingsWrapper.OptionCrashBudgetDescription)]
+        public int CrashBudget
+        {
+            get => _crashBudget;
+            set
+            {
+                if (value < 0)
+                    throw new ArgumentOutOfRangeException(nameof(CrashBudget), value, "Expected a number greater than or equal to 0.");
+                SetAndNotify(ref _crashBudget, value);
+            }
+        }
+        private int _crashBudget = SettingsWrapper.OptionCrashBudgetDefaultValue;
+
+        [Category(SettingsWrapper.CategoryMiscName)]
+        [DisplayName(SettingsWrapper.OptionTestTimeoutInSeconds)]
+        [Description(SettingsWrapper.OptionTestTimeoutInSecondsDescription)]
+        public int TestTimeoutInSeconds
+        {
+            get => _testTimeoutInSeconds;
+            set
+            {
+                if (value < 0)
+                    throw new ArgumentOutOfRangeException(nameof(TestTimeoutInSeconds), value, "Expected a number greater than or equal to 0.");
+                SetAndNotify(ref _testTimeoutInSeconds, value);
+            }
+        }
+        private int _testTimeoutInSeconds = SettingsWrapper.OptionTestTimeoutInSecondsDefaultValue;
+
+        [Category(SettingsWrapper.CategoryMiscName)]
+        [DisplayName(SettingsWrapper.OptionProcessTimeoutInSeconds)]
+        [Description(SettingsWrapper.OptionProcessTimeoutInSecondsDescription)]
+        public int ProcessTimeoutInSeconds
+        {
+            get => _processTimeoutInSeconds;
+            set
+            {
+                if (value < 0)
+                    throw new ArgumentOutOfRangeException(nameof(ProcessTimeoutInSeconds), value, "Expected a number greater than or equal to 0.");
+                SetAndNotify(ref _processTimeoutInSeconds, value);
+            }
+        }
+        private int _processTimeoutInSeconds = SettingsWrapper.OptionProcessTimeoutInSecondsDefaultValue;
+
+        [Category(SettingsWrapper.CategoryMiscName)]
+        [DisplayName(SettingsWrapper.OptionFailFast)]
+        [Description(SettingsWrapper.OptionFailFastDescription)]
+        public bool FailFast
+        {
+            get => _failFast;
+            set => SetAndNotify(ref _failFast, value);
+        }
+        private bool _failFast = SettingsWrapper.OptionFailFastDefaultValue;
+
+        [Category(SettingsWrapper.CategoryMiscName)]
+        [DisplayName(SettingsWrapper.OptionResultCacheDirectory)]
+        [Description(SettingsWrapper.OptionResultCacheDirectoryDescription)]
+        public string ResultCacheDirectory
+        {
+            get => _resultCacheDirectory;
+            set => SetAndNotify(ref _resultCacheDirectory, value);
+        }
+        private string _resultCacheDirectory = SettingsWrapper.OptionResultCacheDirectoryDefaultValue;
+
+        [Category(SettingsWrapper.CategoryMiscName)]
+        [DisplayName(SettingsWrapper.OptionChangedFilesList)]
+        [Description(SettingsWrapper.OptionChangedFilesListDescription)]
+        public string ChangedFilesList
+        {
+            get => _changedFilesList;
+            set => SetAndNotify(ref _changedFilesList, value);
+        }
+        private string _changedFilesList = SettingsWrapper.OptionChangedFilesListDefaultValue;
+
         #endregion
 
     }